@@ -0,0 +1,148 @@
+/******************************************************************************
+* File Name: altitude.c
+*
+* Description: Fixed-point altitude and vertical speed estimator for the Q8
+*              pressure output of DPS310_calcPressureBatchFixed() and
+*              DPS310_getContResultsFixed().
+*
+*******************************************************************************/
+
+#include "altitude.h"
+
+#define ALT__ROUND_SHIFT(value, bits) (((value) + ((int64_t)1 << ((bits) - 1))) >> (bits))
+
+//table index bits of a Q8 pressure, the rest interpolates
+#define ALT__INDEX_SHIFT (ALT__TABLE_STEP_BITS + 8)
+
+// altitude in mm at ALT__TABLE_FIRST_PRS + i * 256 Pa, 44330.77 m * (1 - (p / 101325 Pa)^0.190263)
+static const int32_t ALT_table[ALT__TABLE_SIZE] = {
+    9163947, 9107047, 9050536, 8994407, 8938655, 8883275, 8828260, 8773606,
+    8719307, 8665358, 8611754, 8558490, 8505562, 8452964, 8400693, 8348743,
+    8297111, 8245791, 8194780, 8144074, 8093669, 8043560, 7993743, 7944216,
+    7894974, 7846014, 7797332, 7748924, 7700787, 7652918, 7605314, 7557970,
+    7510885, 7464054, 7417476, 7371146, 7325062, 7279221, 7233620, 7188256,
+    7143127, 7098230, 7053562, 7009120, 6964903, 6920907, 6877131, 6833571,
+    6790225, 6747092, 6704168, 6661451, 6618940, 6576632, 6534524, 6492615,
+    6450903, 6409385, 6368060, 6326925, 6285979, 6245220, 6204646, 6164254,
+    6124044, 6084013, 6044159, 6004481, 5964977, 5925646, 5886485, 5847494,
+    5808669, 5770011, 5731517, 5693185, 5655015, 5617004, 5579152, 5541456,
+    5503915, 5466529, 5429294, 5392211, 5355278, 5318492, 5281854, 5245362,
+    5209014, 5172809, 5136746, 5100824, 5065041, 5029396, 4993889, 4958517,
+    4923280, 4888177, 4853206, 4818367, 4783657, 4749077, 4714625, 4680300,
+    4646101, 4612027, 4578077, 4544250, 4510545, 4476961, 4443497, 4410152,
+    4376925, 4343815, 4310822, 4277943, 4245180, 4212530, 4179992, 4147567,
+    4115252, 4083048, 4050952, 4018966, 3987087, 3955314, 3923648, 3892087,
+    3860631, 3829278, 3798029, 3766881, 3735835, 3704890, 3674044, 3643298,
+    3612651, 3582101, 3551649, 3521293, 3491032, 3460867, 3430797, 3400820,
+    3370936, 3341145, 3311445, 3281837, 3252320, 3222892, 3193554, 3164305,
+    3135144, 3106070, 3077084, 3048184, 3019369, 2990640, 2961996, 2933436,
+    2904959, 2876566, 2848255, 2820026, 2791878, 2763812, 2735826, 2707920,
+    2680093, 2652345, 2624675, 2597084, 2569570, 2542132, 2514772, 2487487,
+    2460277, 2433143, 2406083, 2379098, 2352186, 2325347, 2298581, 2271888,
+    2245266, 2218716, 2192237, 2165829, 2139490, 2113222, 2087023, 2060893,
+    2034831, 2008838, 1982912, 1957054, 1931263, 1905538, 1879879, 1854287,
+    1828760, 1803297, 1777900, 1752567, 1727298, 1702093, 1676950, 1651871,
+    1626855, 1601900, 1577007, 1552176, 1527407, 1502698, 1478049, 1453461,
+    1428932, 1404463, 1380054, 1355703, 1331411, 1307177, 1283001, 1258882,
+    1234821, 1210818, 1186870, 1162979, 1139145, 1115366, 1091643, 1067975,
+    1044362, 1020803, 997300, 973850, 950454, 927112, 903822, 880586,
+    857403, 834272, 811194, 788167, 765193, 742269, 719397, 696576,
+    673805, 651085, 628415, 605795, 583225, 560704, 538232, 515809,
+    493436, 471110, 448833, 426604, 404422, 382288, 360202, 338163,
+    316170, 294224, 272325, 250472, 228665, 206903, 185188, 163517,
+    141892, 120312, 98776, 77285, 55838, 34436, 13077, -8238,
+    -29509, -50737, -71922, -93064, -114163, -135220, -156235, -177207,
+    -198137, -219026, -239872, -260678, -281442, -302165, -322848, -343489,
+    -364090, -384651, -405172, -425652, -446093, -466495, -486856, -507179,
+    -527462, -547706, -567912, -588079, -608207, -628298, -648350, -668364,
+    -688340, -708279,
+};
+
+int32_t ALT_pressureToAltitude(int32_t pressure)
+{
+    int32_t offset = pressure - (ALT__TABLE_FIRST_PRS << 8);
+
+    //clamp to the table, the sensor range is 30 kPa to 110 kPa
+    if (offset <= 0)
+    {
+        return ALT_table[0];
+    }
+    uint32_t index = (uint32_t)offset >> ALT__INDEX_SHIFT;
+    if (index >= ALT__TABLE_SIZE - 1U)
+    {
+        return ALT_table[ALT__TABLE_SIZE - 1U];
+    }
+
+    //linear interpolation, below 0.1 m off the formula over the whole table
+    int32_t frac = offset & ((1L << ALT__INDEX_SHIFT) - 1);
+    int32_t step = ALT_table[index + 1U] - ALT_table[index];
+    return ALT_table[index] + (int32_t)ALT__ROUND_SHIFT((int64_t)step * frac, ALT__INDEX_SHIFT);
+}
+
+void ALT_init(ALT_estimator_t *est, uint16_t sampleRate, uint16_t alpha, uint16_t beta)
+{
+    est->alpha = alpha;
+    est->betaRate = (int32_t)beta * sampleRate;
+    est->period = (int32_t)(((1UL << ALT__GAIN_FRAC_BITS) + sampleRate / 2U) / sampleRate);
+    est->reference = 0;
+    ALT_reset(est);
+}
+
+void ALT_reset(ALT_estimator_t *est)
+{
+    //the next sample starts the filter over, at rest
+    est->altitude = 0;
+    est->velocity = 0;
+    est->valid = 0U;
+}
+
+void ALT_setReference(ALT_estimator_t *est, int32_t pressure)
+{
+    int32_t reference = ALT_pressureToAltitude(pressure);
+
+    //move the filtered altitude along, the speed stays valid
+    est->altitude -= (int64_t)(reference - est->reference) << ALT__FRAC_BITS;
+    est->reference = reference;
+}
+
+void ALT_update(ALT_estimator_t *est, const int32_t *pressure, uint8_t count)
+{
+    int64_t altitude = est->altitude;
+    int32_t velocity = est->velocity;
+    uint8_t i = 0;
+
+    if ((count > 0U) && !est->valid)
+    {
+        altitude = (int64_t)(ALT_pressureToAltitude(pressure[0]) - est->reference) << ALT__FRAC_BITS;
+        velocity = 0;
+        est->valid = 1U;
+        i = 1U;
+    }
+
+    //samples of a batch are one sample period apart, the FIFO must not have overflowed
+    for (; i < count; i++)
+    {
+        int64_t measured = (int64_t)(ALT_pressureToAltitude(pressure[i]) - est->reference) << ALT__FRAC_BITS;
+
+        //predict, then correct with the residual
+        altitude += ALT__ROUND_SHIFT((int64_t)velocity * est->period, ALT__GAIN_FRAC_BITS);
+        int64_t residual = measured - altitude;
+        altitude += ALT__ROUND_SHIFT(residual * est->alpha, ALT__GAIN_FRAC_BITS);
+        velocity += (int32_t)ALT__ROUND_SHIFT(residual * est->betaRate, ALT__GAIN_FRAC_BITS);
+    }
+
+    est->altitude = altitude;
+    est->velocity = velocity;
+}
+
+int32_t ALT_getAltitude(const ALT_estimator_t *est)
+{
+    //mm above the reference pressure
+    return (int32_t)ALT__ROUND_SHIFT(est->altitude, ALT__FRAC_BITS);
+}
+
+int32_t ALT_getVerticalSpeed(const ALT_estimator_t *est)
+{
+    //mm/s, positive upwards
+    return (int32_t)ALT__ROUND_SHIFT((int64_t)est->velocity, ALT__FRAC_BITS);
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+* File Name: altitude.h
+*
+* Description: Fixed-point altitude and vertical speed estimator for the Q8
+*              pressure output of DPS310_calcPressureBatchFixed() and
+*              DPS310_getContResultsFixed().
+*
+*******************************************************************************/
+
+#ifndef ALTITUDE_H_
+#define ALTITUDE_H_
+
+#include <stdint.h>
+
+//filter state fraction bits, altitude in 1/4096 mm and speed in 1/4096 mm/s
+#define ALT__FRAC_BITS 12
+#define ALT__GAIN_FRAC_BITS 16
+
+//pressure to altitude table, standard atmosphere, 256 Pa steps from 30 kPa to 110.128 kPa
+#define ALT__TABLE_FIRST_PRS 30000L
+#define ALT__TABLE_STEP_BITS 8
+#define ALT__TABLE_SIZE 314U
+
+//filter gain in Q16, e.g. ALT_GAIN(0.05f)
+#define ALT_GAIN(x) ((uint16_t)((x) * (1UL << ALT__GAIN_FRAC_BITS) + 0.5f))
+
+//critically damped gains for 128 Hz and about 1 Pa of pressure noise, beta = alpha^2 / (2 - alpha)
+#define ALT_DEFAULT_ALPHA ALT_GAIN(0.05f)
+#define ALT_DEFAULT_BETA ALT_GAIN(0.00128f)
+
+// alpha-beta filter over altitude and vertical speed, one instance per sensor
+typedef struct
+{
+    int32_t alpha;          //altitude gain, Q16
+    int32_t betaRate;       //speed gain divided by the sample period, Q16 per second
+    int32_t period;         //sample period, Q16 seconds
+    int32_t reference;      //altitude of the reference pressure in mm
+    int64_t altitude;       //filtered altitude above the reference
+    int32_t velocity;       //filtered vertical speed, positive upwards
+    uint8_t valid;          //0 until the first sample
+} ALT_estimator_t;
+
+int32_t ALT_pressureToAltitude(int32_t pressure);
+
+void ALT_init(ALT_estimator_t *est, uint16_t sampleRate, uint16_t alpha, uint16_t beta);
+void ALT_reset(ALT_estimator_t *est);
+void ALT_setReference(ALT_estimator_t *est, int32_t pressure);
+void ALT_update(ALT_estimator_t *est, const int32_t *pressure, uint8_t count);
+
+int32_t ALT_getAltitude(const ALT_estimator_t *est);
+int32_t ALT_getVerticalSpeed(const ALT_estimator_t *est);
+
+#endif /* ALTITUDE_H_ */
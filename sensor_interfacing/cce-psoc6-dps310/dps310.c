@@ -7,114 +7,386 @@
 *
 *******************************************************************************/
 
+#include <string.h>
+
 #include "dps310.h"
 
 const int32_t DPS310_scaling_facts[DPS__NUM_OF_SCAL_FACTS] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
 
-void DPS310_init(cyhal_i2c_t* i2c_inst)
+// 2^48 / scaling factor, turns the division of the fixed-point path into a multiplication
+const int32_t DPS310_scaling_recips[DPS__NUM_OF_SCAL_FACTS] = {536870912, 178956971, 76695845, 35791394, 1108378657, 545392673, 270549121, 134744072};
+
+// pressure polynomial with the temperature terms folded in, Q12 Pa
+typedef struct
 {
-    i2c_ptr = i2c_inst;
+    int64_t a0;
+    int64_t a1;
+    int64_t a2;
+    int64_t a3;
+} DPS310_prsTerms_t;
+
+static int16_t DPS310_setTempConfig(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr);
+static int16_t DPS310_setPressureConfig(DPS310_t *dev, uint8_t prsMr, uint8_t prsOsr);
+static int16_t DPS310_writeTempFix(DPS310_t *dev);
+static int16_t DPS310_finishAsync(DPS310_t *dev, enum Mode mode, int16_t rdy, float* result);
+
+static void DPS310_initState(DPS310_t *dev, cyhal_i2c_t* i2c_inst, uint8_t slaveAddress)
+{
+    dev->i2c_ptr = i2c_inst;
+    dev->m_slaveAddress = slaveAddress;
+    dev->spi_ptr = NULL;
+    dev->m_spiMode = DPS310_SPI_4WIRE;
+    dev->m_opMode = IDLE;
+    dev->m_asyncCallback = NULL;
+    dev->m_asyncState = DPS310_ASYNC_IDLE;
+    dev->m_shadowValid = 0U;
+    dev->m_shadowDirty = 0U;
+    //temperature before every scheduled pressure sample until told otherwise
+    dev->m_tempSchedule.refreshInterval = 1U;
+    dev->m_tempSchedule.tempOsr = DPS__OVERSAMPLING_RATE_8;
+    dev->m_tempSchedule.checkInterval = 0U;
+    dev->m_tempSchedule.checkOsr = DPS__OVERSAMPLING_RATE_1;
+    dev->m_tempSchedule.driftThreshold = 0.1f;
+    dev->m_tempAge = DPS310__TEMP_AGE_UNKNOWN;
+    dev->m_tempCheckAge = 0U;
     //this flag will show if the initialization was successful
-    m_initFail = 0U;
+    dev->m_initFail = 0U;
 
     //Set I2C bus connection
-    m_SpiI2c = 1U;
+    dev->m_SpiI2c = 1U;
+}
+
+static void DPS310_initSPIState(DPS310_t *dev, cyhal_spi_t* spi_inst, uint8_t spiMode)
+{
+    DPS310_initState(dev, NULL, 0U);
+    dev->spi_ptr = spi_inst;
+    dev->m_spiMode = spiMode;
+
+    //Set SPI bus connection
+    dev->m_SpiI2c = 0U;
+}
 
+static int16_t DPS310_setSpiMode(DPS310_t *dev)
+{
+    //in 3-wire mode the sensor answers on SDI only after SPI3W is set, so write it blindly
+    if (dev->m_SpiI2c || (dev->m_spiMode != DPS310_SPI_3WIRE))
+    {
+        return DPS_SUCCEEDED;
+    }
+    return DPS310_writeByte(dev, DPS310__REG_ADR_SPI3W, DPS310__REG_CONTENT_SPI3W, 0U);
+}
+
+static void DPS310_initSensor(DPS310_t *dev)
+{
     cyhal_system_delay_ms(50);
 
-    int16_t prodId = DPS310_readByteBitfield(registers[PROD_ID]);
+    if (DPS310_setSpiMode(dev) != DPS_SUCCEEDED)
+    {
+        dev->m_initFail = 1U;
+        return;
+    }
+
+    int16_t prodId = DPS310_readByteBitfield(dev, registers[PROD_ID]);
     if (prodId < 0)
     {
         //Connected device is not a Dps310
-        m_initFail = 1U;
+        dev->m_initFail = 1U;
         return;
     }
-    m_productID = prodId;
+    dev->m_productID = prodId;
 
-    int16_t revId = DPS310_readByteBitfield(registers[REV_ID]);
+    int16_t revId = DPS310_readByteBitfield(dev, registers[REV_ID]);
     if (revId < 0)
     {
-        m_initFail = 1U;
+        dev->m_initFail = 1U;
+        return;
+    }
+    dev->m_revisionID = revId;
+
+    //mirror the configuration registers, all further bitfield writes go to the shadow
+    if (DPS310_loadShadow(dev) < 0)
+    {
+        dev->m_initFail = 1U;
         return;
     }
-    m_revisionID = revId;
 
     //find out which temperature sensor is calibrated with coefficients...
-    int16_t sensor = DPS310_readByteBitfield(registers[TEMP_SENSORREC]);
+    int16_t sensor = DPS310_readByteBitfield(dev, registers[TEMP_SENSORREC]);
     if (sensor < 0)
     {
-        m_initFail = 1U;
+        dev->m_initFail = 1U;
         return;
     }
 
     //...and use this sensor for temperature measurement
-    m_tempSensor = sensor;
-    if (DPS310_writeByteBitfield_reg((uint8_t)sensor, registers[TEMP_SENSOR]) < 0)
+    dev->m_tempSensor = sensor;
+    DPS310_writeByteBitfield_reg(dev, (uint8_t)sensor, registers[TEMP_SENSOR]);
+    if (DPS310_flushShadow(dev, 0U) < 0)
     {
-        m_initFail = 1U;
+        dev->m_initFail = 1U;
         return;
     }
 
     //read coefficients
-    if (DPS310_readcoeffs() < 0)
+    if (DPS310_readcoeffs(dev) < 0)
     {
-        m_initFail = 1U;
+        dev->m_initFail = 1U;
         return;
     }
 
     //set to standby for further configuration
-    DPS310_standby();
+    DPS310_standby(dev);
 
     //set measurement precision and rate to standard values;
-    DPS310_configTemp(DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8);
-    DPS310_configPressure(DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8);
+    DPS310_configTemp(dev, DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8);
+    DPS310_configPressure(dev, DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8);
 
     //perform a first temperature measurement
     //the most recent temperature will be saved internally
     //and used for compensation when calculating pressure
     float trash;
-    DPS310_measureTempOnce(&trash);
+    DPS310_measureTempOnce(dev, &trash);
 
     //make sure the DPS310 is in standby after initialization
-    DPS310_standby();
+    DPS310_standby(dev);
 
     // Fix IC with a fuse bit problem, which lead to a wrong temperature
     // Should not affect ICs without this problem
-    DPS310_correctTemp();
+    DPS310_correctTemp(dev);
+
+}
+
+void DPS310_init(DPS310_t *dev, cyhal_i2c_t* i2c_inst, uint8_t slaveAddress)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_INIT);
+    DPS310_initState(dev, i2c_inst, slaveAddress);
+    DPS310_initSensor(dev);
+}
+
+void DPS310_initSPI(DPS310_t *dev, cyhal_spi_t* spi_inst, uint8_t spiMode)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_INIT);
+    DPS310_initSPIState(dev, spi_inst, spiMode);
+    DPS310_initSensor(dev);
+}
+
+static uint32_t DPS310_calibChecksum(const DPS310_calib_t *calib)
+{
+    //Adler-32 over everything but the checksum itself
+    const uint8_t *data = (const uint8_t *)calib;
+    uint32_t a = 1U;
+    uint32_t b = 0U;
+    for (uint32_t i = 0; i < sizeof(DPS310_calib_t) - sizeof(calib->checksum); i++)
+    {
+        a = (a + data[i]) % 65521U;
+        b = (b + a) % 65521U;
+    }
+    //the magic number rejects erased or never written storage
+    return ((b << 16) | a) ^ DPS310__CALIB_MAGIC;
+}
+
+void DPS310_getCalib(DPS310_t *dev, DPS310_calib_t *calib)
+{
+    memset(calib, 0, sizeof(DPS310_calib_t));
+    calib->productID = dev->m_productID;
+    calib->revisionID = dev->m_revisionID;
+    calib->tempSensor = dev->m_tempSensor;
+    calib->c0Half = dev->m_c0Half;
+    calib->c1 = dev->m_c1;
+    calib->c00 = dev->m_c00;
+    calib->c10 = dev->m_c10;
+    calib->c01 = dev->m_c01;
+    calib->c11 = dev->m_c11;
+    calib->c20 = dev->m_c20;
+    calib->c21 = dev->m_c21;
+    calib->c30 = dev->m_c30;
+    calib->lastTempScal = dev->m_lastTempScal;
+    calib->checksum = DPS310_calibChecksum(calib);
+}
+
+static int16_t DPS310_initFromCalib(DPS310_t *dev, const DPS310_calib_t *calib)
+{
+    if (DPS310_setSpiMode(dev) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+
+    //one read tells if the same sensor is still there and powered
+    int16_t id = DPS310_readByte(dev, registers[PROD_ID].regAddress);
+    if (id < 0)
+    {
+        return DPS_FAILED;
+    }
+    if ((((uint8_t)id & registers[PROD_ID].mask) >> registers[PROD_ID].shift) != calib->productID
+            || (((uint8_t)id & registers[REV_ID].mask) >> registers[REV_ID].shift) != calib->revisionID)
+    {
+        return DPS_FAILED;
+    }
+    dev->m_productID = calib->productID;
+    dev->m_revisionID = calib->revisionID;
+    dev->m_tempSensor = calib->tempSensor;
+    dev->m_c0Half = calib->c0Half;
+    dev->m_c1 = calib->c1;
+    dev->m_c00 = calib->c00;
+    dev->m_c10 = calib->c10;
+    dev->m_c01 = calib->c01;
+    dev->m_c11 = calib->c11;
+    dev->m_c20 = calib->c20;
+    dev->m_c21 = calib->c21;
+    dev->m_c30 = calib->c30;
+
+    //pressure compensation starts with the temperature cached before the reboot
+    dev->m_lastTempScal = calib->lastTempScal;
+    dev->m_lastTempScalQ = (int32_t)(calib->lastTempScal * (1L << DPS__SCAL_FRAC_BITS));
+
+    //the block includes the status flags of MEAS_CFG, a sensor that lost power may not be ready yet
+    int16_t measCfg = DPS310_loadShadow(dev);
+    if ((measCfg < 0) || (((uint8_t)measCfg & DPS310__MEAS_CFG_READY) != DPS310__MEAS_CFG_READY))
+    {
+        return DPS_FAILED;
+    }
+    if (DPS310_writeByteBitfield_reg(dev, dev->m_tempSensor, registers[TEMP_SENSOR]) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+
+    //the sensor may still run a mode from before the reboot
+    if (DPS310_standby(dev) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    if ((DPS310_configTemp(dev, DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8) != DPS_SUCCEEDED)
+            || (DPS310_configPressure(dev, DPS__MEASUREMENT_RATE_4, DPS__OVERSAMPLING_RATE_8) != DPS_SUCCEEDED))
+    {
+        return DPS_FAILED;
+    }
+
+    //the fuse fix is cheap to repeat, the measurement that follows it is not needed
+    return DPS310_writeTempFix(dev);
+}
+
+int16_t DPS310_initWarm(DPS310_t *dev, cyhal_i2c_t* i2c_inst, uint8_t slaveAddress, const DPS310_calib_t *calib)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_INIT_WARM);
+    DPS310_initState(dev, i2c_inst, slaveAddress);
+
+    if ((calib != NULL) && (calib->checksum == DPS310_calibChecksum(calib))
+            && (DPS310_initFromCalib(dev, calib) == DPS_SUCCEEDED))
+    {
+        return DPS310_WARM_START;
+    }
+
+    //no valid cache, or it belongs to another sensor
+    DPS310_init(dev, i2c_inst, slaveAddress);
+    return dev->m_initFail ? DPS_FAILED : DPS310_COLD_START;
+}
 
+int16_t DPS310_initWarmSPI(DPS310_t *dev, cyhal_spi_t* spi_inst, uint8_t spiMode, const DPS310_calib_t *calib)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_INIT_WARM);
+    DPS310_initSPIState(dev, spi_inst, spiMode);
+
+    if ((calib != NULL) && (calib->checksum == DPS310_calibChecksum(calib))
+            && (DPS310_initFromCalib(dev, calib) == DPS_SUCCEEDED))
+    {
+        return DPS310_WARM_START;
+    }
+
+    DPS310_initSPI(dev, spi_inst, spiMode);
+    return dev->m_initFail ? DPS_FAILED : DPS310_COLD_START;
 }
 
-int16_t DPS310_writeByteBitfield_reg(uint8_t data, RegMask_t regMask)
+int16_t DPS310_writeByteBitfield_reg(DPS310_t *dev, uint8_t data, RegMask_t regMask)
 {
-    return DPS310_writeByteBitfield(data, regMask.regAddress, regMask.mask, regMask.shift, 0U);
+    return DPS310_writeByteBitfield(dev, data, regMask.regAddress, regMask.mask, regMask.shift, 0U);
 }
 
-int16_t DPS310_writeByteBitfield(uint8_t data,
+int16_t DPS310_writeByteBitfield(DPS310_t *dev, uint8_t data,
                                     uint8_t regAddress,
                                     uint8_t mask,
                                     uint8_t shift,
                                     uint8_t check)
 {
-    int16_t old = DPS310_readByte(regAddress);
+    //configuration registers are only updated in RAM, DPS310_flushShadow() writes them
+    if (dev->m_shadowValid && (regAddress >= DPS310__SHADOW_FIRST_REG)
+            && (regAddress < DPS310__SHADOW_FIRST_REG + DPS310__SHADOW_NUM_REGS))
+    {
+        uint8_t idx = regAddress - DPS310__SHADOW_FIRST_REG;
+        uint8_t value = (dev->m_shadow[idx] & ~mask) | ((data << shift) & mask);
+        //MEAS_CFG is a command, it has to be written even if it did not change
+        if ((value != dev->m_shadow[idx]) || (regAddress == DPS310__REG_ADR_MEAS_CFG))
+        {
+            dev->m_shadow[idx] = value;
+            dev->m_shadowDirty |= (uint8_t)(1U << idx);
+        }
+        if (check)
+        {
+            return DPS310_flushShadow(dev, check);
+        }
+        return DPS_SUCCEEDED;
+    }
+
+    int16_t old = DPS310_readByte(dev, regAddress);
     if (old < 0)
     {
         //fail while reading
         return old;
     }
-    return DPS310_writeByte(regAddress, ((uint8_t)old & ~mask) | ((data << shift) & mask), check);
+    return DPS310_writeByte(dev, regAddress, ((uint8_t)old & ~mask) | ((data << shift) & mask), check);
+}
+
+static int16_t DPS310_readBlockSPI(DPS310_t *dev, uint8_t regAddress, uint8_t length, uint8_t *buffer)
+{
+    uint8_t command = regAddress | DPS310__SPI_READ_CMD;
+    uint8_t rx[DPS310__SPI_MAX_BLOCK_LENGTH + 1U];
+
+    if (length > DPS310__SPI_MAX_BLOCK_LENGTH)
+    {
+        return DPS_FAILED;
+    }
+    //one transfer with chip select held low, the register address auto-increments
+    DPS310_TRACE_BUS_START();
+    cy_rslt_t result = cyhal_spi_transfer(dev->spi_ptr, &command, 1U, rx, length + 1U, DPS310__SPI_FILL);
+    DPS310_TRACE_BUS_END(DPS310_TRACE_READ, regAddress, length);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return DPS_FAILED;
+    }
+    //the first byte was clocked in while the command went out
+    memcpy(buffer, &rx[1], length);
+    return length;
+}
+
+static cy_rslt_t DPS310_writeByteSPI(DPS310_t *dev, uint8_t regAddress, uint8_t data)
+{
+    uint8_t tx[2] = {(uint8_t)((regAddress & ~DPS310__SPI_RW_MASK) | DPS310__SPI_WRITE_CMD), data};
+    uint8_t rx[2];
+    DPS310_TRACE_BUS_START();
+    cy_rslt_t result = cyhal_spi_transfer(dev->spi_ptr, tx, 2U, rx, 2U, DPS310__SPI_FILL);
+    DPS310_TRACE_BUS_END(DPS310_TRACE_WRITE, regAddress, 1U);
+    return result;
 }
 
-int16_t DPS310_writeByte(uint8_t regAddress, uint8_t data, uint8_t check)
+int16_t DPS310_writeByte(DPS310_t *dev, uint8_t regAddress, uint8_t data, uint8_t check)
 {
     cy_rslt_t result;
-    result = cyhal_i2c_master_mem_write(i2c_ptr, DPS310_I2C_SLAVE_ADDRESS, regAddress, 0x01, &data, 1, 200);
+    if (dev->m_SpiI2c)
+    {
+        DPS310_TRACE_BUS_START();
+        result = cyhal_i2c_master_mem_write(dev->i2c_ptr, dev->m_slaveAddress, regAddress, 0x01, &data, 1, 200);
+        DPS310_TRACE_BUS_END(DPS310_TRACE_WRITE, regAddress, 1U);
+    }
+    else
+    {
+        result = DPS310_writeByteSPI(dev, regAddress, data);
+    }
     if(result == CY_RSLT_SUCCESS)
     {
         if (check == 0)
             return DPS_SUCCEEDED;					  //no checking
         else
         {
-            if (DPS310_readByte(regAddress) == data) //check if desired by calling function
+            if (DPS310_readByte(dev, regAddress) == data) //check if desired by calling function
             {
                 return DPS_SUCCEEDED;
             }
@@ -124,11 +396,57 @@ int16_t DPS310_writeByte(uint8_t regAddress, uint8_t data, uint8_t check)
             }
         }
     }
+    return DPS_FAILED;
+}
+
+int16_t DPS310_loadShadow(DPS310_t *dev)
+{
+    RegBlock_t shadowBlock = {DPS310__SHADOW_FIRST_REG, DPS310__SHADOW_NUM_REGS};
+
+    //one block read for all mirrored registers
+    dev->m_shadowValid = 0U;
+    if (DPS310_readBlock(dev, shadowBlock, dev->m_shadow) != DPS310__SHADOW_NUM_REGS)
+    {
+        return DPS_FAILED;
+    }
+    //only the measurement control bits of MEAS_CFG are writable, the rest are status flags
+    uint8_t measCfg = dev->m_shadow[DPS310__REG_ADR_MEAS_CFG - DPS310__SHADOW_FIRST_REG];
+    dev->m_shadow[DPS310__REG_ADR_MEAS_CFG - DPS310__SHADOW_FIRST_REG] &= config_registers[MSR_CTRL].mask;
+    dev->m_shadowDirty = 0U;
+    dev->m_shadowValid = 1U;
+    //MEAS_CFG as read, with the status flags
+    return measCfg;
+}
+
+int16_t DPS310_flushShadow(DPS310_t *dev, uint8_t check)
+{
+    //MEAS_CFG goes last, it starts the measurement the other registers configure
+    const uint8_t order[DPS310__SHADOW_NUM_REGS] = {0x06, 0x07, 0x09, DPS310__REG_ADR_MEAS_CFG};
+    int16_t ret = DPS_SUCCEEDED;
+
+    for (uint8_t i = 0; i < DPS310__SHADOW_NUM_REGS; i++)
+    {
+        uint8_t idx = order[i] - DPS310__SHADOW_FIRST_REG;
+        if (!(dev->m_shadowDirty & (1U << idx)))
+        {
+            continue;
+        }
+        //MEAS_CFG reads back with status flags, it cannot be checked
+        uint8_t regCheck = (order[i] == DPS310__REG_ADR_MEAS_CFG) ? 0U : check;
+        if (DPS310_writeByte(dev, order[i], dev->m_shadow[idx], regCheck) != DPS_SUCCEEDED)
+        {
+            //register stays dirty and is written again with the next flush
+            ret = DPS_FAILED;
+            continue;
+        }
+        dev->m_shadowDirty &= (uint8_t)~(1U << idx);
+    }
+    return ret;
 }
 
-int16_t DPS310_readByteBitfield(RegMask_t regMask)
+int16_t DPS310_readByteBitfield(DPS310_t *dev, RegMask_t regMask)
 {
-    int16_t ret = DPS310_readByte(regMask.regAddress);
+    int16_t ret = DPS310_readByte(dev, regMask.regAddress);
     if (ret < 0)
     {
         return ret;
@@ -136,11 +454,17 @@ int16_t DPS310_readByteBitfield(RegMask_t regMask)
     return (((uint8_t)ret) & regMask.mask) >> regMask.shift;
 }
 
-int16_t DPS310_readByte(uint8_t regAddress)
+int16_t DPS310_readByte(DPS310_t *dev, uint8_t regAddress)
 {
     cy_rslt_t result;
     uint8_t value;
-    result = cyhal_i2c_master_mem_read(i2c_ptr, DPS310_I2C_SLAVE_ADDRESS, regAddress, 1, &value, 1, 200);
+    if (!dev->m_SpiI2c)
+    {
+        return (DPS310_readBlockSPI(dev, regAddress, 1U, &value) == 1) ? value : DPS_FAILED;
+    }
+    DPS310_TRACE_BUS_START();
+    result = cyhal_i2c_master_mem_read(dev->i2c_ptr, dev->m_slaveAddress, regAddress, 1, &value, 1, 200);
+    DPS310_TRACE_BUS_END(DPS310_TRACE_READ, regAddress, 1U);
     if(result == CY_RSLT_SUCCESS)
     {
         return value;
@@ -149,42 +473,47 @@ int16_t DPS310_readByte(uint8_t regAddress)
         return DPS_FAILED;
 }
 
-int16_t DPS310_readcoeffs(void)
+int16_t DPS310_readcoeffs(DPS310_t *dev)
 {
     // TODO: remove magic number
     uint8_t buffer[18];
     //read COEF registers to buffer
-    int16_t ret = DPS310_readBlock(coeffBlock, buffer);
+    int16_t ret = DPS310_readBlock(dev, coeffBlock, buffer);
+    //a short read leaves garbage in the buffer, don't compose or cache it
+    if (ret != coeffBlock.length)
+    {
+        return DPS_FAILED;
+    }
 
     //compose coefficients from buffer content
-    m_c0Half = ((uint32_t)buffer[0] << 4) | (((uint32_t)buffer[1] >> 4) & 0x0F);
-    DPS310_getTwosComplement(&m_c0Half, 12);
+    dev->m_c0Half = ((uint32_t)buffer[0] << 4) | (((uint32_t)buffer[1] >> 4) & 0x0F);
+    DPS310_getTwosComplement(&dev->m_c0Half, 12);
     //c0 is only used as c0*0.5, so c0_half is calculated immediately
-    m_c0Half = m_c0Half / 2U;
+    dev->m_c0Half = dev->m_c0Half / 2U;
 
     //now do the same thing for all other coefficients
-    m_c1 = (((uint32_t)buffer[1] & 0x0F) << 8) | (uint32_t)buffer[2];
-    DPS310_getTwosComplement(&m_c1, 12);
-    m_c00 = ((uint32_t)buffer[3] << 12) | ((uint32_t)buffer[4] << 4) | (((uint32_t)buffer[5] >> 4) & 0x0F);
-    DPS310_getTwosComplement(&m_c00, 20);
-    m_c10 = (((uint32_t)buffer[5] & 0x0F) << 16) | ((uint32_t)buffer[6] << 8) | (uint32_t)buffer[7];
-    DPS310_getTwosComplement(&m_c10, 20);
-
-    m_c01 = ((uint32_t)buffer[8] << 8) | (uint32_t)buffer[9];
-    DPS310_getTwosComplement(&m_c01, 16);
-
-    m_c11 = ((uint32_t)buffer[10] << 8) | (uint32_t)buffer[11];
-    DPS310_getTwosComplement(&m_c11, 16);
-    m_c20 = ((uint32_t)buffer[12] << 8) | (uint32_t)buffer[13];
-    DPS310_getTwosComplement(&m_c20, 16);
-    m_c21 = ((uint32_t)buffer[14] << 8) | (uint32_t)buffer[15];
-    DPS310_getTwosComplement(&m_c21, 16);
-    m_c30 = ((uint32_t)buffer[16] << 8) | (uint32_t)buffer[17];
-    DPS310_getTwosComplement(&m_c30, 16);
+    dev->m_c1 = (((uint32_t)buffer[1] & 0x0F) << 8) | (uint32_t)buffer[2];
+    DPS310_getTwosComplement(&dev->m_c1, 12);
+    dev->m_c00 = ((uint32_t)buffer[3] << 12) | ((uint32_t)buffer[4] << 4) | (((uint32_t)buffer[5] >> 4) & 0x0F);
+    DPS310_getTwosComplement(&dev->m_c00, 20);
+    dev->m_c10 = (((uint32_t)buffer[5] & 0x0F) << 16) | ((uint32_t)buffer[6] << 8) | (uint32_t)buffer[7];
+    DPS310_getTwosComplement(&dev->m_c10, 20);
+
+    dev->m_c01 = ((uint32_t)buffer[8] << 8) | (uint32_t)buffer[9];
+    DPS310_getTwosComplement(&dev->m_c01, 16);
+
+    dev->m_c11 = ((uint32_t)buffer[10] << 8) | (uint32_t)buffer[11];
+    DPS310_getTwosComplement(&dev->m_c11, 16);
+    dev->m_c20 = ((uint32_t)buffer[12] << 8) | (uint32_t)buffer[13];
+    DPS310_getTwosComplement(&dev->m_c20, 16);
+    dev->m_c21 = ((uint32_t)buffer[14] << 8) | (uint32_t)buffer[15];
+    DPS310_getTwosComplement(&dev->m_c21, 16);
+    dev->m_c30 = ((uint32_t)buffer[16] << 8) | (uint32_t)buffer[17];
+    DPS310_getTwosComplement(&dev->m_c30, 16);
     return DPS_SUCCEEDED;
 }
 
-int16_t DPS310_readBlock(RegBlock_t regBlock, uint8_t *buffer)
+int16_t DPS310_readBlock(DPS310_t *dev, RegBlock_t regBlock, uint8_t *buffer)
 {
     //do not read if there is no buffer
     if (buffer == NULL)
@@ -192,8 +521,15 @@ int16_t DPS310_readBlock(RegBlock_t regBlock, uint8_t *buffer)
         return 0; //0 bytes read successfully
     }
 
+    if (!dev->m_SpiI2c)
+    {
+        return DPS310_readBlockSPI(dev, regBlock.regAddress, regBlock.length, buffer);
+    }
+
     cy_rslt_t result;
-    result = cyhal_i2c_master_mem_read(i2c_ptr, DPS310_I2C_SLAVE_ADDRESS, regBlock.regAddress, 1, buffer, regBlock.length, 200);
+    DPS310_TRACE_BUS_START();
+    result = cyhal_i2c_master_mem_read(dev->i2c_ptr, dev->m_slaveAddress, regBlock.regAddress, 1, buffer, regBlock.length, 200);
+    DPS310_TRACE_BUS_END(DPS310_TRACE_READ, regBlock.regAddress, regBlock.length);
     if(result == CY_RSLT_SUCCESS)
     {
         return regBlock.length;
@@ -210,242 +546,566 @@ void DPS310_getTwosComplement(int32_t *raw, uint8_t length)
     }
 }
 
-int16_t DPS310_standby(void)
+int16_t DPS310_standby(DPS310_t *dev)
 {
+    DPS310_TRACE_SCOPE(DPS310_TRACE_STANDBY);
     //abort if initialization failed
-    if (m_initFail)
+    if (dev->m_initFail)
     {
         return DPS_FAILED;
     }
     //set device to idling mode
-    int16_t ret = DPS310_setOpMode(IDLE);
+    int16_t ret = DPS310_setOpMode(dev, IDLE);
     if (ret != DPS_SUCCEEDED)
     {
         return ret;
     }
-    ret = DPS310_disableFIFO();
+    ret = DPS310_disableFIFO(dev);
     return ret;
 }
 
-int16_t DPS310_setOpMode(uint8_t opMode)
+int16_t DPS310_setOpMode(DPS310_t *dev, uint8_t opMode)
 {
-    if (DPS310_writeByteBitfield_reg(opMode, config_registers[MSR_CTRL]) == -1)
+    if (DPS310_writeByteBitfield_reg(dev, opMode, config_registers[MSR_CTRL]) == -1)
+    {
+        return DPS_FAILED;
+    }
+    //pending configuration changes are written together with the new mode
+    if (DPS310_flushShadow(dev, 0U) != DPS_SUCCEEDED)
     {
         return DPS_FAILED;
     }
-    m_opMode = (enum Mode)opMode;
+    dev->m_opMode = (enum Mode)opMode;
     return DPS_SUCCEEDED;
 }
 
-int16_t DPS310_disableFIFO()
+int16_t DPS310_disableFIFO(DPS310_t *dev)
 {
-    int16_t ret = DPS310_flushFIFO();
-    ret = DPS310_writeByteBitfield_reg(0U, config_registers[FIFO_EN]);
-    return ret;
+    int16_t ret = DPS310_flushFIFO(dev);
+    ret = DPS310_writeByteBitfield_reg(dev, 0U, config_registers[FIFO_EN]);
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+    return DPS310_flushShadow(dev, 0U);
 }
 
-int16_t DPS310_flushFIFO()
+int16_t DPS310_flushFIFO(DPS310_t *dev)
 {
-    return DPS310_writeByteBitfield_reg(1U, registers[FIFO_FL]);
+    //the RESET register is write only, so there is nothing to read-modify-write
+    return DPS310_writeByte(dev, registers[FIFO_FL].regAddress, registers[FIFO_FL].mask, 0U);
 }
 
-int16_t DPS310_configTemp(uint8_t tempMr, uint8_t tempOsr)
+int16_t DPS310_enableFIFO(DPS310_t *dev)
 {
-    tempMr &= 0x07;
-    tempOsr &= 0x07;
-    // two accesses to the same register; for readability
-    int16_t ret = DPS310_writeByteBitfield_reg(tempMr, config_registers[TEMP_MR]);
-    ret = DPS310_writeByteBitfield_reg(tempOsr, config_registers[TEMP_OSR]);
-
-    //abort immediately on fail
+    int16_t ret = DPS310_writeByteBitfield_reg(dev, 1U, config_registers[FIFO_EN]);
     if (ret != DPS_SUCCEEDED)
     {
-        return DPS_FAILED;
-    }
-    m_tempMr = tempMr;
-    m_tempOsr = tempOsr;
-
-    DPS310_writeByteBitfield_reg(m_tempSensor, registers[TEMP_SENSOR]);
-    //set TEMP SHIFT ENABLE if oversampling rate higher than eight(2^3)
-    if (tempOsr > DPS310__OSR_SE)
-    {
-        ret = DPS310_writeByteBitfield_reg(1U, registers[TEMP_SE]);
-    }
-    else
-    {
-        ret = DPS310_writeByteBitfield_reg(0U, registers[TEMP_SE]);
+        return ret;
     }
-    return ret;
+    return DPS310_flushShadow(dev, 0U);
 }
 
-int16_t DPS310_configPressure(uint8_t prsMr, uint8_t prsOsr)
+int16_t DPS310_readFIFO(DPS310_t *dev, int32_t *rawBuffer, uint8_t maxCount)
 {
-    prsMr &= 0x07;
-    prsOsr &= 0x07;
-    int16_t ret = DPS310_writeByteBitfield_reg(prsMr, config_registers[PRS_MR]);
-    ret = DPS310_writeByteBitfield_reg(prsOsr, config_registers[PRS_OSR]);
+    uint8_t buffer[DPS__RESULT_BLOCK_LENGTH];
+    uint8_t count = 0U;
+    uint8_t limit = maxCount;
 
-    //abort immediately on fail
-    if (ret != DPS_SUCCEEDED)
+    //FIFO_EMPTY and FIFO_FULL live in the same status register, one read gives both
+    int16_t status = DPS310_readByte(dev, registers[FIFO_EMPTY].regAddress);
+    if (status < 0)
     {
         return DPS_FAILED;
     }
-    m_prsMr = prsMr;
-    m_prsOsr = prsOsr;
-    //set PM SHIFT ENABLE if oversampling rate higher than eight(2^3)
-    if (prsOsr > DPS310__OSR_SE)
+    if (status & registers[FIFO_EMPTY].mask)
     {
-        ret = DPS310_writeByteBitfield_reg(1U, registers[PRS_SE]);
+        return 0;
     }
-    else
+    //a full FIFO holds exactly DPS__FIFO_SIZE results, no need to look for the end marker
+    if ((status & registers[FIFO_FULL].mask) && (limit > DPS__FIFO_SIZE))
     {
-        ret = DPS310_writeByteBitfield_reg(0U, registers[PRS_SE]);
+        limit = DPS__FIFO_SIZE;
     }
-    return ret;
-}
 
-int16_t DPS310_measureTempOnce(float* result)
-{
-    return DPS310_measureTempOnce_oversample(result, m_tempOsr);
+    //every block read of the pressure result registers pops one FIFO entry
+    while (count < limit)
+    {
+        if (DPS310_readBlock(dev, registerBlocks[PRS], buffer) != DPS__RESULT_BLOCK_LENGTH)
+        {
+            return DPS_FAILED;
+        }
+        int32_t raw = (uint32_t)buffer[0] << 16 | (uint32_t)buffer[1] << 8 | (uint32_t)buffer[2];
+        //an empty FIFO reads back as 0x800000
+        if (raw == DPS310__FIFO_EMPTY_VALUE)
+        {
+            break;
+        }
+        DPS310_getTwosComplement(&raw, 24);
+        rawBuffer[count++] = raw;
+    }
+    return count;
 }
 
-int16_t DPS310_measureTempOnce_oversample(float* result, uint8_t oversamplingRate)
+int16_t DPS310_startMeasureTempCont(DPS310_t *dev, uint8_t measureRate, uint8_t oversamplingRate)
 {
-    //Start measurement
-    int16_t ret = DPS310_startMeasureTempOnce(oversamplingRate);
-    if (ret != DPS_SUCCEEDED)
+    DPS310_TRACE_SCOPE(DPS310_TRACE_START_CONT);
+    //abort if initialization failed
+    if (dev->m_initFail)
     {
-        return ret;
+        return DPS_FAILED;
     }
-
-    //wait until measurement is finished
-    uint16_t busy_time = DPS310_calcBusyTime(0U, m_tempOsr);
-    cyhal_system_delay_ms(busy_time / DPS__BUSYTIME_SCALING);
-    cyhal_system_delay_ms(DPS310__BUSYTIME_FAILSAFE);
-
-    ret = DPS310_getSingleResult(result);
-    if (ret != DPS_SUCCEEDED)
+    //abort if device is not in idling mode
+    if (dev->m_opMode != IDLE)
     {
-        DPS310_standby();
+        return DPS_FAILED;
     }
-    return ret;
-}
-
-int16_t DPS310_startMeasureTempOnce_void(void)
-{
-    return DPS310_startMeasureTempOnce(m_tempOsr);
+    //abort if speed and precision are too high
+    if (DPS310_calcBusyTime(measureRate, oversamplingRate) >= DPS310__MAX_BUSYTIME)
+    {
+        return DPS_FAILED;
+    }
+    if (DPS310_setTempConfig(dev, measureRate, oversamplingRate) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //results are collected in the FIFO and drained in bursts
+    if (DPS310_writeByteBitfield_reg(dev, 1U, config_registers[FIFO_EN]) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //writes the whole configuration, one write per changed register
+    return DPS310_setOpMode(dev, CONT_TMP);
 }
 
-int16_t DPS310_startMeasureTempOnce(uint8_t oversamplingRate)
+int16_t DPS310_startMeasurePressureCont(DPS310_t *dev, uint8_t measureRate, uint8_t oversamplingRate)
 {
+    DPS310_TRACE_SCOPE(DPS310_TRACE_START_CONT);
     //abort if initialization failed
-    if (m_initFail)
+    if (dev->m_initFail)
     {
         return DPS_FAILED;
     }
     //abort if device is not in idling mode
-    if (m_opMode != IDLE)
+    if (dev->m_opMode != IDLE)
     {
         return DPS_FAILED;
     }
-
-    if (oversamplingRate != m_tempOsr)
+    //abort if speed and precision are too high
+    if (DPS310_calcBusyTime(measureRate, oversamplingRate) >= DPS310__MAX_BUSYTIME)
     {
-        //configuration of oversampling rate
-        if (DPS310_configTemp(0U, oversamplingRate) != DPS_SUCCEEDED)
-        {
-            return DPS_FAILED;
-        }
+        return DPS_FAILED;
     }
-
-    //set device to temperature measuring mode
-    return DPS310_setOpMode(CMD_TEMP);
-}
-
-uint16_t DPS310_calcBusyTime(uint16_t mr, uint16_t osr)
-{
-    //formula from datasheet (optimized)
-    return ((uint32_t)20U << mr) + ((uint32_t)16U << (osr + mr));
+    if (DPS310_setPressureConfig(dev, measureRate, oversamplingRate) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //results are collected in the FIFO and drained in bursts
+    if (DPS310_writeByteBitfield_reg(dev, 1U, config_registers[FIFO_EN]) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //writes the whole configuration, one write per changed register
+    return DPS310_setOpMode(dev, CONT_PRS);
 }
 
-int16_t DPS310_correctTemp(void)
+int16_t DPS310_startMeasureBothCont(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr, uint8_t prsMr, uint8_t prsOsr)
 {
-    if (m_initFail)
+    DPS310_TRACE_SCOPE(DPS310_TRACE_START_CONT);
+    //abort if initialization failed
+    if (dev->m_initFail)
     {
         return DPS_FAILED;
     }
-    DPS310_writeByte(0x0E, 0xA5, 0);
-    DPS310_writeByte(0x0F, 0x96, 0);
-    DPS310_writeByte(0x62, 0x02, 0);
-    DPS310_writeByte(0x0E, 0x00, 0);
-    DPS310_writeByte(0x0F, 0x00, 0);
-
-    //perform a first temperature measurement (again)
-    //the most recent temperature will be saved internally
-    //and used for compensation when calculating pressure
-    float trash;
-    DPS310_measureTempOnce(&trash);
-
-    return DPS_SUCCEEDED;
+    //abort if device is not in idling mode
+    if (dev->m_opMode != IDLE)
+    {
+        return DPS_FAILED;
+    }
+    //abort if speed and precision are too high
+    if (DPS310_calcBusyTime(tempMr, tempOsr) + DPS310_calcBusyTime(prsMr, prsOsr) >= DPS310__MAX_BUSYTIME)
+    {
+        return DPS_FAILED;
+    }
+    if (DPS310_setTempConfig(dev, tempMr, tempOsr) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    if (DPS310_setPressureConfig(dev, prsMr, prsOsr) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //results are collected in the FIFO and drained in bursts
+    if (DPS310_writeByteBitfield_reg(dev, 1U, config_registers[FIFO_EN]) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //writes the whole configuration, one write per changed register
+    return DPS310_setOpMode(dev, CONT_BOTH);
 }
 
-int16_t DPS310_getSingleResult(float* result)
+int16_t DPS310_getContResults(DPS310_t *dev, float *tempBuffer, uint8_t *tempCount, float *prsBuffer, uint8_t *prsCount)
 {
+    DPS310_TRACE_SCOPE(DPS310_TRACE_GET_CONT);
+    int32_t raw[DPS__FIFO_SIZE];
+    uint8_t tempSize = *tempCount;
+    uint8_t prsSize = *prsCount;
+
+    *tempCount = 0U;
+    *prsCount = 0U;
+
     //abort if initialization failed
-    if (m_initFail)
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+    //abort if device is not in background mode
+    if (dev->m_opMode != CONT_TMP && dev->m_opMode != CONT_PRS && dev->m_opMode != CONT_BOTH)
     {
         return DPS_FAILED;
     }
 
-    //read finished bit for current opMode
-    int16_t rdy;
-    switch (m_opMode)
+    int16_t count = DPS310_readFIFO(dev, raw, DPS__FIFO_SIZE);
+    if (count < 0)
     {
-    case CMD_TEMP: //temperature
-        rdy = DPS310_readByteBitfield(config_registers[TEMP_RDY]);
-        break;
-    case CMD_PRS: //pressure
-        rdy = DPS310_readByteBitfield(config_registers[PRS_RDY]);
-        break;
-    default: //DPS310 not in command mode
         return DPS_FAILED;
     }
-    //read new measurement result
-    switch (rdy)
+
+    //results are compensated in FIFO order, so every pressure value
+    //uses the temperature measured right before it
+    int16_t i = 0;
+    while (i < count)
     {
-        case DPS_FAILED: //could not read ready flag
-            return DPS_FAILED;
-        case 1: //measurement ready, expected case
+        //the last bit of a FIFO entry marks pressure (1) or temperature (0)
+        if (!(raw[i] & 0x01))
         {
-            enum Mode oldMode = m_opMode;
-            m_opMode = IDLE; //opcode was automatically reseted by DPS310
-            int32_t raw_val = 0;
-            switch (oldMode)
+            float temp = DPS310_calcTemp(dev, raw[i]);
+            if (*tempCount < tempSize)
             {
-            case CMD_TEMP: //temperature
-                if(DPS310_getRawResult(&raw_val, registerBlocks[TEMP]) != DPS_SUCCEEDED)
-                {
-                    printf("Failed to read data\r\n");
-                    return DPS_FAILED;
-                }
-                *result = DPS310_calcTemp(raw_val);
-                return DPS_SUCCEEDED; // TODO
-            case CMD_PRS:			   //pressure
-                DPS310_getRawResult(&raw_val, registerBlocks[PRS]);
-                *result = DPS310_calcPressure(raw_val);
-                return DPS_SUCCEEDED; // TODO
-            default:
-                return DPS_FAILED; //should already be filtered above
+                tempBuffer[(*tempCount)++] = temp;
             }
+            i++;
+            continue;
+        }
+
+        //all pressure values up to the next temperature share one compensation
+        int16_t run = 1;
+        while ((i + run < count) && (raw[i + run] & 0x01))
+        {
+            run++;
+        }
+        if (run > prsSize - *prsCount)
+        {
+            run = prsSize - *prsCount;
         }
+        DPS310_calcPressureBatch(dev, &raw[i], &prsBuffer[*prsCount], run);
+        *prsCount += run;
+        while ((i < count) && (raw[i] & 0x01))
+        {
+            i++;
+        }
+    }
+    return DPS_SUCCEEDED;
+}
+
+int16_t DPS310_getContResultsFixed(DPS310_t *dev, int32_t *tempBuffer, uint8_t *tempCount, int32_t *prsBuffer, uint8_t *prsCount)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_GET_CONT);
+    int32_t raw[DPS__FIFO_SIZE];
+    uint8_t tempSize = *tempCount;
+    uint8_t prsSize = *prsCount;
+
+    *tempCount = 0U;
+    *prsCount = 0U;
+
+    //abort if initialization failed
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+    //abort if device is not in background mode
+    if (dev->m_opMode != CONT_TMP && dev->m_opMode != CONT_PRS && dev->m_opMode != CONT_BOTH)
+    {
+        return DPS_FAILED;
+    }
+
+    int16_t count = DPS310_readFIFO(dev, raw, DPS__FIFO_SIZE);
+    if (count < 0)
+    {
+        return DPS_FAILED;
+    }
+
+    //same as DPS310_getContResults(), but without any floating point
+    int16_t i = 0;
+    while (i < count)
+    {
+        if (!(raw[i] & 0x01))
+        {
+            int32_t temp = DPS310_calcTempFixed(dev, raw[i]);
+            if (*tempCount < tempSize)
+            {
+                tempBuffer[(*tempCount)++] = temp;
+            }
+            i++;
+            continue;
+        }
+
+        int16_t run = 1;
+        while ((i + run < count) && (raw[i + run] & 0x01))
+        {
+            run++;
+        }
+        if (run > prsSize - *prsCount)
+        {
+            run = prsSize - *prsCount;
+        }
+        DPS310_calcPressureBatchFixed(dev, &raw[i], &prsBuffer[*prsCount], run);
+        *prsCount += run;
+        while ((i < count) && (raw[i] & 0x01))
+        {
+            i++;
+        }
+    }
+    return DPS_SUCCEEDED;
+}
+
+int16_t DPS310_configTemp(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_CONFIG_TEMP);
+    if (DPS310_setTempConfig(dev, tempMr, tempOsr) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    return DPS310_flushShadow(dev, 0U);
+}
+
+int16_t DPS310_configPressure(DPS310_t *dev, uint8_t prsMr, uint8_t prsOsr)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_CONFIG_PRESSURE);
+    if (DPS310_setPressureConfig(dev, prsMr, prsOsr) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    return DPS310_flushShadow(dev, 0U);
+}
+
+static int16_t DPS310_setTempConfig(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr)
+{
+    tempMr &= 0x07;
+    tempOsr &= 0x07;
+    // two accesses to the same register; for readability, the shadow turns them into one write
+    int16_t ret = DPS310_writeByteBitfield_reg(dev, tempMr, config_registers[TEMP_MR]);
+    ret = DPS310_writeByteBitfield_reg(dev, tempOsr, config_registers[TEMP_OSR]);
+
+    //abort immediately on fail
+    if (ret != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    dev->m_tempMr = tempMr;
+    dev->m_tempOsr = tempOsr;
+
+    DPS310_writeByteBitfield_reg(dev, dev->m_tempSensor, registers[TEMP_SENSOR]);
+    //set TEMP SHIFT ENABLE if oversampling rate higher than eight(2^3)
+    if (tempOsr > DPS310__OSR_SE)
+    {
+        ret = DPS310_writeByteBitfield_reg(dev, 1U, registers[TEMP_SE]);
+    }
+    else
+    {
+        ret = DPS310_writeByteBitfield_reg(dev, 0U, registers[TEMP_SE]);
+    }
+    return ret;
+}
+
+static int16_t DPS310_setPressureConfig(DPS310_t *dev, uint8_t prsMr, uint8_t prsOsr)
+{
+    prsMr &= 0x07;
+    prsOsr &= 0x07;
+    int16_t ret = DPS310_writeByteBitfield_reg(dev, prsMr, config_registers[PRS_MR]);
+    ret = DPS310_writeByteBitfield_reg(dev, prsOsr, config_registers[PRS_OSR]);
+
+    //abort immediately on fail
+    if (ret != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    dev->m_prsMr = prsMr;
+    dev->m_prsOsr = prsOsr;
+    //set PM SHIFT ENABLE if oversampling rate higher than eight(2^3)
+    if (prsOsr > DPS310__OSR_SE)
+    {
+        ret = DPS310_writeByteBitfield_reg(dev, 1U, registers[PRS_SE]);
+    }
+    else
+    {
+        ret = DPS310_writeByteBitfield_reg(dev, 0U, registers[PRS_SE]);
+    }
+    return ret;
+}
+
+int16_t DPS310_measureTempOnce(DPS310_t *dev, float* result)
+{
+    return DPS310_measureTempOnce_oversample(dev, result, dev->m_tempOsr);
+}
+
+int16_t DPS310_measureTempOnce_oversample(DPS310_t *dev, float* result, uint8_t oversamplingRate)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_MEASURE_TEMP);
+    //Start measurement
+    int16_t ret = DPS310_startMeasureTempOnce(dev, oversamplingRate);
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+
+    //wait until measurement is finished
+    uint16_t busy_time = DPS310_calcBusyTime(0U, dev->m_tempOsr);
+    cyhal_system_delay_ms(busy_time / DPS__BUSYTIME_SCALING);
+    cyhal_system_delay_ms(DPS310__BUSYTIME_FAILSAFE);
+
+    ret = DPS310_getSingleResult(dev, result);
+    if (ret != DPS_SUCCEEDED)
+    {
+        DPS310_standby(dev);
+    }
+    return ret;
+}
+
+int16_t DPS310_startMeasureTempOnce_void(DPS310_t *dev)
+{
+    return DPS310_startMeasureTempOnce(dev, dev->m_tempOsr);
+}
+
+int16_t DPS310_startMeasureTempOnce(DPS310_t *dev, uint8_t oversamplingRate)
+{
+    //abort if initialization failed
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+    //abort if device is not in idling mode
+    if (dev->m_opMode != IDLE)
+    {
+        return DPS_FAILED;
+    }
+
+    if (oversamplingRate != dev->m_tempOsr)
+    {
+        //configuration of oversampling rate
+        if (DPS310_setTempConfig(dev, 0U, oversamplingRate) != DPS_SUCCEEDED)
+        {
+            return DPS_FAILED;
+        }
+    }
+
+    //set device to temperature measuring mode, configuration is written along with it
+    return DPS310_setOpMode(dev, CMD_TEMP);
+}
+
+uint16_t DPS310_calcBusyTime(uint16_t mr, uint16_t osr)
+{
+    //formula from datasheet (optimized)
+    return ((uint32_t)20U << mr) + ((uint32_t)16U << (osr + mr));
+}
+
+int16_t DPS310_correctTemp(DPS310_t *dev)
+{
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+    if (DPS310_writeTempFix(dev) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+
+    //perform a first temperature measurement (again)
+    //the most recent temperature will be saved internally
+    //and used for compensation when calculating pressure
+    float trash;
+    DPS310_measureTempOnce(dev, &trash);
+
+    return DPS_SUCCEEDED;
+}
+
+static int16_t DPS310_writeTempFix(DPS310_t *dev)
+{
+    const uint8_t fix[][2] = {{0x0E, 0xA5}, {0x0F, 0x96}, {0x62, 0x02}, {0x0E, 0x00}, {0x0F, 0x00}};
+
+    for (uint8_t i = 0; i < sizeof(fix) / sizeof(fix[0]); i++)
+    {
+        if (DPS310_writeByte(dev, fix[i][0], fix[i][1], 0) != DPS_SUCCEEDED)
+        {
+            return DPS_FAILED;
+        }
+    }
+    return DPS_SUCCEEDED;
+}
+
+int16_t DPS310_getSingleResult(DPS310_t *dev, float* result)
+{
+    //abort if initialization failed
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+
+    //read finished bit for current opMode
+    int16_t rdy;
+    switch (dev->m_opMode)
+    {
+    case CMD_TEMP: //temperature
+        rdy = DPS310_readByteBitfield(dev, config_registers[TEMP_RDY]);
+        break;
+    case CMD_PRS: //pressure
+        rdy = DPS310_readByteBitfield(dev, config_registers[PRS_RDY]);
+        break;
+    default: //DPS310 not in command mode
+        return DPS_FAILED;
+    }
+    //read new measurement result
+    switch (rdy)
+    {
+        case DPS_FAILED: //could not read ready flag
+            return DPS_FAILED;
+        case 1: //measurement ready, expected case
+            return DPS310_readSingleResult(dev, result);
     }
     return DPS_FAILED;
 }
 
-int16_t DPS310_getRawResult(int32_t *raw, RegBlock_t reg)
+int16_t DPS310_readSingleResult(DPS310_t *dev, float* result)
+{
+    enum Mode oldMode = dev->m_opMode;
+    dev->m_opMode = IDLE; //opcode was automatically reseted by DPS310
+    dev->m_shadow[DPS310__REG_ADR_MEAS_CFG - DPS310__SHADOW_FIRST_REG] &= ~config_registers[MSR_CTRL].mask;
+    int32_t raw_val = 0;
+    switch (oldMode)
+    {
+    case CMD_TEMP: //temperature
+        if (DPS310_getRawResult(dev, &raw_val, registerBlocks[TEMP]) != DPS_SUCCEEDED)
+        {
+            return DPS_FAILED;
+        }
+        *result = DPS310_calcTemp(dev, raw_val);
+        return DPS_SUCCEEDED;
+    case CMD_PRS:			   //pressure
+        if (DPS310_getRawResult(dev, &raw_val, registerBlocks[PRS]) != DPS_SUCCEEDED)
+        {
+            return DPS_FAILED;
+        }
+        *result = DPS310_calcPressure(dev, raw_val);
+        return DPS_SUCCEEDED;
+    default:
+        return DPS_FAILED; //should already be filtered above
+    }
+}
+
+int16_t DPS310_getRawResult(DPS310_t *dev, int32_t *raw, RegBlock_t reg)
 {
     uint8_t buffer[DPS__RESULT_BLOCK_LENGTH] = {0};
-    if (DPS310_readBlock(reg, buffer) != DPS__RESULT_BLOCK_LENGTH)
+    if (DPS310_readBlock(dev, reg, buffer) != DPS__RESULT_BLOCK_LENGTH)
         return DPS_FAILED;
 
     *raw = (uint32_t)buffer[0] << 16 | (uint32_t)buffer[1] << 8 | (uint32_t)buffer[2];
@@ -453,89 +1113,535 @@ int16_t DPS310_getRawResult(int32_t *raw, RegBlock_t reg)
     return DPS_SUCCEEDED;
 }
 
-float DPS310_calcTemp(int32_t raw)
+static inline int32_t DPS310_scaleRawFixed(int32_t raw, uint8_t osr)
+{
+    //raw / kP in Q20, rounded
+    return (int32_t)DPS__ROUND_SHIFT((int64_t)raw * DPS310_scaling_recips[osr], 48 - DPS__SCAL_FRAC_BITS);
+}
+
+float DPS310_calcTemp(DPS310_t *dev, int32_t raw)
 {
     float temp = raw;
 
+    //keep the fixed-point copy in sync, so both pressure paths can follow
+    dev->m_lastTempScalQ = DPS310_scaleRawFixed(raw, dev->m_tempOsr);
+    dev->m_tempAge = 0U;
+    dev->m_tempCheckAge = 0U;
+
     //scale temperature according to scaling table and oversampling
-    temp /= DPS310_scaling_facts[m_tempOsr];
+    temp /= DPS310_scaling_facts[dev->m_tempOsr];
 
     //update last measured temperature
     //it will be used for pressure compensation
-    m_lastTempScal = temp;
+    dev->m_lastTempScal = temp;
 
     //Calculate compensated temperature
-    temp = m_c0Half + m_c1 * temp;
+    temp = dev->m_c0Half + dev->m_c1 * temp;
 
     return temp;
 }
 
-float DPS310_calcPressure(int32_t raw)
+float DPS310_calcPressure(DPS310_t *dev, int32_t raw)
 {
     float prs = raw;
 
     //scale pressure according to scaling table and oversampling
-    prs /= DPS310_scaling_facts[m_prsOsr];
+    prs /= DPS310_scaling_facts[dev->m_prsOsr];
 
     //Calculate compensated pressure
-    prs = m_c00 + prs * (m_c10 + prs * (m_c20 + prs * m_c30)) + m_lastTempScal * (m_c01 + prs * (m_c11 + prs * m_c21));
+    prs = dev->m_c00 + prs * (dev->m_c10 + prs * (dev->m_c20 + prs * dev->m_c30)) + dev->m_lastTempScal * (dev->m_c01 + prs * (dev->m_c11 + prs * dev->m_c21));
 
     //return pressure
     return prs;
 }
 
-int16_t DPS310_measurePressureOnce(float* result)
+int32_t DPS310_calcTempFixed(DPS310_t *dev, int32_t raw)
+{
+    int32_t temp = DPS310_scaleRawFixed(raw, dev->m_tempOsr);
+
+    //update last measured temperature for pressure compensation
+    dev->m_lastTempScalQ = temp;
+    dev->m_lastTempScal = (float)temp / (1L << DPS__SCAL_FRAC_BITS);
+    dev->m_tempAge = 0U;
+    dev->m_tempCheckAge = 0U;
+
+    //c0Half + c1 * temp in Q8
+    return (dev->m_c0Half << DPS__TEMP_FRAC_BITS)
+            + (int32_t)DPS__ROUND_SHIFT((int64_t)dev->m_c1 * temp, DPS__SCAL_FRAC_BITS - DPS__TEMP_FRAC_BITS);
+}
+
+static void DPS310_calcPressureTerms(DPS310_t *dev, DPS310_prsTerms_t *terms)
+{
+    int64_t temp = dev->m_lastTempScalQ;
+
+    //everything that only depends on the temperature, Q12
+    terms->a3 = (int64_t)dev->m_c30 << DPS__ACC_FRAC_BITS;
+    terms->a2 = ((int64_t)dev->m_c20 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(dev->m_c21 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+    terms->a1 = ((int64_t)dev->m_c10 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(dev->m_c11 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+    terms->a0 = ((int64_t)dev->m_c00 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(dev->m_c01 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+}
+
+int32_t DPS310_calcPressureFixed(DPS310_t *dev, int32_t raw)
+{
+    int32_t prs;
+    DPS310_calcPressureBatchFixed(dev, &raw, &prs, 1U);
+    return prs;
+}
+
+void DPS310_calcPressureBatchFixed(DPS310_t *dev, const int32_t *raw, int32_t *result, uint8_t count)
 {
-    return DPS310_measurePressureOnce_oversample(result, m_prsOsr);
+    DPS310_prsTerms_t terms;
+    DPS310_calcPressureTerms(dev, &terms);
+    const int32_t recip = DPS310_scaling_recips[dev->m_prsOsr];
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        int64_t prs = (int64_t)DPS__ROUND_SHIFT((int64_t)raw[i] * recip, 48 - DPS__SCAL_FRAC_BITS);
+
+        //Horner scheme, a0 + prs * (a1 + prs * (a2 + prs * a3))
+        int64_t acc = terms.a3;
+        acc = terms.a2 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+        acc = terms.a1 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+        acc = terms.a0 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+
+        result[i] = (int32_t)DPS__ROUND_SHIFT(acc, DPS__ACC_FRAC_BITS - DPS__PRS_FRAC_BITS);
+    }
 }
 
-int16_t DPS310_measurePressureOnce_oversample(float* result, uint8_t oversamplingRate)
+void DPS310_calcPressureBatch(DPS310_t *dev, const int32_t *raw, float *result, uint8_t count)
 {
+    const float temp = dev->m_lastTempScal;
+    const float scale = 1.0f / DPS310_scaling_facts[dev->m_prsOsr];
+
+    //everything that only depends on the temperature
+    const float a0 = dev->m_c00 + temp * dev->m_c01;
+    const float a1 = dev->m_c10 + temp * dev->m_c11;
+    const float a2 = dev->m_c20 + temp * dev->m_c21;
+    const float a3 = dev->m_c30;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        float prs = raw[i] * scale;
+        result[i] = a0 + prs * (a1 + prs * (a2 + prs * a3));
+    }
+}
+
+int16_t DPS310_measurePressureOnce(DPS310_t *dev, float* result)
+{
+    return DPS310_measurePressureOnce_oversample(dev, result, dev->m_prsOsr);
+}
+
+int16_t DPS310_measurePressureOnce_oversample(DPS310_t *dev, float* result, uint8_t oversamplingRate)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_MEASURE_PRESSURE);
     //start the measurement
-    int16_t ret = DPS310_startMeasurePressureOnce(oversamplingRate);
+    int16_t ret = DPS310_startMeasurePressureOnce(dev, oversamplingRate);
     if (ret != DPS_SUCCEEDED)
     {
         return ret;
     }
 
     //wait until measurement is finished
-    uint16_t busy_time = DPS310_calcBusyTime(0U, m_prsOsr);
+    uint16_t busy_time = DPS310_calcBusyTime(0U, dev->m_prsOsr);
     cyhal_system_delay_ms(busy_time / DPS__BUSYTIME_SCALING);
     cyhal_system_delay_ms(DPS310__BUSYTIME_FAILSAFE);
 
-    ret = DPS310_getSingleResult(result);
+    ret = DPS310_getSingleResult(dev, result);
     if (ret != DPS_SUCCEEDED)
     {
-        DPS310_standby();
+        DPS310_standby(dev);
     }
     return ret;
 }
 
-int16_t DPS310_startMeasurePressureOnce_void(void)
+int16_t DPS310_startMeasurePressureOnce_void(DPS310_t *dev)
 {
-    return DPS310_startMeasurePressureOnce(m_prsOsr);
+    return DPS310_startMeasurePressureOnce(dev, dev->m_prsOsr);
 }
 
-int16_t DPS310_startMeasurePressureOnce(uint8_t oversamplingRate)
+int16_t DPS310_startMeasurePressureOnce(DPS310_t *dev, uint8_t oversamplingRate)
 {
     //abort if initialization failed
-    if (m_initFail)
+    if (dev->m_initFail)
     {
         return DPS_FAILED;
     }
     //abort if device is not in idling mode
-    if (m_opMode != IDLE)
+    if (dev->m_opMode != IDLE)
     {
         return DPS_FAILED;
     }
     //configuration of oversampling rate, lowest measure rate to avoid conflicts
-    if (oversamplingRate != m_prsOsr)
+    if (oversamplingRate != dev->m_prsOsr)
     {
-        if (DPS310_configPressure(0U, oversamplingRate))
+        if (DPS310_setPressureConfig(dev, 0U, oversamplingRate))
         {
             return DPS_FAILED;
         }
     }
-    //set device to pressure measuring mode
-    return DPS310_setOpMode(CMD_PRS);
+    //set device to pressure measuring mode, configuration is written along with it
+    return DPS310_setOpMode(dev, CMD_PRS);
+}
+
+void DPS310_setTempSchedule(DPS310_t *dev, const DPS310_tempSchedule_t *schedule)
+{
+    dev->m_tempSchedule = *schedule;
+    //at least one temperature per refresh interval, an interval of 0 would never measure it
+    if (dev->m_tempSchedule.refreshInterval == 0U)
+    {
+        dev->m_tempSchedule.refreshInterval = 1U;
+    }
+}
+
+static int16_t DPS310_checkTempDrift(DPS310_t *dev)
+{
+    //a short low resolution conversion, the cached value stays unless it is off
+    float cachedScal = dev->m_lastTempScal;
+    int32_t cachedScalQ = dev->m_lastTempScalQ;
+    uint16_t cachedAge = dev->m_tempAge;
+    uint8_t tempMr = dev->m_tempMr;
+    uint8_t tempOsr = dev->m_tempOsr;
+    float cached = dev->m_c0Half + dev->m_c1 * cachedScal;
+    float temp;
+
+    int16_t ret = DPS310_measureTempOnce_oversample(dev, &temp, dev->m_tempSchedule.checkOsr);
+
+    //the check configured its own oversampling rate, the shadow keeps the old one until the next measurement
+    if ((DPS310_setTempConfig(dev, tempMr, tempOsr) != DPS_SUCCEEDED) && (ret == DPS_SUCCEEDED))
+    {
+        ret = DPS_FAILED;
+    }
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+    float drift = temp - cached;
+    if ((drift >= dev->m_tempSchedule.driftThreshold) || (-drift >= dev->m_tempSchedule.driftThreshold))
+    {
+        return 1;
+    }
+
+    dev->m_lastTempScal = cachedScal;
+    dev->m_lastTempScalQ = cachedScalQ;
+    dev->m_tempAge = cachedAge;
+    return 0;
+}
+
+int16_t DPS310_measurePressureScheduled(DPS310_t *dev, DPS310_prsSample_t *sample, uint8_t oversamplingRate)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_MEASURE_SCHEDULED);
+    const DPS310_tempSchedule_t *schedule = &dev->m_tempSchedule;
+    uint8_t source = DPS310_TEMP_CACHED;
+    int16_t ret;
+
+    if (dev->m_tempAge >= schedule->refreshInterval)
+    {
+        source = DPS310_TEMP_SCHEDULED;
+    }
+    else if ((schedule->checkInterval > 0U) && (dev->m_tempCheckAge >= schedule->checkInterval))
+    {
+        ret = DPS310_checkTempDrift(dev);
+        if (ret < 0)
+        {
+            return ret;
+        }
+        source = ret ? DPS310_TEMP_DRIFT : DPS310_TEMP_CACHED;
+    }
+
+    //the drift check only tells, the temperature is measured with full resolution
+    if (source != DPS310_TEMP_CACHED)
+    {
+        float temp;
+        ret = DPS310_measureTempOnce_oversample(dev, &temp, schedule->tempOsr);
+        if (ret != DPS_SUCCEEDED)
+        {
+            return ret;
+        }
+    }
+
+    //compensated with m_lastTempScal, whatever its age
+    ret = DPS310_measurePressureOnce_oversample(dev, &sample->pressure, oversamplingRate);
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+    sample->temperature = dev->m_c0Half + dev->m_c1 * dev->m_lastTempScal;
+    sample->tempAge = dev->m_tempAge;
+    sample->tempSource = source;
+
+    if (dev->m_tempAge < DPS310__TEMP_AGE_UNKNOWN)
+    {
+        dev->m_tempAge++;
+    }
+    if (dev->m_tempCheckAge < DPS310__TEMP_AGE_UNKNOWN)
+    {
+        dev->m_tempCheckAge++;
+    }
+    return DPS_SUCCEEDED;
+}
+
+int16_t DPS310_startMeasureTempAsync(DPS310_t *dev, uint8_t oversamplingRate, DPS310_measureCallback_t callback)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_START_ASYNC);
+    //only one conversion can be in flight at a time
+    if (dev->m_asyncState == DPS310_ASYNC_BUSY)
+    {
+        return DPS_FAILED;
+    }
+    int16_t ret = DPS310_startMeasureTempOnce(dev, oversamplingRate);
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+    dev->m_asyncCallback = callback;
+    dev->m_asyncState = DPS310_ASYNC_BUSY;
+    return DPS_SUCCEEDED;
+}
+
+int16_t DPS310_startMeasurePressureAsync(DPS310_t *dev, uint8_t oversamplingRate, DPS310_measureCallback_t callback)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_START_ASYNC);
+    //only one conversion can be in flight at a time
+    if (dev->m_asyncState == DPS310_ASYNC_BUSY)
+    {
+        return DPS_FAILED;
+    }
+    int16_t ret = DPS310_startMeasurePressureOnce(dev, oversamplingRate);
+    if (ret != DPS_SUCCEEDED)
+    {
+        return ret;
+    }
+    dev->m_asyncCallback = callback;
+    dev->m_asyncState = DPS310_ASYNC_BUSY;
+    return DPS_SUCCEEDED;
+}
+
+uint16_t DPS310_getConversionTime(DPS310_t *dev)
+{
+    //same wait time as the blocking measurement, in milliseconds
+    switch (dev->m_opMode)
+    {
+    case CMD_TEMP:
+        return DPS310_calcBusyTime(0U, dev->m_tempOsr) / DPS__BUSYTIME_SCALING + DPS310__BUSYTIME_FAILSAFE;
+    case CMD_PRS:
+        return DPS310_calcBusyTime(0U, dev->m_prsOsr) / DPS__BUSYTIME_SCALING + DPS310__BUSYTIME_FAILSAFE;
+    default:
+        return 0U;
+    }
+}
+
+int16_t DPS310_pollAsync(DPS310_t *dev, float* result)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_POLL_ASYNC);
+    //nothing to poll if no conversion was started
+    if (dev->m_asyncState != DPS310_ASYNC_BUSY)
+    {
+        return DPS_FAILED;
+    }
+
+    enum Mode mode = dev->m_opMode;
+    int16_t rdy;
+    switch (mode)
+    {
+    case CMD_TEMP: //temperature
+        rdy = DPS310_readByteBitfield(dev, config_registers[TEMP_RDY]);
+        break;
+    case CMD_PRS: //pressure
+        rdy = DPS310_readByteBitfield(dev, config_registers[PRS_RDY]);
+        break;
+    default: //conversion was aborted, e.g. by DPS310_standby(dev)
+        rdy = DPS_FAILED;
+        break;
+    }
+    //conversion still running, one status read per poll
+    if (rdy == 0)
+    {
+        return DPS_BUSY;
+    }
+    return DPS310_finishAsync(dev, mode, rdy, result);
+}
+
+static int16_t DPS310_finishAsync(DPS310_t *dev, enum Mode mode, int16_t rdy, float* result)
+{
+    float value = 0;
+    int16_t ret = DPS_FAILED;
+    if (rdy == 1)
+    {
+        ret = DPS310_readSingleResult(dev, &value);
+    }
+    if (ret != DPS_SUCCEEDED)
+    {
+        DPS310_standby(dev);
+    }
+    if (result != NULL)
+    {
+        *result = value;
+    }
+
+    //clear the state before the callback, so it can start the next conversion
+    dev->m_asyncState = DPS310_ASYNC_IDLE;
+    if (dev->m_asyncCallback != NULL)
+    {
+        dev->m_asyncCallback(dev, mode, ret, value);
+    }
+    return ret;
+}
+
+int16_t DPS310_setInterruptSources(DPS310_t *dev, uint8_t sources, uint8_t polarity)
+{
+    //abort if initialization failed
+    if (dev->m_initFail)
+    {
+        return DPS_FAILED;
+    }
+    //INT shares the SDO pin, which 4-wire SPI needs for data
+    if (!dev->m_SpiI2c && (dev->m_spiMode == DPS310_SPI_4WIRE))
+    {
+        return DPS_FAILED;
+    }
+    //both fields live in CFG_REG, the shadow writes them in one go
+    DPS310_writeByteBitfield_reg(dev, sources, registers[INT_SEL]);
+    DPS310_writeByteBitfield_reg(dev, polarity, registers[INT_HL]);
+    if (DPS310_flushShadow(dev, 0U) != DPS_SUCCEEDED)
+    {
+        return DPS_FAILED;
+    }
+    //drop flags from before, the INT pin follows INT_STS
+    return (DPS310_getIntStatus(dev) < 0) ? DPS_FAILED : DPS_SUCCEEDED;
+}
+
+int16_t DPS310_getIntStatus(DPS310_t *dev)
+{
+    //INT_STS is cleared by reading it, which also releases the INT pin
+    int16_t status = DPS310_readByte(dev, config_registers[INT_FLAG_PRS].regAddress);
+    if (status < 0)
+    {
+        return DPS_FAILED;
+    }
+    //the flags have the same bit positions as enum Interrupt_source_310_e
+    return status & (DPS310_FIFO_FULL_INTR | DPS310_TEMP_INTR | DPS310_PRS_INTR);
+}
+
+int16_t DPS310_handleInterrupt(DPS310_t *dev, float* result)
+{
+    DPS310_TRACE_SCOPE(DPS310_TRACE_HANDLE_INT);
+    int16_t status = DPS310_getIntStatus(dev);
+    if (status < 0)
+    {
+        return DPS_FAILED;
+    }
+
+    //a ready interrupt ends the asynchronous conversion, no need to read the ready bit
+    if (dev->m_asyncState == DPS310_ASYNC_BUSY)
+    {
+        enum Mode mode = dev->m_opMode;
+        if (((mode == CMD_TEMP) && (status & DPS310_TEMP_INTR))
+                || ((mode == CMD_PRS) && (status & DPS310_PRS_INTR)))
+        {
+            if (DPS310_finishAsync(dev, mode, 1, result) != DPS_SUCCEEDED)
+            {
+                return DPS_FAILED;
+            }
+        }
+    }
+    //a FIFO full flag is left to the caller, who drains the FIFO
+    return status;
+}
+
+static int16_t DPS310_measureOnceMulti(DPS310_t *devs[], uint8_t count, enum Mode mode, float *results, int16_t *status)
+{
+    int16_t ret = DPS_SUCCEEDED;
+    uint16_t wait_time = 0U;
+    uint8_t pending = 0U;
+
+    //start the conversion on every sensor first, they all run in parallel
+    for (uint8_t i = 0; i < count; i++)
+    {
+        int16_t start;
+        if (mode == CMD_TEMP)
+        {
+            start = DPS310_startMeasureTempAsync(devs[i], devs[i]->m_tempOsr, NULL);
+        }
+        else
+        {
+            start = DPS310_startMeasurePressureAsync(devs[i], devs[i]->m_prsOsr, NULL);
+        }
+        if (status != NULL)
+        {
+            status[i] = (start == DPS_SUCCEEDED) ? DPS_BUSY : DPS_FAILED;
+        }
+        if (start != DPS_SUCCEEDED)
+        {
+            ret = DPS_FAILED;
+            continue;
+        }
+        pending++;
+        uint16_t time = DPS310_getConversionTime(devs[i]);
+        if (time > wait_time)
+        {
+            wait_time = time;
+        }
+    }
+
+    //wait once for the slowest sensor
+    cyhal_system_delay_ms(wait_time);
+
+    //collect all results, sensors that are not ready yet get another millisecond
+    for (uint8_t retry = 0; (pending > 0U) && (retry <= DPS310__BUSYTIME_FAILSAFE); retry++)
+    {
+        if (retry > 0U)
+        {
+            cyhal_system_delay_ms(1);
+        }
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (devs[i]->m_asyncState != DPS310_ASYNC_BUSY)
+            {
+                continue;
+            }
+            int16_t poll = DPS310_pollAsync(devs[i], &results[i]);
+            if (poll == DPS_BUSY)
+            {
+                continue;
+            }
+            pending--;
+            if (status != NULL)
+            {
+                status[i] = poll;
+            }
+            if (poll != DPS_SUCCEEDED)
+            {
+                ret = DPS_FAILED;
+            }
+        }
+    }
+
+    //give up on sensors that never finished
+    if (pending > 0U)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (devs[i]->m_asyncState == DPS310_ASYNC_BUSY)
+            {
+                DPS310_standby(devs[i]);
+                devs[i]->m_asyncState = DPS310_ASYNC_IDLE;
+                if (status != NULL)
+                {
+                    status[i] = DPS_FAILED;
+                }
+            }
+        }
+        ret = DPS_FAILED;
+    }
+    return ret;
+}
+
+int16_t DPS310_measureTempOnceMulti(DPS310_t *devs[], uint8_t count, float *results, int16_t *status)
+{
+    return DPS310_measureOnceMulti(devs, count, CMD_TEMP, results, status);
+}
+
+int16_t DPS310_measurePressureOnceMulti(DPS310_t *devs[], uint8_t count, float *results, int16_t *status)
+{
+    return DPS310_measureOnceMulti(devs, count, CMD_PRS, results, status);
 }
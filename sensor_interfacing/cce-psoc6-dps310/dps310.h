@@ -11,81 +11,186 @@
 #define DPS310_H_
 
 #include "dps310_config.h"
+#include "dps310_trace.h"
 #include "cy_retarget_io.h"
 
-//flags
-uint8_t m_initFail;
-uint8_t m_productID;
-uint8_t m_revisionID;
-
-//settings
-uint8_t m_tempMr;
-uint8_t m_tempOsr;
-uint8_t m_prsMr;
-uint8_t m_prsOsr;
-
-// compensation coefficients for both dps310 and dps422
-int32_t m_c00;
-int32_t m_c10;
-int32_t m_c01;
-int32_t m_c11;
-int32_t m_c20;
-int32_t m_c21;
-int32_t m_c30;
-
-uint8_t m_tempSensor;
+typedef struct DPS310_s DPS310_t;
+
+// called from DPS310_pollAsync() once an asynchronous measurement has finished
+typedef void (*DPS310_measureCallback_t)(DPS310_t *dev, enum Mode mode, int16_t status, float result);
+
+// calibration data kept across reboots, to be stored in retained RAM, backup registers or flash
+typedef struct
+{
+    uint8_t productID;
+    uint8_t revisionID;
+    uint8_t tempSensor;
+    uint8_t reserved;
+
+    int32_t c0Half;
+    int32_t c1;
+    int32_t c00;
+    int32_t c10;
+    int32_t c01;
+    int32_t c11;
+    int32_t c20;
+    int32_t c21;
+    int32_t c30;
+
+    float lastTempScal;
+    uint32_t checksum;
+} DPS310_calib_t;
+
+// when DPS310_measurePressureScheduled() measures the temperature it compensates with
+typedef struct
+{
+    uint16_t refreshInterval; //pressure samples per temperature measurement, 1 = before every one
+    uint8_t tempOsr;          //oversampling of the scheduled temperature measurement
+    uint16_t checkInterval;   //pressure samples per drift check, 0 = no checks
+    uint8_t checkOsr;         //oversampling of the drift check, keep it low
+    float driftThreshold;     //degree Celsius the check may differ from the cached value
+} DPS310_tempSchedule_t;
+
+// pressure result with the age of its temperature compensation
+typedef struct
+{
+    float pressure;
+    float temperature;        //temperature the pressure was compensated with
+    uint16_t tempAge;         //pressure samples since it was measured, 0 = right before this one
+    uint8_t tempSource;       //DPS310_TEMP_CACHED, DPS310_TEMP_SCHEDULED or DPS310_TEMP_DRIFT
+} DPS310_prsSample_t;
+
+// state of one DPS310, every sensor on any bus gets its own instance
+struct DPS310_s
+{
+    //flags
+    uint8_t m_initFail;
+    uint8_t m_productID;
+    uint8_t m_revisionID;
+
+    //settings
+    uint8_t m_tempMr;
+    uint8_t m_tempOsr;
+    uint8_t m_prsMr;
+    uint8_t m_prsOsr;
+
+    // compensation coefficients for both dps310 and dps422
+    int32_t m_c00;
+    int32_t m_c10;
+    int32_t m_c01;
+    int32_t m_c11;
+    int32_t m_c20;
+    int32_t m_c21;
+    int32_t m_c30;
+
+    uint8_t m_tempSensor;
+
+    //compensation coefficients for dps310
+    int32_t m_c0Half;
+    int32_t m_c1;
+
+    // last measured scaled temperature (necessary for pressure compensation)
+    float m_lastTempScal;
+    int32_t m_lastTempScalQ; //same in Q20 for the fixed-point path
+
+    //temperature refresh of DPS310_measurePressureScheduled()
+    DPS310_tempSchedule_t m_tempSchedule;
+    uint16_t m_tempAge;      //pressure samples since the last temperature measurement
+    uint16_t m_tempCheckAge; //pressure samples since the last drift check
+
+    //bus specific
+    uint8_t m_SpiI2c; //0=SPI, 1=I2C
+    uint8_t m_spiMode; //DPS310_SPI_4WIRE or DPS310_SPI_3WIRE
+
+    cyhal_i2c_t* i2c_ptr;
+    uint8_t m_slaveAddress;
+    cyhal_spi_t* spi_ptr;
+
+    enum Mode m_opMode;
+
+    //RAM copy of the configuration registers, dirty ones are written by DPS310_flushShadow()
+    uint8_t m_shadow[DPS310__SHADOW_NUM_REGS];
+    uint8_t m_shadowDirty;
+    uint8_t m_shadowValid;
+
+    //asynchronous measurement
+    DPS310_measureCallback_t m_asyncCallback;
+    enum DPS310_AsyncState_e m_asyncState;
+};
+
+void DPS310_init(DPS310_t *dev, cyhal_i2c_t* i2c_inst, uint8_t slaveAddress);
+int16_t DPS310_initWarm(DPS310_t *dev, cyhal_i2c_t* i2c_inst, uint8_t slaveAddress, const DPS310_calib_t *calib);
+void DPS310_initSPI(DPS310_t *dev, cyhal_spi_t* spi_inst, uint8_t spiMode);
+int16_t DPS310_initWarmSPI(DPS310_t *dev, cyhal_spi_t* spi_inst, uint8_t spiMode, const DPS310_calib_t *calib);
+void DPS310_getCalib(DPS310_t *dev, DPS310_calib_t *calib);
+int16_t DPS310_standby(DPS310_t *dev);
+
+int16_t DPS310_setOpMode(DPS310_t *dev, uint8_t opMode);
+int16_t DPS310_configTemp(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr);
+int16_t DPS310_configPressure(DPS310_t *dev, uint8_t prsMr, uint8_t prsOsr);
+uint16_t DPS310_calcBusyTime(uint16_t mr, uint16_t osr);
+void DPS310_getTwosComplement(int32_t *raw, uint8_t length);
 
-//compensation coefficients for dps310
-int32_t m_c0Half;
-int32_t m_c1;
+int16_t DPS310_correctTemp(DPS310_t *dev);
 
-// last measured scaled temperature (necessary for pressure compensation)
-float m_lastTempScal;
+float DPS310_calcTemp(DPS310_t *dev, int32_t raw);
+float DPS310_calcPressure(DPS310_t *dev, int32_t raw);
+void DPS310_calcPressureBatch(DPS310_t *dev, const int32_t *raw, float *result, uint8_t count);
 
-//bus specific
-uint8_t m_SpiI2c; //0=SPI, 1=I2C
+int32_t DPS310_calcTempFixed(DPS310_t *dev, int32_t raw);
+int32_t DPS310_calcPressureFixed(DPS310_t *dev, int32_t raw);
+void DPS310_calcPressureBatchFixed(DPS310_t *dev, const int32_t *raw, int32_t *result, uint8_t count);
 
-cyhal_i2c_t* i2c_ptr;
+int16_t DPS310_getSingleResult(DPS310_t *dev, float* result);
+int16_t DPS310_readSingleResult(DPS310_t *dev, float* result);
+int16_t DPS310_getRawResult(DPS310_t *dev, int32_t *raw, RegBlock_t reg);
 
-enum Mode m_opMode;
+int16_t DPS310_measureTempOnce(DPS310_t *dev, float* result);
+int16_t DPS310_measureTempOnce_oversample(DPS310_t *dev, float* result, uint8_t oversamplingRate);
+int16_t DPS310_startMeasureTempOnce_void(DPS310_t *dev);
+int16_t DPS310_startMeasureTempOnce(DPS310_t *dev, uint8_t oversamplingRate);
 
-void DPS310_init(cyhal_i2c_t* i2c_inst);
-int16_t DPS310_standby(void);
+int16_t DPS310_measurePressureOnce(DPS310_t *dev, float* result);
+int16_t DPS310_measurePressureOnce_oversample(DPS310_t *dev, float* result, uint8_t oversamplingRate);
+int16_t DPS310_startMeasurePressureOnce_void(DPS310_t *dev);
+int16_t DPS310_startMeasurePressureOnce(DPS310_t *dev, uint8_t oversamplingRate);
 
-int16_t DPS310_setOpMode(uint8_t opMode);
-int16_t DPS310_configTemp(uint8_t tempMr, uint8_t tempOsr);
-int16_t DPS310_configPressure(uint8_t prsMr, uint8_t prsOsr);
-uint16_t DPS310_calcBusyTime(uint16_t mr, uint16_t osr);
-void DPS310_getTwosComplement(int32_t *raw, uint8_t length);
+int16_t DPS310_startMeasureTempAsync(DPS310_t *dev, uint8_t oversamplingRate, DPS310_measureCallback_t callback);
+int16_t DPS310_startMeasurePressureAsync(DPS310_t *dev, uint8_t oversamplingRate, DPS310_measureCallback_t callback);
+uint16_t DPS310_getConversionTime(DPS310_t *dev);
+int16_t DPS310_pollAsync(DPS310_t *dev, float* result);
 
-int16_t DPS310_correctTemp(void);
+int16_t DPS310_setInterruptSources(DPS310_t *dev, uint8_t sources, uint8_t polarity);
+int16_t DPS310_getIntStatus(DPS310_t *dev);
+int16_t DPS310_handleInterrupt(DPS310_t *dev, float* result);
 
-float DPS310_calcTemp(int32_t raw);
-float DPS310_calcPressure(int32_t raw);
+void DPS310_setTempSchedule(DPS310_t *dev, const DPS310_tempSchedule_t *schedule);
+int16_t DPS310_measurePressureScheduled(DPS310_t *dev, DPS310_prsSample_t *sample, uint8_t oversamplingRate);
 
-int16_t DPS310_getSingleResult(float* result);
-int16_t DPS310_getRawResult(int32_t *raw, RegBlock_t reg);
+int16_t DPS310_measureTempOnceMulti(DPS310_t *devs[], uint8_t count, float *results, int16_t *status);
+int16_t DPS310_measurePressureOnceMulti(DPS310_t *devs[], uint8_t count, float *results, int16_t *status);
 
-int16_t DPS310_measureTempOnce(float* result);
-int16_t DPS310_measureTempOnce_oversample(float* result, uint8_t oversamplingRate);
-int16_t DPS310_startMeasureTempOnce_void(void);
-int16_t DPS310_startMeasureTempOnce(uint8_t oversamplingRate);
+int16_t DPS310_startMeasureTempCont(DPS310_t *dev, uint8_t measureRate, uint8_t oversamplingRate);
+int16_t DPS310_startMeasurePressureCont(DPS310_t *dev, uint8_t measureRate, uint8_t oversamplingRate);
+int16_t DPS310_startMeasureBothCont(DPS310_t *dev, uint8_t tempMr, uint8_t tempOsr, uint8_t prsMr, uint8_t prsOsr);
+int16_t DPS310_getContResults(DPS310_t *dev, float *tempBuffer, uint8_t *tempCount, float *prsBuffer, uint8_t *prsCount);
+int16_t DPS310_getContResultsFixed(DPS310_t *dev, int32_t *tempBuffer, uint8_t *tempCount, int32_t *prsBuffer, uint8_t *prsCount);
 
-int16_t DPS310_measurePressureOnce(float* result);
-int16_t DPS310_measurePressureOnce_oversample(float* result, uint8_t oversamplingRate);
-int16_t DPS310_startMeasurePressureOnce_void(void);
-int16_t DPS310_startMeasurePressureOnce(uint8_t oversamplingRate);
+int16_t DPS310_enableFIFO(DPS310_t *dev);
+int16_t DPS310_disableFIFO(DPS310_t *dev);
+int16_t DPS310_flushFIFO(DPS310_t *dev);
+int16_t DPS310_readFIFO(DPS310_t *dev, int32_t *rawBuffer, uint8_t maxCount);
 
-int16_t DPS310_disableFIFO();
-int16_t DPS310_flushFIFO();
+int16_t DPS310_readByte(DPS310_t *dev, uint8_t regAddress);
+int16_t DPS310_readByteBitfield(DPS310_t *dev, RegMask_t regMask);
+int16_t DPS310_readBlock(DPS310_t *dev, RegBlock_t regBlock, uint8_t *buffer);
+int16_t DPS310_readcoeffs(DPS310_t *dev);
 
-int16_t DPS310_readByte(uint8_t regAddress);
-int16_t DPS310_readByteBitfield(RegMask_t regMask);
-int16_t DPS310_readBlock(RegBlock_t regBlock, uint8_t *buffer);
-int16_t DPS310_readcoeffs(void);
+int16_t DPS310_loadShadow(DPS310_t *dev);
+int16_t DPS310_flushShadow(DPS310_t *dev, uint8_t check);
 
-int16_t DPS310_writeByte(uint8_t regAddress, uint8_t data, uint8_t check);
-int16_t DPS310_writeByteBitfield_reg(uint8_t data, RegMask_t regMask);
-int16_t DPS310_writeByteBitfield(uint8_t data, uint8_t regAddress, uint8_t mask, uint8_t shift, uint8_t check);
+int16_t DPS310_writeByte(DPS310_t *dev, uint8_t regAddress, uint8_t data, uint8_t check);
+int16_t DPS310_writeByteBitfield_reg(DPS310_t *dev, uint8_t data, RegMask_t regMask);
+int16_t DPS310_writeByteBitfield(DPS310_t *dev, uint8_t data, uint8_t regAddress, uint8_t mask, uint8_t shift, uint8_t check);
 
 #endif /* DPS310_H_ */
@@ -16,11 +16,13 @@
 
 #define DPS_SUCCEEDED 0
 #define DPS_FAILED -1
+#define DPS_BUSY 1
 
 #define DPS310_NUM_OF_REGMASKS 16
 
 /* The sensor's address is 0x77 (default) or 0x76 (if the SDO pin is pulled-down to GND) */
 #define DPS310_I2C_SLAVE_ADDRESS 0x77U
+#define DPS310_I2C_SLAVE_ADDRESS_ALT 0x76U
 
 #define NUM_OF_COMMON_REGMASKS 16
 
@@ -28,7 +30,15 @@
 #define DPS310__SPI_WRITE_CMD 0x00U
 #define DPS310__SPI_READ_CMD 0x80U
 #define DPS310__SPI_RW_MASK 0x80U
-#define DPS310__SPI_MAX_FREQ 1000000U
+#define DPS310__SPI_MAX_FREQ 10000000U
+// longest block the driver reads, the coefficients
+#define DPS310__SPI_MAX_BLOCK_LENGTH 18U
+// sent while the sensor answers a read
+#define DPS310__SPI_FILL 0xFFU
+
+// SPI wiring, 3-wire shares SDI and SDO on one data line
+#define DPS310_SPI_4WIRE 0U
+#define DPS310_SPI_3WIRE 1U
 
 #define DPS310__OSR_SE 3U
 
@@ -38,6 +48,22 @@
 #define DPS310__BUSYTIME_FAILSAFE 10U
 #define DPS310__MAX_BUSYTIME ((1000U - DPS310__BUSYTIME_FAILSAFE) * DPS__BUSYTIME_SCALING)
 
+// value of the result registers when the FIFO has been drained completely
+#define DPS310__FIFO_EMPTY_VALUE 0x800000
+
+// PRS_CFG, TMP_CFG, MEAS_CFG and CFG_REG are mirrored in RAM
+#define DPS310__SHADOW_FIRST_REG 0x06U
+#define DPS310__SHADOW_NUM_REGS 4U
+#define DPS310__REG_ADR_MEAS_CFG 0x08U
+// COEF_RDY and SENSOR_RDY of MEAS_CFG, both set once the sensor finished its start-up
+#define DPS310__MEAS_CFG_READY 0xC0U
+
+// return values of DPS310_initWarm()
+#define DPS310_COLD_START 0
+#define DPS310_WARM_START 1
+// marks a valid DPS310_calib_t, mixed into its checksum
+#define DPS310__CALIB_MAGIC 0xD3100CA1UL
+
 #define DPS310__REG_ADR_SPI3W 0x09U
 #define DPS310__REG_CONTENT_SPI3W 0x01U
 
@@ -70,6 +96,16 @@
 
 #define DPS__NUM_OF_SCAL_FACTS 8
 
+// fixed-point compensation: scaled raw values in Q20, intermediate sums in Q12,
+// results in Q8 (1/256 Pa and 1/256 degree Celsius)
+#define DPS__SCAL_FRAC_BITS 20
+#define DPS__ACC_FRAC_BITS 12
+#define DPS__PRS_FRAC_BITS 8
+#define DPS__TEMP_FRAC_BITS 8
+
+// arithmetic shift right with rounding to nearest
+#define DPS__ROUND_SHIFT(value, bits) (((value) + ((int64_t)1 << ((bits) - 1))) >> (bits))
+
 typedef struct
 {
     uint8_t regAddress;
@@ -92,6 +128,17 @@ enum Interrupt_source_310_e
     DPS310_FIFO_FULL_INTR = 4,
 };
 
+// tempSource of DPS310_prsSample_t
+#define DPS310_TEMP_CACHED 0U
+#define DPS310_TEMP_SCHEDULED 1U
+#define DPS310_TEMP_DRIFT 2U
+// tempAge before the first temperature measurement, e.g. after a warm start
+#define DPS310__TEMP_AGE_UNKNOWN 0xFFFFU
+
+// level of the INT pin while an interrupt is pending
+#define DPS310_INT_ACTIVE_LOW 0U
+#define DPS310_INT_ACTIVE_HIGH 1U
+
 enum Mode
 {
     IDLE = 0x00,
@@ -103,6 +150,12 @@ enum Mode
     CONT_BOTH = 0x07
 };
 
+enum DPS310_AsyncState_e
+{
+    DPS310_ASYNC_IDLE = 0,
+    DPS310_ASYNC_BUSY,
+};
+
 enum Registers_e
 {
     PROD_ID = 0,
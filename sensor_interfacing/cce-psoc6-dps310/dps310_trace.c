@@ -0,0 +1,195 @@
+/******************************************************************************
+* File Name: dps310_trace.c
+*
+* Description: Optional bus transaction and latency instrumentation of the
+*              DPS310 driver. Empty unless DPS310_TRACE is set.
+*
+*******************************************************************************/
+
+#include "dps310_trace.h"
+
+#if DPS310_TRACE
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *const DPS310_traceScopeNames[DPS310_TRACE_NUM_SCOPES] = {
+    "init",
+    "initWarm",
+    "configTemp",
+    "configPressure",
+    "measureTempOnce",
+    "measurePressureOnce",
+    "measurePressureScheduled",
+    "startMeasureAsync",
+    "pollAsync",
+    "handleInterrupt",
+    "startMeasureCont",
+    "getContResults",
+    "standby",
+};
+
+static const char *const DPS310_traceBusNames[DPS310_TRACE_NUM_BUS] = {
+    "read",
+    "write",
+};
+
+static DPS310_traceStats_t DPS310_traceScopes[DPS310_TRACE_NUM_SCOPES];
+static DPS310_traceStats_t DPS310_traceBusStats[DPS310_TRACE_NUM_BUS];
+static DPS310_traceEntry_t DPS310_traceLog[DPS310_TRACE_LOG_SIZE];
+static uint32_t DPS310_traceLogNext;
+
+//outermost open API call
+static uint8_t DPS310_traceDepth;
+static uint8_t DPS310_traceScope = DPS310_TRACE_NO_SCOPE;
+static uint32_t DPS310_traceScopeStart;
+static uint32_t DPS310_traceScopeTransactions;
+static uint32_t DPS310_traceScopeBytes;
+
+static void DPS310_traceAddLatency(DPS310_traceLatency_t *latency, uint32_t cycles)
+{
+    uint8_t bucket = 0U;
+    for (uint32_t v = cycles >> DPS310_TRACE_HIST_SHIFT; v != 0U; v >>= 1)
+    {
+        bucket++;
+    }
+    if (bucket >= DPS310_TRACE_HIST_BUCKETS)
+    {
+        bucket = DPS310_TRACE_HIST_BUCKETS - 1U;
+    }
+
+    if ((latency->count == 0U) || (cycles < latency->min))
+    {
+        latency->min = cycles;
+    }
+    if (cycles > latency->max)
+    {
+        latency->max = cycles;
+    }
+    latency->count++;
+    latency->sum += cycles;
+    latency->hist[bucket]++;
+}
+
+void DPS310_traceInit(void)
+{
+    //the DWT cycle counter only runs with trace enabled
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    DPS310_traceReset();
+}
+
+void DPS310_traceReset(void)
+{
+    memset(DPS310_traceScopes, 0, sizeof(DPS310_traceScopes));
+    memset(DPS310_traceBusStats, 0, sizeof(DPS310_traceBusStats));
+    memset(DPS310_traceLog, 0, sizeof(DPS310_traceLog));
+    DPS310_traceLogNext = 0U;
+}
+
+uint8_t DPS310_traceBegin(uint8_t scope)
+{
+    if (DPS310_traceDepth++ == 0U)
+    {
+        DPS310_traceScope = scope;
+        DPS310_traceScopeStart = DWT->CYCCNT;
+        DPS310_traceScopeTransactions = 0U;
+        DPS310_traceScopeBytes = 0U;
+    }
+    return scope;
+}
+
+void DPS310_traceEnd(uint8_t *scope)
+{
+    (void)scope;
+    if (--DPS310_traceDepth != 0U)
+    {
+        return;
+    }
+
+    //the cycle counter wraps, unsigned subtraction still gives the duration
+    DPS310_traceStats_t *stats = &DPS310_traceScopes[DPS310_traceScope];
+    stats->transactions += DPS310_traceScopeTransactions;
+    stats->bytes += DPS310_traceScopeBytes;
+    DPS310_traceAddLatency(&stats->latency, DWT->CYCCNT - DPS310_traceScopeStart);
+    DPS310_traceScope = DPS310_TRACE_NO_SCOPE;
+}
+
+void DPS310_traceBus(uint8_t kind, uint8_t regAddress, uint8_t length, uint32_t start)
+{
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    DPS310_traceStats_t *stats = &DPS310_traceBusStats[kind];
+    stats->transactions++;
+    stats->bytes += length;
+    DPS310_traceAddLatency(&stats->latency, cycles);
+
+    DPS310_traceScopeTransactions++;
+    DPS310_traceScopeBytes += length;
+
+    DPS310_traceEntry_t *entry = &DPS310_traceLog[DPS310_traceLogNext++ % DPS310_TRACE_LOG_SIZE];
+    entry->start = start;
+    entry->cycles = cycles;
+    entry->kind = kind;
+    entry->regAddress = regAddress;
+    entry->length = length;
+    entry->scope = DPS310_traceScope;
+}
+
+static void DPS310_traceDumpStats(const char *name, const DPS310_traceStats_t *stats, uint32_t cyclesPerUs)
+{
+    const DPS310_traceLatency_t *latency = &stats->latency;
+    if (latency->count == 0U)
+    {
+        return;
+    }
+
+    printf("%-25s %6lu %7lu %7lu %9lu %9lu %9lu  ", name, (unsigned long)latency->count,
+           (unsigned long)stats->transactions, (unsigned long)stats->bytes,
+           (unsigned long)(latency->min / cyclesPerUs),
+           (unsigned long)(latency->sum / latency->count / cyclesPerUs),
+           (unsigned long)(latency->max / cyclesPerUs));
+    for (uint8_t i = 0; i < DPS310_TRACE_HIST_BUCKETS; i++)
+    {
+        printf(" %lu", (unsigned long)latency->hist[i]);
+    }
+    printf("\r\n");
+}
+
+void DPS310_traceDump(void)
+{
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000U;
+    if (cyclesPerUs == 0U)
+    {
+        cyclesPerUs = 1U;
+    }
+
+    printf("\r\nDPS310 bus trace, %lu cycles per us\r\n", (unsigned long)cyclesPerUs);
+    printf("histogram: bucket 0 below %u cycles, bucket n from %u << (n - 1) cycles\r\n",
+           1U << DPS310_TRACE_HIST_SHIFT, 1U << DPS310_TRACE_HIST_SHIFT);
+    printf("%-25s %6s %7s %7s %9s %9s %9s   %s\r\n", "call", "count", "trans", "bytes", "min us", "avg us", "max us",
+           "histogram");
+    for (uint8_t i = 0; i < DPS310_TRACE_NUM_SCOPES; i++)
+    {
+        DPS310_traceDumpStats(DPS310_traceScopeNames[i], &DPS310_traceScopes[i], cyclesPerUs);
+    }
+    for (uint8_t i = 0; i < DPS310_TRACE_NUM_BUS; i++)
+    {
+        DPS310_traceDumpStats(DPS310_traceBusNames[i], &DPS310_traceBusStats[i], cyclesPerUs);
+    }
+
+    //oldest first
+    printf("last transactions: start cycle, call, kind, register, bytes, us\r\n");
+    uint32_t first = (DPS310_traceLogNext > DPS310_TRACE_LOG_SIZE) ? DPS310_traceLogNext - DPS310_TRACE_LOG_SIZE : 0U;
+    for (uint32_t n = first; n < DPS310_traceLogNext; n++)
+    {
+        const DPS310_traceEntry_t *entry = &DPS310_traceLog[n % DPS310_TRACE_LOG_SIZE];
+        printf("%10lu %-25s %-5s 0x%02X %3u %6lu\r\n", (unsigned long)entry->start,
+               (entry->scope < DPS310_TRACE_NUM_SCOPES) ? DPS310_traceScopeNames[entry->scope] : "-",
+               DPS310_traceBusNames[entry->kind], entry->regAddress, entry->length,
+               (unsigned long)(entry->cycles / cyclesPerUs));
+    }
+}
+
+#endif /* DPS310_TRACE */
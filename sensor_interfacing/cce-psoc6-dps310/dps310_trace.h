@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name: dps310_trace.h
+*
+* Description: Optional bus transaction and latency instrumentation of the
+*              DPS310 driver. Without DPS310_TRACE all macros expand to
+*              nothing.
+*
+*******************************************************************************/
+
+#ifndef DPS310_TRACE_H_
+#define DPS310_TRACE_H_
+
+#include "cy_pdl.h"
+
+// set to 1, e.g. with DEFINES+=DPS310_TRACE=1 in the Makefile, to record every bus transaction
+#ifndef DPS310_TRACE
+#define DPS310_TRACE 0
+#endif
+
+#if DPS310_TRACE
+
+#define DPS310_TRACE_HIST_BUCKETS 16U
+#define DPS310_TRACE_HIST_SHIFT 9U      //bucket 0 is below 512 cycles, every further bucket doubles
+#define DPS310_TRACE_LOG_SIZE 16U       //last transactions kept for the dump
+#define DPS310_TRACE_NO_SCOPE 0xFFU
+
+// public API calls the transactions are charged to, nested calls count for the outermost
+enum DPS310_traceScope_e
+{
+    DPS310_TRACE_INIT = 0,
+    DPS310_TRACE_INIT_WARM,
+    DPS310_TRACE_CONFIG_TEMP,
+    DPS310_TRACE_CONFIG_PRESSURE,
+    DPS310_TRACE_MEASURE_TEMP,
+    DPS310_TRACE_MEASURE_PRESSURE,
+    DPS310_TRACE_MEASURE_SCHEDULED,
+    DPS310_TRACE_START_ASYNC,
+    DPS310_TRACE_POLL_ASYNC,
+    DPS310_TRACE_HANDLE_INT,
+    DPS310_TRACE_START_CONT,
+    DPS310_TRACE_GET_CONT,
+    DPS310_TRACE_STANDBY,
+    DPS310_TRACE_NUM_SCOPES
+};
+
+enum DPS310_traceBus_e
+{
+    DPS310_TRACE_READ = 0,
+    DPS310_TRACE_WRITE,
+    DPS310_TRACE_NUM_BUS
+};
+
+// latency in CPU cycles
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[DPS310_TRACE_HIST_BUCKETS];
+} DPS310_traceLatency_t;
+
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t bytes;
+    DPS310_traceLatency_t latency;
+} DPS310_traceStats_t;
+
+typedef struct
+{
+    uint32_t start;         //cycle counter when the transaction started
+    uint32_t cycles;
+    uint8_t kind;           //DPS310_TRACE_READ or DPS310_TRACE_WRITE
+    uint8_t regAddress;
+    uint8_t length;         //payload bytes
+    uint8_t scope;          //outermost API call, DPS310_TRACE_NO_SCOPE outside of one
+} DPS310_traceEntry_t;
+
+void DPS310_traceInit(void);
+void DPS310_traceReset(void);
+void DPS310_traceDump(void);
+
+uint8_t DPS310_traceBegin(uint8_t scope);
+void DPS310_traceEnd(uint8_t *scope);
+void DPS310_traceBus(uint8_t kind, uint8_t regAddress, uint8_t length, uint32_t start);
+
+// charges every transaction until the enclosing function returns to the scope, needs GCC or Arm Compiler 6
+#define DPS310_TRACE_SCOPE(scope) \
+    uint8_t dps310TraceScope __attribute__((cleanup(DPS310_traceEnd), unused)) = DPS310_traceBegin(scope)
+#define DPS310_TRACE_BUS_START() uint32_t dps310TraceStart = DWT->CYCCNT
+#define DPS310_TRACE_BUS_END(kind, regAddress, length) DPS310_traceBus((kind), (regAddress), (length), dps310TraceStart)
+
+#else
+
+#define DPS310_TRACE_SCOPE(scope)
+#define DPS310_TRACE_BUS_START()
+#define DPS310_TRACE_BUS_END(kind, regAddress, length)
+
+#endif /* DPS310_TRACE */
+
+#endif /* DPS310_TRACE_H_ */
@@ -0,0 +1,241 @@
+/******************************************************************************
+* File Name: bench_altitude.c
+*
+* Description: Host benchmark of the altitude estimator. Checks the pressure
+*              to altitude table against the formula, tracks a simulated lift
+*              ride from noisy 128 Hz pressure batches and compares the cost
+*              per FIFO batch with the CM4 cycle budget.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "altitude.h"
+#include "dps310.h"
+
+#define BENCH_RATE          128U
+#define BENCH_BATCH         DPS__FIFO_SIZE
+#define BENCH_NOISE_PA      1.0
+#define BENCH_ROUNDS        200000
+
+/* PSoC 6 CM4 clock, and the share of it the estimator may take */
+#define BENCH_CM4_HZ        100000000.0
+#define BENCH_CPU_SHARE     0.01
+
+/* Lift ride: rest, accelerate at 1 m/s^2 to 2 m/s, climb, brake, rest */
+#define RIDE_REST_S         5.0
+#define RIDE_ACCEL          1.0
+#define RIDE_SPEED          2.0
+#define RIDE_CLIMB_S        20.0
+#define RIDE_SETTLE_S       1.0
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double formula_altitude(double pressure)
+{
+    return 44330.77 * (1.0 - pow(pressure / 101325.0, 0.190263));
+}
+
+static double formula_pressure(double altitude)
+{
+    return 101325.0 * pow(1.0 - altitude / 44330.77, 1.0 / 0.190263);
+}
+
+/* Normal distributed noise, Box-Muller */
+static double noise(double sigma)
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static void ride(double t, double *altitude, double *speed)
+{
+    const double ramp = RIDE_SPEED / RIDE_ACCEL;
+    const double t1 = RIDE_REST_S;
+    const double t2 = t1 + ramp;
+    const double t3 = t2 + RIDE_CLIMB_S;
+    const double t4 = t3 + ramp;
+    const double h2 = 0.5 * RIDE_ACCEL * ramp * ramp;
+    const double h3 = h2 + RIDE_SPEED * RIDE_CLIMB_S;
+
+    if (t < t1)
+    {
+        *speed = 0.0;
+        *altitude = 0.0;
+    }
+    else if (t < t2)
+    {
+        *speed = RIDE_ACCEL * (t - t1);
+        *altitude = 0.5 * RIDE_ACCEL * (t - t1) * (t - t1);
+    }
+    else if (t < t3)
+    {
+        *speed = RIDE_SPEED;
+        *altitude = h2 + RIDE_SPEED * (t - t2);
+    }
+    else if (t < t4)
+    {
+        *speed = RIDE_SPEED - RIDE_ACCEL * (t - t3);
+        *altitude = h3 + RIDE_SPEED * (t - t3) - 0.5 * RIDE_ACCEL * (t - t3) * (t - t3);
+    }
+    else
+    {
+        *speed = 0.0;
+        *altitude = h3 + h2;
+    }
+}
+
+static void run_table(void)
+{
+    double max_err = 0.0;
+    double max_at = 0.0;
+
+    for (int32_t p = ALT__TABLE_FIRST_PRS << 8; p <= 110000L << 8; p += 64)
+    {
+        double err = fabs(ALT_pressureToAltitude(p) / 1000.0 - formula_altitude(p / 256.0));
+        if (err > max_err)
+        {
+            max_err = err;
+            max_at = p / 256.0;
+        }
+    }
+    printf("Table against the formula, 30 kPa to 110 kPa in 0.25 Pa steps\n");
+    printf("  max error     %.4f m at %.0f Pa, %u entries, %u bytes\n\n", max_err, max_at,
+           ALT__TABLE_SIZE, (unsigned)(ALT__TABLE_SIZE * sizeof(int32_t)));
+}
+
+static void run_ride(void)
+{
+    const double ground = 300.0;
+    const double duration = 2.0 * RIDE_REST_S + 2.0 * RIDE_SPEED / RIDE_ACCEL + RIDE_CLIMB_S;
+    const uint32_t samples = (uint32_t)(duration * BENCH_RATE);
+    ALT_estimator_t est;
+    int32_t batch[BENCH_BATCH];
+    double sum_sq_alt = 0.0;
+    double sum_sq_speed = 0.0;
+    double max_alt = 0.0;
+    double max_speed = 0.0;
+    double max_rest_speed = 0.0;
+    uint32_t count = 0U;
+
+    srand(1);
+    ALT_init(&est, BENCH_RATE, ALT_DEFAULT_ALPHA, ALT_DEFAULT_BETA);
+    ALT_setReference(&est, (int32_t)lround(formula_pressure(ground) * 256.0));
+
+    for (uint32_t n = 0; n < samples; n += BENCH_BATCH)
+    {
+        uint8_t fill = (samples - n < BENCH_BATCH) ? (uint8_t)(samples - n) : BENCH_BATCH;
+        for (uint8_t k = 0; k < fill; k++)
+        {
+            double altitude;
+            double speed;
+            ride((double)(n + k) / BENCH_RATE, &altitude, &speed);
+            batch[k] = (int32_t)lround((formula_pressure(ground + altitude) + noise(BENCH_NOISE_PA)) * 256.0);
+        }
+
+        /* One FIFO batch per call, compare after each batch as the application would */
+        ALT_update(&est, batch, fill);
+
+        double t = (double)(n + fill - 1U) / BENCH_RATE;
+        double altitude;
+        double speed;
+        ride(t, &altitude, &speed);
+        if (t < RIDE_SETTLE_S)
+        {
+            continue;
+        }
+        double err_alt = fabs(ALT_getAltitude(&est) / 1000.0 - altitude);
+        double err_speed = fabs(ALT_getVerticalSpeed(&est) / 1000.0 - speed);
+        sum_sq_alt += err_alt * err_alt;
+        sum_sq_speed += err_speed * err_speed;
+        max_alt = fmax(max_alt, err_alt);
+        max_speed = fmax(max_speed, err_speed);
+        if ((speed == 0.0) && (t > RIDE_SETTLE_S + RIDE_REST_S / 2.0))
+        {
+            max_rest_speed = fmax(max_rest_speed, err_speed);
+        }
+        count++;
+    }
+
+    printf("Lift ride at %u Hz, %.1f Pa noise, %.0f m up at %.1f m/s, batches of %u\n",
+           BENCH_RATE, BENCH_NOISE_PA, RIDE_SPEED * (RIDE_CLIMB_S + RIDE_SPEED / RIDE_ACCEL), RIDE_SPEED, BENCH_BATCH);
+    printf("  altitude      rms %.3f m, max %.3f m\n", sqrt(sum_sq_alt / count), max_alt);
+    printf("  speed         rms %.3f m/s, max %.3f m/s, max %.3f m/s at rest\n\n",
+           sqrt(sum_sq_speed / count), max_speed, max_rest_speed);
+}
+
+static void run_throughput(void)
+{
+    DPS310_t dev = {0};
+    ALT_estimator_t est;
+    int32_t raw[BENCH_BATCH];
+    int32_t prs[BENCH_BATCH];
+    volatile int32_t sink = 0;
+    const double samples = (double)BENCH_ROUNDS * BENCH_BATCH;
+
+    /* Typical coefficients, see bench_compensation.c */
+    dev.m_c0Half = 104;
+    dev.m_c1 = -258;
+    dev.m_c00 = 78342;
+    dev.m_c10 = -52314;
+    dev.m_c01 = -2546;
+    dev.m_c11 = 1301;
+    dev.m_c20 = -9281;
+    dev.m_c21 = 103;
+    dev.m_c30 = -1004;
+    dev.m_tempOsr = DPS__OVERSAMPLING_RATE_2;
+    dev.m_prsOsr = DPS__OVERSAMPLING_RATE_2;
+    DPS310_calcTempFixed(&dev, 230000);
+    for (int k = 0; k < BENCH_BATCH; k++)
+    {
+        raw[k] = -300000 + 37 * k;
+    }
+    DPS310_calcPressureBatchFixed(&dev, raw, prs, BENCH_BATCH);
+    ALT_init(&est, BENCH_RATE, ALT_DEFAULT_ALPHA, ALT_DEFAULT_BETA);
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        ALT_update(&est, prs, BENCH_BATCH);
+        sink += est.velocity;
+    }
+    double t_alt = (now_ns() - start) / samples;
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        DPS310_calcPressureBatchFixed(&dev, raw, prs, BENCH_BATCH);
+        ALT_update(&est, prs, BENCH_BATCH);
+        sink += est.velocity;
+    }
+    double t_both = (now_ns() - start) / samples;
+
+    /* Time per sample the CM4 may spend, and how much slower than this host it may be */
+    double budget_cycles = BENCH_CM4_HZ * BENCH_CPU_SHARE / BENCH_RATE;
+    double budget_ns = budget_cycles / BENCH_CM4_HZ * 1e9;
+
+    printf("Throughput on this host, batches of %d samples\n", BENCH_BATCH);
+    printf("  %-40s %8.2f ns/sample\n", "ALT_update", t_alt);
+    printf("  %-40s %8.2f ns/sample\n", "DPS310_calcPressureBatchFixed + ALT_update", t_both);
+    printf("\nCM4 at %.0f MHz, %.0f %% of it for %u Hz: %.0f cycles (%.1f us) per sample.\n",
+           BENCH_CM4_HZ / 1e6, BENCH_CPU_SHARE * 100.0, BENCH_RATE, budget_cycles, budget_ns / 1000.0);
+    printf("Compensation and estimator fit as long as the CM4 is less than %.0f times\n"
+           "slower per sample than this host.\n", budget_ns / t_both);
+}
+
+int main(void)
+{
+    run_table();
+    run_ride();
+    run_throughput();
+    return 0;
+}
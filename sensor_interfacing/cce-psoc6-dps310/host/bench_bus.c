@@ -0,0 +1,367 @@
+/******************************************************************************
+* File Name: bench_bus.c
+*
+* Description: Runs the DPS310 driver against the register model in
+*              dps310_sim.c and reports the cold and warm initialization
+*              time, the bus cost per sample of every measurement mode with
+*              polling and with the INT pin, the scheduled temperature refresh, the FIFO drain over I2C and SPI
+*              and the compensation throughput of the drained FIFO data.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "dps310.h"
+#include "dps310_sim.h"
+
+#define BENCH_BUS_HZ            1000000U
+#define BENCH_SPI_HZ            DPS310__SPI_MAX_FREQ
+#define BENCH_SPI_BUS_ID        1U
+#define BENCH_SAMPLES           16U
+#define BENCH_DRAINS            10U
+#define BENCH_DRAIN_INTERVAL_MS 900U
+#define BENCH_ROUNDS            200000U
+
+#define BENCH_TEMPERATURE       25.0
+#define BENCH_SCHED_SAMPLES     64U
+#define BENCH_SCHED_STEP_AT     24U     //sample at which the temperature jumps
+#define BENCH_SCHED_STEP        1.0     //degree Celsius
+#define BENCH_PRESSURE          101325.0
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void print_stats(const char *name, uint32_t samples, uint64_t startUs)
+{
+    const DPS310_SIM_stats_t *stats = DPS310_SIM_getStats();
+    double n = (samples > 0U) ? samples : 1U;
+
+    printf("%s\n", name);
+    printf("  transactions  %6u reads, %6u writes, %u NACKs\n", stats->reads, stats->writes, stats->nacks);
+    printf("  payload       %6u bytes read, %6u bytes written\n", stats->bytesRead, stats->bytesWritten);
+    printf("  on the wire   %6u bytes, %.1f us bus time\n", stats->wireBytes, stats->busTimeNs / 1000.0);
+    printf("  elapsed       %.1f ms, of that %.1f ms in delays\n",
+           (DPS310_SIM_getTimeUs() - startUs) / 1000.0, stats->delayTimeUs / 1000.0);
+    if (stats->wakeups > 0U)
+    {
+        printf("  asleep        %.1f ms, %u wakeups\n", stats->sleepTimeUs / 1000.0, stats->wakeups);
+    }
+    if (samples > 0U)
+    {
+        printf("  per sample    %.2f transactions, %.1f wire bytes, %.1f us bus time\n",
+               (stats->reads + stats->writes) / n, stats->wireBytes / n, stats->busTimeNs / 1000.0 / n);
+    }
+}
+
+static void bench_init(DPS310_t *dev, cyhal_i2c_t *i2c)
+{
+    uint64_t start = DPS310_SIM_getTimeUs();
+    DPS310_SIM_resetStats();
+    DPS310_init(dev, i2c, DPS310_I2C_SLAVE_ADDRESS);
+    print_stats("DPS310_init", 0U, start);
+    printf("  result        %s, product ID %u, revision %u\n\n",
+           dev->m_initFail ? "failed" : "ok", dev->m_productID, dev->m_revisionID);
+}
+
+static void bench_warm_start(DPS310_t *dev, cyhal_i2c_t *i2c, DPS310_SIM_sensor_t *sensor)
+{
+    DPS310_calib_t calib;
+    DPS310_t warm;
+    float prs;
+
+    //what a node keeps across hibernate, taken right after the cold start
+    DPS310_getCalib(dev, &calib);
+
+    uint64_t start = DPS310_SIM_getTimeUs();
+    DPS310_SIM_resetStats();
+    int16_t ret = DPS310_initWarm(&warm, i2c, DPS310_I2C_SLAVE_ADDRESS, &calib);
+    print_stats("DPS310_initWarm", 0U, start);
+    printf("  result        %s\n", (ret == DPS310_WARM_START) ? "warm start" : "cold start");
+
+    DPS310_measurePressureOnce(&warm, &prs);
+    printf("  first pressure %.3f Pa after %.1f ms\n", prs, (DPS310_SIM_getTimeUs() - start) / 1000.0);
+
+    //the backup domain kept the structure but the sensor lost power, it is not ready yet
+    DPS310_SIM_powerCycle(sensor);
+    ret = DPS310_initWarm(&warm, i2c, DPS310_I2C_SLAVE_ADDRESS, &calib);
+    printf("  after a sensor power cycle %s\n\n", (ret == DPS310_WARM_START) ? "warm start" : "cold start");
+}
+
+static void bench_one_shot(DPS310_t *dev)
+{
+    double errTemp = 0.0;
+    double errPrs = 0.0;
+    uint64_t start = DPS310_SIM_getTimeUs();
+
+    DPS310_SIM_resetStats();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+    {
+        float temp;
+        float prs;
+        DPS310_measureTempOnce(dev, &temp);
+        DPS310_measurePressureOnce(dev, &prs);
+        errTemp = fmax(errTemp, fabs(temp - BENCH_TEMPERATURE));
+        errPrs = fmax(errPrs, fabs(prs - BENCH_PRESSURE));
+    }
+    print_stats("One shot, temperature + pressure pairs", 2U * BENCH_SAMPLES, start);
+    printf("  max error     %.4f C, %.3f Pa\n\n", errTemp, errPrs);
+}
+
+static void bench_async(DPS310_t *dev)
+{
+    uint32_t polls = 0U;
+    uint64_t start = DPS310_SIM_getTimeUs();
+
+    DPS310_SIM_resetStats();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+    {
+        float prs;
+        DPS310_startMeasurePressureAsync(dev, dev->m_prsOsr, NULL);
+        //poll once per millisecond, as a scheduler tick would
+        do
+        {
+            cyhal_system_delay_ms(1);
+            polls++;
+        } while (DPS310_pollAsync(dev, &prs) == DPS_BUSY);
+    }
+    print_stats("Asynchronous pressure, polled every 1 ms", BENCH_SAMPLES, start);
+    printf("  polls         %.1f per sample\n\n", (double)polls / BENCH_SAMPLES);
+}
+
+static void bench_background(DPS310_t *dev, const char *name)
+{
+    float temps[DPS__FIFO_SIZE];
+    float prss[DPS__FIFO_SIZE];
+    uint32_t samples = 0U;
+    double errPrs = 0.0;
+    uint64_t start = DPS310_SIM_getTimeUs();
+
+    DPS310_SIM_resetStats();
+    DPS310_startMeasureBothCont(dev, DPS__MEASUREMENT_RATE_1, DPS__OVERSAMPLING_RATE_8,
+                                DPS__MEASUREMENT_RATE_32, DPS__OVERSAMPLING_RATE_8);
+    for (uint32_t i = 0; i < BENCH_DRAINS; i++)
+    {
+        uint8_t tempCount = DPS__FIFO_SIZE;
+        uint8_t prsCount = DPS__FIFO_SIZE;
+        cyhal_system_delay_ms(BENCH_DRAIN_INTERVAL_MS);
+        DPS310_getContResults(dev, temps, &tempCount, prss, &prsCount);
+        samples += tempCount + prsCount;
+        for (uint8_t k = 0; k < prsCount; k++)
+        {
+            errPrs = fmax(errPrs, fabs(prss[k] - BENCH_PRESSURE));
+        }
+    }
+    DPS310_standby(dev);
+    print_stats(name, samples, start);
+    printf("  samples       %u, max pressure error %.3f Pa\n\n", samples, errPrs);
+}
+
+static void bench_interrupt(DPS310_t *dev, DPS310_SIM_sensor_t *sensor)
+{
+    float temps[DPS__FIFO_SIZE];
+    float prss[DPS__FIFO_SIZE];
+    uint32_t samples = 0U;
+    uint64_t start = DPS310_SIM_getTimeUs();
+
+    //one shot conversions, the pressure ready interrupt replaces the status polls
+    DPS310_setInterruptSources(dev, DPS310_PRS_INTR, DPS310_INT_ACTIVE_LOW);
+    DPS310_SIM_resetStats();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+    {
+        float prs;
+        DPS310_startMeasurePressureAsync(dev, dev->m_prsOsr, NULL);
+        DPS310_SIM_sleepUntilInt(sensor, 1000000U);
+        DPS310_handleInterrupt(dev, &prs);
+    }
+    print_stats("Asynchronous pressure, woken by the INT pin", BENCH_SAMPLES, start);
+    printf("\n");
+
+    //background mode, the FIFO full interrupt triggers the drain
+    start = DPS310_SIM_getTimeUs();
+    DPS310_setInterruptSources(dev, DPS310_FIFO_FULL_INTR, DPS310_INT_ACTIVE_LOW);
+    DPS310_SIM_resetStats();
+    DPS310_startMeasureBothCont(dev, DPS__MEASUREMENT_RATE_1, DPS__OVERSAMPLING_RATE_8,
+                                DPS__MEASUREMENT_RATE_32, DPS__OVERSAMPLING_RATE_8);
+    for (uint32_t i = 0; i < BENCH_DRAINS; i++)
+    {
+        uint8_t tempCount = DPS__FIFO_SIZE;
+        uint8_t prsCount = DPS__FIFO_SIZE;
+        DPS310_SIM_sleepUntilInt(sensor, 2000000U);
+        if (DPS310_handleInterrupt(dev, NULL) & DPS310_FIFO_FULL_INTR)
+        {
+            DPS310_getContResults(dev, temps, &tempCount, prss, &prsCount);
+            samples += tempCount + prsCount;
+        }
+    }
+    DPS310_standby(dev);
+    DPS310_setInterruptSources(dev, DPS310_NO_INTR, DPS310_INT_ACTIVE_LOW);
+    print_stats("Background mode, FIFO drained on the FIFO full interrupt", samples, start);
+    printf("\n");
+}
+
+static void run_schedule(DPS310_t *dev, DPS310_SIM_sensor_t *sensor, const DPS310_tempSchedule_t *schedule,
+                         const char *name)
+{
+    uint32_t refreshes[3] = {0U, 0U, 0U};
+    uint16_t maxAge = 0U;
+    uint32_t stale = 0U;
+    double errPrs = 0.0;
+    float temp;
+
+    //every run starts with a fresh temperature
+    DPS310_setTempSchedule(dev, schedule);
+    DPS310_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE);
+    DPS310_measureTempOnce(dev, &temp);
+    uint8_t tempMr = dev->m_tempMr;
+    uint8_t tempOsr = dev->m_tempOsr;
+    uint64_t start = DPS310_SIM_getTimeUs();
+    DPS310_SIM_resetStats();
+    for (uint32_t i = 0; i < BENCH_SCHED_SAMPLES; i++)
+    {
+        DPS310_prsSample_t sample;
+        if (i == BENCH_SCHED_STEP_AT)
+        {
+            DPS310_SIM_setEnvironment(sensor, BENCH_TEMPERATURE + BENCH_SCHED_STEP, BENCH_PRESSURE);
+        }
+        if (DPS310_measurePressureScheduled(dev, &sample, DPS__OVERSAMPLING_RATE_8) != DPS_SUCCEEDED)
+        {
+            printf("%s: measurement failed\n", name);
+            return;
+        }
+        refreshes[sample.tempSource]++;
+        maxAge = (sample.tempAge > maxAge) ? sample.tempAge : maxAge;
+        errPrs = fmax(errPrs, fabs(sample.pressure - BENCH_PRESSURE));
+        stale += (fabs(sample.pressure - BENCH_PRESSURE) > 1.0) ? 1U : 0U;
+    }
+    print_stats(name, BENCH_SCHED_SAMPLES, start);
+    printf("  temperature   %u scheduled, %u after drift, %u samples cached, max age %u\n",
+           refreshes[DPS310_TEMP_SCHEDULED], refreshes[DPS310_TEMP_DRIFT], refreshes[DPS310_TEMP_CACHED], maxAge);
+    printf("  max error     %.3f Pa, %u samples off by more than 1 Pa\n", errPrs, stale);
+    //the drift check must not leave its own oversampling rate behind
+    printf("  temp config   %s\n\n", ((dev->m_tempMr == tempMr) && (dev->m_tempOsr == tempOsr)) ? "kept" : "CHANGED");
+}
+
+static void bench_schedule(DPS310_t *dev, DPS310_SIM_sensor_t *sensor)
+{
+    //the default: temperature before every pressure sample
+    DPS310_tempSchedule_t every = {1U, DPS__OVERSAMPLING_RATE_8, 0U, DPS__OVERSAMPLING_RATE_1, 0.1f};
+    DPS310_tempSchedule_t sparse = {16U, DPS__OVERSAMPLING_RATE_8, 0U, DPS__OVERSAMPLING_RATE_1, 0.1f};
+    DPS310_tempSchedule_t checked = {16U, DPS__OVERSAMPLING_RATE_8, 4U, DPS__OVERSAMPLING_RATE_1, 0.1f};
+
+    printf("Scheduled temperature, %u pressure samples, temperature steps by %.1f C at sample %u\n\n",
+           BENCH_SCHED_SAMPLES, BENCH_SCHED_STEP, BENCH_SCHED_STEP_AT);
+    run_schedule(dev, sensor, &every, "Temperature before every pressure sample");
+    run_schedule(dev, sensor, &sparse, "Temperature every 16 samples");
+    run_schedule(dev, sensor, &checked, "Temperature every 16 samples, drift check every 4 at OSR 1");
+    DPS310_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE);
+}
+
+static void bench_spi(uint8_t spiMode)
+{
+    DPS310_t dev;
+    //one bus per wiring, SPI has no addresses to tell the sensors apart
+    cyhal_spi_t spi = {BENCH_SPI_BUS_ID + spiMode};
+    const char *wiring = (spiMode == DPS310_SPI_3WIRE) ? "3-wire" : "4-wire";
+    char name[96];
+
+    DPS310_SIM_sensor_t *sensor = DPS310_SIM_addSpiSensor(spi.bus_id, spiMode == DPS310_SPI_3WIRE);
+    DPS310_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE);
+
+    uint64_t start = DPS310_SIM_getTimeUs();
+    DPS310_SIM_resetStats();
+    DPS310_initSPI(&dev, &spi, spiMode);
+    snprintf(name, sizeof(name), "DPS310_initSPI, %s at %u MHz", wiring, BENCH_SPI_HZ / 1000000U);
+    print_stats(name, 0U, start);
+    printf("  result        %s, product ID %u, revision %u\n\n",
+           dev.m_initFail ? "failed" : "ok", dev.m_productID, dev.m_revisionID);
+    if (dev.m_initFail)
+    {
+        return;
+    }
+
+    snprintf(name, sizeof(name), "Background mode over %s SPI, same rates and drain interval", wiring);
+    bench_background(&dev, name);
+}
+
+static void bench_compensation(DPS310_t *dev)
+{
+    int32_t raw[DPS__FIFO_SIZE];
+    float outFloat[DPS__FIFO_SIZE];
+    int32_t outFixed[DPS__FIFO_SIZE];
+    volatile float sinkFloat = 0;
+    volatile int32_t sinkFixed = 0;
+
+    //one full FIFO of pressure results, as the drain above sees it
+    DPS310_startMeasurePressureCont(dev, DPS__MEASUREMENT_RATE_32, DPS__OVERSAMPLING_RATE_8);
+    cyhal_system_delay_ms(2000);
+    int16_t count = DPS310_readFIFO(dev, raw, DPS__FIFO_SIZE);
+    DPS310_standby(dev);
+    if (count <= 0)
+    {
+        printf("Compensation throughput: FIFO was empty\n");
+        return;
+    }
+
+    double start = now_ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+    {
+        DPS310_calcPressureBatch(dev, raw, outFloat, (uint8_t)count);
+        sinkFloat += outFloat[r % count];
+    }
+    double tFloat = (now_ns() - start) / ((double)BENCH_ROUNDS * count);
+
+    start = now_ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+    {
+        DPS310_calcPressureBatchFixed(dev, raw, outFixed, (uint8_t)count);
+        sinkFixed += outFixed[r % count];
+    }
+    double tFixed = (now_ns() - start) / ((double)BENCH_ROUNDS * count);
+
+    printf("Compensation throughput on this host, %d FIFO entries per batch\n", count);
+    printf("  %-30s %8.2f ns/sample\n", "DPS310_calcPressureBatch", tFloat);
+    printf("  %-30s %8.2f ns/sample\n", "DPS310_calcPressureBatchFixed", tFixed);
+}
+
+int main(void)
+{
+    DPS310_t dev;
+    cyhal_i2c_t i2c = {0};
+
+    DPS310_SIM_reset(BENCH_BUS_HZ);
+    DPS310_SIM_sensor_t *sensor = DPS310_SIM_addSensor(i2c.bus_id, DPS310_I2C_SLAVE_ADDRESS);
+    DPS310_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE);
+
+    printf("Simulated DPS310 at %u kHz, %.1f C, %.0f Pa\n\n", BENCH_BUS_HZ / 1000U, BENCH_TEMPERATURE, BENCH_PRESSURE);
+#if DPS310_TRACE
+    DPS310_traceInit();
+#endif
+    bench_init(&dev, &i2c);
+    if (dev.m_initFail)
+    {
+        return 1;
+    }
+    bench_warm_start(&dev, &i2c, sensor);
+    bench_one_shot(&dev);
+    bench_async(&dev);
+    bench_background(&dev, "Background mode, 1 Hz temperature + 32 Hz pressure, FIFO drained every 900 ms");
+    bench_interrupt(&dev, sensor);
+    bench_schedule(&dev, sensor);
+    bench_compensation(&dev);
+#if DPS310_TRACE
+    /* Everything on the I2C bus so far, charged to the API calls */
+    DPS310_traceDump();
+#endif
+
+    printf("\n");
+    DPS310_SIM_setSpiHz(BENCH_SPI_HZ);
+    bench_spi(DPS310_SPI_4WIRE);
+    bench_spi(DPS310_SPI_3WIRE);
+    return 0;
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+* File Name: bench_compensation.c
+*
+* Description: Host benchmark of the DPS310 pressure compensation. Compares
+*              the float, float batch and fixed-point batch kernels against a
+*              double precision reference and measures their throughput.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "dps310.h"
+
+#define BENCH_BATCH         DPS__FIFO_SIZE
+#define BENCH_ROUNDS        200000
+#define BENCH_TEMP_STEPS    64
+#define BENCH_PRS_STEPS     4096
+
+typedef struct
+{
+    double max_err;
+    double sum_sq;
+    uint32_t count;
+} error_stats_t;
+
+/* Coefficients of a typical DPS310 */
+static void set_typical_coeffs(DPS310_t *dev)
+{
+    dev->m_c0Half = 104;
+    dev->m_c1 = -258;
+    dev->m_c00 = 78342;
+    dev->m_c10 = -52314;
+    dev->m_c01 = -2546;
+    dev->m_c11 = 1301;
+    dev->m_c20 = -9281;
+    dev->m_c21 = 103;
+    dev->m_c30 = -1004;
+}
+
+static const int32_t scaling_facts[DPS__NUM_OF_SCAL_FACTS] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
+
+static double reference_pressure(const DPS310_t *dev, int32_t raw_temp, int32_t raw_prs)
+{
+    double t = (double)raw_temp / scaling_facts[dev->m_tempOsr];
+    double p = (double)raw_prs / scaling_facts[dev->m_prsOsr];
+    return dev->m_c00 + p * (dev->m_c10 + p * (dev->m_c20 + p * dev->m_c30))
+            + t * (dev->m_c01 + p * (dev->m_c11 + p * dev->m_c21));
+}
+
+static void add_error(error_stats_t *stats, double value, double reference)
+{
+    double err = fabs(value - reference);
+    if (err > stats->max_err)
+    {
+        stats->max_err = err;
+    }
+    stats->sum_sq += err * err;
+    stats->count++;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run_accuracy(DPS310_t *dev)
+{
+    error_stats_t err_float = {0};
+    error_stats_t err_batch = {0};
+    error_stats_t err_fixed = {0};
+    int32_t raw[BENCH_BATCH];
+    float out_float[BENCH_BATCH];
+    int32_t out_fixed[BENCH_BATCH];
+
+    for (uint8_t osr = 0; osr < DPS__NUM_OF_SCAL_FACTS; osr++)
+    {
+        dev->m_tempOsr = osr;
+        dev->m_prsOsr = osr;
+        for (int ti = 0; ti < BENCH_TEMP_STEPS; ti++)
+        {
+            /* scaled temperature 0.0 .. 0.6, roughly -50 .. 100 degree Celsius */
+            int32_t raw_temp = (int32_t)(0.6 * ti / BENCH_TEMP_STEPS * scaling_facts[osr]);
+            DPS310_calcTemp(dev, raw_temp);
+
+            for (int pi = 0; pi < BENCH_PRS_STEPS; pi += BENCH_BATCH)
+            {
+                /* scaled pressure -0.7 .. 0.95, roughly 110 kPa .. 30 kPa */
+                for (int k = 0; k < BENCH_BATCH; k++)
+                {
+                    double scaled = -0.7 + 1.65 * (pi + k) / BENCH_PRS_STEPS;
+                    raw[k] = (int32_t)(scaled * scaling_facts[osr]);
+                }
+                DPS310_calcPressureBatch(dev, raw, out_float, BENCH_BATCH);
+                DPS310_calcPressureBatchFixed(dev, raw, out_fixed, BENCH_BATCH);
+                for (int k = 0; k < BENCH_BATCH; k++)
+                {
+                    double ref = reference_pressure(dev, raw_temp, raw[k]);
+                    add_error(&err_float, DPS310_calcPressure(dev, raw[k]), ref);
+                    add_error(&err_batch, out_float[k], ref);
+                    add_error(&err_fixed, (double)out_fixed[k] / (1 << DPS__PRS_FRAC_BITS), ref);
+                }
+            }
+        }
+    }
+
+    printf("Accuracy against double precision, %u samples over all oversampling rates\n", err_float.count);
+    printf("  %-30s max %8.4f Pa   rms %8.4f Pa\n", "DPS310_calcPressure", err_float.max_err, sqrt(err_float.sum_sq / err_float.count));
+    printf("  %-30s max %8.4f Pa   rms %8.4f Pa\n", "DPS310_calcPressureBatch", err_batch.max_err, sqrt(err_batch.sum_sq / err_batch.count));
+    printf("  %-30s max %8.4f Pa   rms %8.4f Pa\n", "DPS310_calcPressureBatchFixed", err_fixed.max_err, sqrt(err_fixed.sum_sq / err_fixed.count));
+}
+
+static void run_throughput(DPS310_t *dev)
+{
+    int32_t raw[BENCH_BATCH];
+    float out_float[BENCH_BATCH];
+    int32_t out_fixed[BENCH_BATCH];
+    volatile float sink_float = 0;
+    volatile int32_t sink_fixed = 0;
+    const double samples = (double)BENCH_ROUNDS * BENCH_BATCH;
+
+    dev->m_tempOsr = DPS__OVERSAMPLING_RATE_8;
+    dev->m_prsOsr = DPS__OVERSAMPLING_RATE_8;
+    DPS310_calcTemp(dev, 2300000);
+    for (int k = 0; k < BENCH_BATCH; k++)
+    {
+        raw[k] = -2500000 + 1000 * k;
+    }
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        for (int k = 0; k < BENCH_BATCH; k++)
+        {
+            out_float[k] = DPS310_calcPressure(dev, raw[k]);
+        }
+        sink_float += out_float[r % BENCH_BATCH];
+    }
+    double t_single = (now_ns() - start) / samples;
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        DPS310_calcPressureBatch(dev, raw, out_float, BENCH_BATCH);
+        sink_float += out_float[r % BENCH_BATCH];
+    }
+    double t_batch = (now_ns() - start) / samples;
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        DPS310_calcPressureBatchFixed(dev, raw, out_fixed, BENCH_BATCH);
+        sink_fixed += out_fixed[r % BENCH_BATCH];
+    }
+    double t_fixed = (now_ns() - start) / samples;
+
+    printf("\nThroughput on this host, batches of %d samples\n", BENCH_BATCH);
+    printf("  %-30s %8.2f ns/sample\n", "DPS310_calcPressure", t_single);
+    printf("  %-30s %8.2f ns/sample\n", "DPS310_calcPressureBatch", t_batch);
+    printf("  %-30s %8.2f ns/sample\n", "DPS310_calcPressureBatchFixed", t_fixed);
+    printf("\nHost timings show the gain of the batch layout. On the FPU-less CM0+ every\n"
+           "float operation is a library call, which the fixed-point kernel avoids.\n");
+}
+
+int main(void)
+{
+    DPS310_t dev = {0};
+    set_typical_coeffs(&dev);
+
+    run_accuracy(&dev);
+    run_throughput(&dev);
+    return 0;
+}
@@ -0,0 +1,670 @@
+/******************************************************************************
+* File Name: dps310_sim.c
+*
+* Description: Host implementation of the HAL calls used by the DPS310 driver,
+*              backed by a register model of the sensor. It covers PROD_ID,
+*              the coefficient block, the ready bits, one shot and background
+*              conversions, the FIFO, the interrupt status register and the
+*              I2C, 4-wire SPI and 3-wire SPI interfaces.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "dps310_sim.h"
+
+#define SIM_RSLT_NACK ((cy_rslt_t)0x00000001U)
+
+#define SIM_REG_PSR_B2 0x00U
+#define SIM_REG_TMP_B2 0x03U
+#define SIM_REG_PRS_CFG 0x06U
+#define SIM_REG_TMP_CFG 0x07U
+#define SIM_REG_MEAS_CFG 0x08U
+#define SIM_REG_CFG_REG 0x09U
+#define SIM_REG_INT_STS 0x0AU
+#define SIM_REG_FIFO_STS 0x0BU
+#define SIM_REG_RESET 0x0CU
+#define SIM_REG_ID 0x0DU
+#define SIM_REG_COEF 0x10U
+#define SIM_REG_COEF_SRCE 0x28U
+
+#define SIM_MEAS_COEF_RDY 0x80U
+#define SIM_MEAS_SENSOR_RDY 0x40U
+#define SIM_MEAS_TMP_RDY 0x20U
+#define SIM_MEAS_PRS_RDY 0x10U
+#define SIM_MEAS_CTRL 0x07U
+
+#define SIM_CFG_INT_HL 0x80U
+#define SIM_CFG_INT_FIFO 0x40U
+#define SIM_CFG_INT_TMP 0x20U
+#define SIM_CFG_INT_PRS 0x10U
+#define SIM_CFG_FIFO_EN 0x02U
+#define SIM_CFG_SPI3W 0x01U
+
+#define SIM_INT_FIFO_FULL 0x04U
+#define SIM_INT_TMP 0x02U
+#define SIM_INT_PRS 0x01U
+
+#define SIM_FIFO_STS_FULL 0x02U
+#define SIM_FIFO_STS_EMPTY 0x01U
+
+#define SIM_RESET_FIFO_FLUSH 0x80U
+#define SIM_RESET_SOFT_RST 0x09U
+
+#define SIM_FIFO_EMPTY_VALUE 0x800000
+
+//power-on until the coefficients can be read
+#define SIM_STARTUP_US 40000U
+//start and stop/restart conditions, in bus clocks
+#define SIM_I2C_START_STOP_CLOCKS 3U
+//chip select setup and hold, in bus clocks
+#define SIM_SPI_SELECT_CLOCKS 2U
+#define SIM_SPI_READ_CMD 0x80U
+//background results the model catches up at once, older ones are skipped
+#define SIM_MAX_CATCH_UP 64U
+//resolution of DPS310_SIM_sleepUntilInt()
+#define SIM_SLEEP_STEP_US 100U
+
+static const int32_t SIM_scaling_facts[8] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
+
+// a typical DPS310, c0 is even so that the driver's c0 / 2 is exact
+static const DPS310_SIM_coeffs_t SIM_default_coeffs = {208, -258, 78342, -52314, -2546, 1301, -9281, 103, -1004};
+
+static DPS310_SIM_sensor_t SIM_sensors[DPS310_SIM_MAX_SENSORS];
+static uint8_t SIM_numSensors;
+static uint32_t SIM_busHz = 1000000U;
+static uint32_t SIM_spiHz = 10000000U;
+static uint64_t SIM_nowNs;
+static DPS310_SIM_stats_t SIM_stats;
+
+static uint64_t SIM_nowUs(void)
+{
+    return SIM_nowNs / 1000U;
+}
+
+static void SIM_putBits(uint8_t *regs, uint8_t first, uint8_t lastBit, uint32_t value, uint8_t bits)
+{
+    //write value MSB first into the bit stream starting at bit 7 of regs[first]
+    uint32_t pos = (uint32_t)first * 8U + (7U - lastBit);
+    for (int8_t b = bits - 1; b >= 0; b--, pos++)
+    {
+        uint8_t mask = (uint8_t)(0x80U >> (pos % 8U));
+        if (value & (1UL << b))
+        {
+            regs[pos / 8U] |= mask;
+        }
+        else
+        {
+            regs[pos / 8U] &= (uint8_t)~mask;
+        }
+    }
+}
+
+static void SIM_writeCoeffs(DPS310_SIM_sensor_t *s)
+{
+    uint8_t *coef = &s->regs[SIM_REG_COEF];
+    memset(coef, 0, 18);
+    //layout from the datasheet, every coefficient in two's complement
+    SIM_putBits(coef, 0, 7, (uint32_t)s->coeffs.c0 & 0xFFFU, 12);
+    SIM_putBits(coef, 1, 3, (uint32_t)s->coeffs.c1 & 0xFFFU, 12);
+    SIM_putBits(coef, 3, 7, (uint32_t)s->coeffs.c00 & 0xFFFFFU, 20);
+    SIM_putBits(coef, 5, 3, (uint32_t)s->coeffs.c10 & 0xFFFFFU, 20);
+    SIM_putBits(coef, 8, 7, (uint32_t)s->coeffs.c01 & 0xFFFFU, 16);
+    SIM_putBits(coef, 10, 7, (uint32_t)s->coeffs.c11 & 0xFFFFU, 16);
+    SIM_putBits(coef, 12, 7, (uint32_t)s->coeffs.c20 & 0xFFFFU, 16);
+    SIM_putBits(coef, 14, 7, (uint32_t)s->coeffs.c21 & 0xFFFFU, 16);
+    SIM_putBits(coef, 16, 7, (uint32_t)s->coeffs.c30 & 0xFFFFU, 16);
+}
+
+static void SIM_powerOn(DPS310_SIM_sensor_t *s)
+{
+    memset(s->regs, 0, sizeof(s->regs));
+    //product ID 0, revision 1
+    s->regs[SIM_REG_ID] = 0x10U;
+    //coefficients were calibrated with the external (MEMS) temperature sensor
+    s->regs[SIM_REG_COEF_SRCE] = 0x80U;
+    s->regs[SIM_REG_FIFO_STS] = SIM_FIFO_STS_EMPTY;
+    SIM_writeCoeffs(s);
+
+    s->readyAtUs = SIM_nowUs() + SIM_STARTUP_US;
+    s->convEndUs = 0U;
+    s->fifoHead = 0U;
+    s->fifoCount = 0U;
+}
+
+static uint64_t SIM_convTimeUs(const DPS310_SIM_sensor_t *s, uint8_t osr)
+{
+    //datasheet measurement time, 3.6 ms at OSR 1 up to 206.8 ms at OSR 128
+    return (uint64_t)(20U + (16U << osr)) * 100U * s->timingPercent / 100U;
+}
+
+static uint64_t SIM_periodUs(uint8_t mr)
+{
+    return 1000000U >> mr;
+}
+
+static int32_t SIM_toRaw(double scaled, uint8_t osr)
+{
+    double raw = floor(scaled * SIM_scaling_facts[osr] + 0.5);
+    if (raw > 0x7FFFFF)
+    {
+        raw = 0x7FFFFF;
+    }
+    if (raw < -0x7FFFFF)
+    {
+        raw = -0x7FFFFF;
+    }
+    return (int32_t)raw;
+}
+
+static double SIM_scaledTemp(const DPS310_SIM_sensor_t *s)
+{
+    //inverse of T = c0 * 0.5 + c1 * Traw_sc
+    return (s->temperature - s->coeffs.c0 * 0.5) / s->coeffs.c1;
+}
+
+static int32_t SIM_rawTemp(const DPS310_SIM_sensor_t *s)
+{
+    return SIM_toRaw(SIM_scaledTemp(s), s->regs[SIM_REG_TMP_CFG] & 0x07U);
+}
+
+static int32_t SIM_rawPressure(const DPS310_SIM_sensor_t *s)
+{
+    const DPS310_SIM_coeffs_t *c = &s->coeffs;
+    double t = SIM_scaledTemp(s);
+    double p = 0.0;
+
+    //Newton iteration on the compensation polynomial
+    for (uint8_t i = 0; i < 20U; i++)
+    {
+        double f = c->c00 + p * (c->c10 + p * (c->c20 + p * c->c30)) + t * (c->c01 + p * (c->c11 + p * c->c21))
+                - s->pressure;
+        double df = c->c10 + p * (2.0 * c->c20 + 3.0 * p * c->c30) + t * (c->c11 + 2.0 * p * c->c21);
+        p -= f / df;
+    }
+    return SIM_toRaw(p, s->regs[SIM_REG_PRS_CFG] & 0x07U);
+}
+
+static void SIM_setResult(DPS310_SIM_sensor_t *s, uint8_t reg, int32_t raw)
+{
+    s->regs[reg] = (uint8_t)(raw >> 16);
+    s->regs[reg + 1U] = (uint8_t)(raw >> 8);
+    s->regs[reg + 2U] = (uint8_t)raw;
+}
+
+static void SIM_updateFifoStatus(DPS310_SIM_sensor_t *s)
+{
+    s->regs[SIM_REG_FIFO_STS] = (s->fifoCount == 0U) ? SIM_FIFO_STS_EMPTY : 0U;
+    if (s->fifoCount == DPS310_SIM_FIFO_SIZE)
+    {
+        s->regs[SIM_REG_FIFO_STS] |= SIM_FIFO_STS_FULL;
+    }
+}
+
+static void SIM_fifoPush(DPS310_SIM_sensor_t *s, int32_t raw)
+{
+    //a full FIFO drops new results
+    if (s->fifoCount == DPS310_SIM_FIFO_SIZE)
+    {
+        return;
+    }
+    s->fifo[(s->fifoHead + s->fifoCount) % DPS310_SIM_FIFO_SIZE] = raw;
+    s->fifoCount++;
+    if ((s->fifoCount == DPS310_SIM_FIFO_SIZE) && (s->regs[SIM_REG_CFG_REG] & SIM_CFG_INT_FIFO))
+    {
+        s->regs[SIM_REG_INT_STS] |= SIM_INT_FIFO_FULL;
+    }
+    SIM_updateFifoStatus(s);
+}
+
+static void SIM_finishConversion(DPS310_SIM_sensor_t *s, uint8_t isPressure)
+{
+    int32_t raw = isPressure ? SIM_rawPressure(s) : SIM_rawTemp(s);
+
+    s->conversions++;
+    if (s->regs[SIM_REG_CFG_REG] & SIM_CFG_FIFO_EN)
+    {
+        //the LSB of a FIFO entry tells pressure (1) from temperature (0)
+        SIM_fifoPush(s, isPressure ? (raw | 0x01) : (raw & ~0x01));
+        return;
+    }
+
+    SIM_setResult(s, isPressure ? SIM_REG_PSR_B2 : SIM_REG_TMP_B2, raw);
+    s->regs[SIM_REG_MEAS_CFG] |= isPressure ? SIM_MEAS_PRS_RDY : SIM_MEAS_TMP_RDY;
+    if (s->regs[SIM_REG_CFG_REG] & (isPressure ? SIM_CFG_INT_PRS : SIM_CFG_INT_TMP))
+    {
+        s->regs[SIM_REG_INT_STS] |= isPressure ? SIM_INT_PRS : SIM_INT_TMP;
+    }
+}
+
+static void SIM_catchUp(uint64_t *next, uint64_t period, uint64_t now)
+{
+    //skip results the FIFO could not hold anyway
+    if (*next + SIM_MAX_CATCH_UP * period < now)
+    {
+        *next += ((now - *next) / period - SIM_MAX_CATCH_UP) * period;
+    }
+}
+
+static void SIM_update(DPS310_SIM_sensor_t *s)
+{
+    uint64_t now = SIM_nowUs();
+    uint8_t ctrl = s->regs[SIM_REG_MEAS_CFG] & SIM_MEAS_CTRL;
+
+    if (now >= s->readyAtUs)
+    {
+        s->regs[SIM_REG_MEAS_CFG] |= SIM_MEAS_COEF_RDY | SIM_MEAS_SENSOR_RDY;
+    }
+
+    //one shot conversion, the sensor returns to standby afterwards
+    if ((ctrl == 0x01U || ctrl == 0x02U) && (now >= s->convEndUs))
+    {
+        s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_CTRL;
+        SIM_finishConversion(s, ctrl == 0x01U);
+        return;
+    }
+
+    //background mode, results in time order
+    if (ctrl >= 0x05U)
+    {
+        uint8_t doTemp = (ctrl & 0x02U) != 0U;
+        uint8_t doPrs = (ctrl & 0x01U) != 0U;
+        uint64_t tempPeriod = SIM_periodUs((s->regs[SIM_REG_TMP_CFG] >> 4) & 0x07U);
+        uint64_t prsPeriod = SIM_periodUs((s->regs[SIM_REG_PRS_CFG] >> 4) & 0x07U);
+
+        if (doTemp)
+        {
+            SIM_catchUp(&s->nextTempUs, tempPeriod, now);
+        }
+        if (doPrs)
+        {
+            SIM_catchUp(&s->nextPrsUs, prsPeriod, now);
+        }
+        for (;;)
+        {
+            uint8_t tempDue = doTemp && (s->nextTempUs <= now);
+            uint8_t prsDue = doPrs && (s->nextPrsUs <= now);
+            if (tempDue && (!prsDue || s->nextTempUs <= s->nextPrsUs))
+            {
+                SIM_finishConversion(s, 0U);
+                s->nextTempUs += tempPeriod;
+            }
+            else if (prsDue)
+            {
+                SIM_finishConversion(s, 1U);
+                s->nextPrsUs += prsPeriod;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+}
+
+static void SIM_writeMeasCfg(DPS310_SIM_sensor_t *s, uint8_t value)
+{
+    uint8_t ctrl = value & SIM_MEAS_CTRL;
+    uint64_t now = SIM_nowUs();
+
+    //only the mode bits are writable, a new mode clears the ready flags
+    s->regs[SIM_REG_MEAS_CFG] = (s->regs[SIM_REG_MEAS_CFG] & (SIM_MEAS_COEF_RDY | SIM_MEAS_SENSOR_RDY)) | ctrl;
+    switch (ctrl)
+    {
+    case 0x01U:
+        s->convEndUs = now + SIM_convTimeUs(s, s->regs[SIM_REG_PRS_CFG] & 0x07U);
+        break;
+    case 0x02U:
+        s->convEndUs = now + SIM_convTimeUs(s, s->regs[SIM_REG_TMP_CFG] & 0x07U);
+        break;
+    case 0x05U:
+    case 0x06U:
+    case 0x07U:
+        s->nextTempUs = now + SIM_convTimeUs(s, s->regs[SIM_REG_TMP_CFG] & 0x07U);
+        s->nextPrsUs = now + SIM_convTimeUs(s, s->regs[SIM_REG_PRS_CFG] & 0x07U);
+        break;
+    default:
+        break;
+    }
+}
+
+static void SIM_writeReg(DPS310_SIM_sensor_t *s, uint8_t reg, uint8_t value)
+{
+    switch (reg)
+    {
+    case SIM_REG_MEAS_CFG:
+        SIM_writeMeasCfg(s, value);
+        break;
+    case SIM_REG_RESET:
+        if ((value & 0x0FU) == SIM_RESET_SOFT_RST)
+        {
+            SIM_powerOn(s);
+        }
+        else if (value & SIM_RESET_FIFO_FLUSH)
+        {
+            s->fifoCount = 0U;
+            SIM_updateFifoStatus(s);
+        }
+        break;
+    case SIM_REG_INT_STS:
+    case SIM_REG_FIFO_STS:
+    case SIM_REG_ID:
+        //read only
+        break;
+    default:
+        s->regs[reg] = value;
+        break;
+    }
+}
+
+static uint8_t SIM_readReg(DPS310_SIM_sensor_t *s, uint8_t reg)
+{
+    uint8_t value;
+
+    //reading PSR_B2 with the FIFO enabled pops the next entry into the result registers
+    if ((reg == SIM_REG_PSR_B2) && (s->regs[SIM_REG_CFG_REG] & SIM_CFG_FIFO_EN))
+    {
+        int32_t raw = SIM_FIFO_EMPTY_VALUE;
+        if (s->fifoCount > 0U)
+        {
+            raw = s->fifo[s->fifoHead];
+            s->fifoHead = (s->fifoHead + 1U) % DPS310_SIM_FIFO_SIZE;
+            s->fifoCount--;
+            SIM_updateFifoStatus(s);
+        }
+        SIM_setResult(s, SIM_REG_PSR_B2, raw);
+    }
+
+    value = s->regs[reg];
+    if (reg == SIM_REG_INT_STS)
+    {
+        //cleared on read
+        s->regs[SIM_REG_INT_STS] = 0U;
+    }
+    else if (reg == SIM_REG_PSR_B2 + 2U)
+    {
+        s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_PRS_RDY;
+    }
+    else if (reg == SIM_REG_TMP_B2 + 2U)
+    {
+        s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_TMP_RDY;
+    }
+    return value;
+}
+
+static DPS310_SIM_sensor_t *SIM_find(uint32_t busId, uint8_t spi, uint16_t address)
+{
+    for (uint8_t i = 0; i < SIM_numSensors; i++)
+    {
+        DPS310_SIM_sensor_t *s = &SIM_sensors[i];
+        if ((s->busId == busId) && (s->spi == spi) && (spi || (s->address == address)))
+        {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+static void SIM_transfer(uint32_t wireBytes)
+{
+    //9 clocks per byte (8 data + ACK) plus start, restart and stop
+    uint64_t clocks = (uint64_t)wireBytes * 9U + SIM_I2C_START_STOP_CLOCKS;
+    uint64_t ns = clocks * 1000000000ULL / SIM_busHz;
+    SIM_nowNs += ns;
+    SIM_stats.wireBytes += wireBytes;
+    SIM_stats.busTimeNs += ns;
+}
+
+static void SIM_transferSpi(uint32_t wireBytes)
+{
+    //8 clocks per byte, no acknowledge, no addressing
+    uint64_t clocks = (uint64_t)wireBytes * 8U + SIM_SPI_SELECT_CLOCKS;
+    uint64_t ns = clocks * 1000000000ULL / SIM_spiHz;
+    SIM_nowNs += ns;
+    SIM_stats.wireBytes += wireBytes;
+    SIM_stats.busTimeNs += ns;
+}
+
+void DPS310_SIM_reset(uint32_t busHz)
+{
+    memset(SIM_sensors, 0, sizeof(SIM_sensors));
+    SIM_numSensors = 0U;
+    SIM_busHz = busHz;
+    SIM_spiHz = 10000000U;
+    SIM_nowNs = 0U;
+    DPS310_SIM_resetStats();
+}
+
+DPS310_SIM_sensor_t *DPS310_SIM_addSensor(uint32_t busId, uint8_t address)
+{
+    if (SIM_numSensors >= DPS310_SIM_MAX_SENSORS)
+    {
+        return NULL;
+    }
+    DPS310_SIM_sensor_t *s = &SIM_sensors[SIM_numSensors++];
+    s->busId = busId;
+    s->address = address;
+    s->coeffs = SIM_default_coeffs;
+    s->temperature = 25.0;
+    s->pressure = 101325.0;
+    s->timingPercent = 100U;
+    SIM_powerOn(s);
+    return s;
+}
+
+DPS310_SIM_sensor_t *DPS310_SIM_addSpiSensor(uint32_t busId, uint8_t threeWire)
+{
+    DPS310_SIM_sensor_t *s = DPS310_SIM_addSensor(busId, 0U);
+    if (s != NULL)
+    {
+        s->spi = 1U;
+        s->threeWire = threeWire;
+    }
+    return s;
+}
+
+void DPS310_SIM_setSpiHz(uint32_t spiHz)
+{
+    SIM_spiHz = spiHz;
+}
+
+void DPS310_SIM_setCoeffs(DPS310_SIM_sensor_t *sensor, const DPS310_SIM_coeffs_t *coeffs)
+{
+    sensor->coeffs = *coeffs;
+    SIM_writeCoeffs(sensor);
+}
+
+void DPS310_SIM_setEnvironment(DPS310_SIM_sensor_t *sensor, double temperature, double pressure)
+{
+    sensor->temperature = temperature;
+    sensor->pressure = pressure;
+}
+
+void DPS310_SIM_setTimingPercent(DPS310_SIM_sensor_t *sensor, uint32_t percent)
+{
+    sensor->timingPercent = percent;
+}
+
+//the sensor loses its registers and runs the start-up sequence again, the MCU keeps running
+void DPS310_SIM_powerCycle(DPS310_SIM_sensor_t *sensor)
+{
+    SIM_powerOn(sensor);
+}
+
+uint8_t DPS310_SIM_getIntPin(DPS310_SIM_sensor_t *sensor)
+{
+    //the pin is active while any flag in INT_STS is set
+    uint8_t active = (sensor->regs[SIM_REG_INT_STS] != 0U);
+    uint8_t activeHigh = (sensor->regs[SIM_REG_CFG_REG] & SIM_CFG_INT_HL) != 0U;
+    return activeHigh ? active : !active;
+}
+
+uint64_t DPS310_SIM_sleepUntilInt(DPS310_SIM_sensor_t *sensor, uint64_t timeoutUs)
+{
+    //the CPU sleeps, only the sensor keeps converting
+    uint64_t start = SIM_nowUs();
+    uint8_t activeHigh = (sensor->regs[SIM_REG_CFG_REG] & SIM_CFG_INT_HL) != 0U;
+    for (;;)
+    {
+        SIM_update(sensor);
+        if (DPS310_SIM_getIntPin(sensor) == activeHigh)
+        {
+            SIM_stats.wakeups++;
+            break;
+        }
+        if (SIM_nowUs() - start >= timeoutUs)
+        {
+            break;
+        }
+        SIM_nowNs += SIM_SLEEP_STEP_US * 1000U;
+    }
+    SIM_stats.sleepTimeUs += SIM_nowUs() - start;
+    return SIM_nowUs() - start;
+}
+
+uint64_t DPS310_SIM_getTimeUs(void)
+{
+    return SIM_nowUs();
+}
+
+//the stub cycle counter runs on the virtual time once enabled, writes to it are lost
+uint32_t SystemCoreClock = DPS310_SIM_CPU_HZ;
+CoreDebug_Type DPS310_SIM_coreDebug;
+static DWT_Type SIM_dwt;
+
+DWT_Type *DPS310_SIM_getDwt(void)
+{
+    if (SIM_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+    {
+        SIM_dwt.CYCCNT = (uint32_t)(SIM_nowNs * (SystemCoreClock / 1000000U) / 1000U);
+    }
+    return &SIM_dwt;
+}
+
+const DPS310_SIM_stats_t *DPS310_SIM_getStats(void)
+{
+    return &SIM_stats;
+}
+
+void DPS310_SIM_resetStats(void)
+{
+    memset(&SIM_stats, 0, sizeof(SIM_stats));
+}
+
+cy_rslt_t cyhal_i2c_master_mem_read(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+                                    uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)timeout;
+    DPS310_SIM_sensor_t *s = SIM_find((obj != NULL) ? obj->bus_id : 0U, 0U, address);
+
+    SIM_stats.reads++;
+    if (s == NULL)
+    {
+        //the slave address is not acknowledged
+        SIM_stats.nacks++;
+        SIM_transfer(1U);
+        return SIM_RSLT_NACK;
+    }
+
+    //slave address (write), register address, slave address (read), data
+    SIM_transfer(2U + mem_addr_size + size);
+    SIM_stats.bytesRead += size;
+    SIM_update(s);
+    for (uint16_t i = 0; i < size; i++)
+    {
+        data[i] = SIM_readReg(s, (uint8_t)(mem_addr + i));
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_i2c_master_mem_write(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+                                     const uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    (void)timeout;
+    DPS310_SIM_sensor_t *s = SIM_find((obj != NULL) ? obj->bus_id : 0U, 0U, address);
+
+    SIM_stats.writes++;
+    if (s == NULL)
+    {
+        SIM_stats.nacks++;
+        SIM_transfer(1U);
+        return SIM_RSLT_NACK;
+    }
+
+    //slave address, register address, data
+    SIM_transfer(1U + mem_addr_size + size);
+    SIM_stats.bytesWritten += size;
+    SIM_update(s);
+    for (uint16_t i = 0; i < size; i++)
+    {
+        SIM_writeReg(s, (uint8_t)(mem_addr + i), data[i]);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_spi_transfer(cyhal_spi_t *obj, const uint8_t *tx, size_t tx_length, uint8_t *rx, size_t rx_length,
+                             uint8_t write_fill)
+{
+    DPS310_SIM_sensor_t *s = SIM_find((obj != NULL) ? obj->bus_id : 0U, 1U, 0U);
+    size_t length = (tx_length > rx_length) ? tx_length : rx_length;
+
+    //the command byte comes first, the transfer runs for the longer of both buffers
+    if ((tx_length == 0U) || (length < 2U))
+    {
+        return SIM_RSLT_NACK;
+    }
+    SIM_transferSpi((uint32_t)length);
+    if (tx[0] & SIM_SPI_READ_CMD)
+    {
+        SIM_stats.reads++;
+        SIM_stats.bytesRead += length - 1U;
+    }
+    else
+    {
+        SIM_stats.writes++;
+        SIM_stats.bytesWritten += length - 1U;
+    }
+    if (rx_length > 0U)
+    {
+        //SDO floats while the command goes out
+        rx[0] = 0xFFU;
+    }
+    if (s == NULL)
+    {
+        //nothing drives SDO, the pull-up reads back
+        SIM_stats.nacks++;
+        memset(rx, 0xFF, rx_length);
+        return CY_RSLT_SUCCESS;
+    }
+
+    SIM_update(s);
+    uint8_t reg = tx[0] & (uint8_t)~SIM_SPI_READ_CMD;
+    for (size_t i = 1U; i < length; i++, reg++)
+    {
+        if (!(tx[0] & SIM_SPI_READ_CMD))
+        {
+            SIM_writeReg(s, reg, (i < tx_length) ? tx[i] : write_fill);
+            continue;
+        }
+        uint8_t value = SIM_readReg(s, reg);
+        //with 3-wire wiring the sensor only drives the shared line once SPI3W is set
+        if (s->threeWire && !(s->regs[SIM_REG_CFG_REG] & SIM_CFG_SPI3W))
+        {
+            value = write_fill;
+        }
+        if (i < rx_length)
+        {
+            rx[i] = value;
+        }
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_system_delay_ms(uint32_t milliseconds)
+{
+    SIM_nowNs += (uint64_t)milliseconds * 1000000U;
+    SIM_stats.delayTimeUs += (uint64_t)milliseconds * 1000U;
+}
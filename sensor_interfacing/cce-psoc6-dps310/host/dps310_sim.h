@@ -0,0 +1,91 @@
+/******************************************************************************
+* File Name: dps310_sim.h
+*
+* Description: Register model of the DPS310 behind the host versions of
+*              cyhal_i2c_master_mem_read/write, cyhal_spi_transfer and
+*              cyhal_system_delay_ms.
+*              Time is virtual: delays and bus transfers advance it, so
+*              conversion timing and bus cost can be measured without a board.
+*
+*******************************************************************************/
+
+#ifndef DPS310_SIM_H_
+#define DPS310_SIM_H_
+
+#include <stdint.h>
+
+#define DPS310_SIM_MAX_SENSORS 4U
+#define DPS310_SIM_FIFO_SIZE 32U
+#define DPS310_SIM_CPU_HZ 100000000U  //clock of the stub cycle counter
+
+// bus traffic since the last DPS310_SIM_resetStats()
+typedef struct
+{
+    uint32_t reads;         //read transactions
+    uint32_t writes;        //write transactions
+    uint32_t nacks;         //transactions no sensor answered
+    uint32_t bytesRead;     //payload bytes
+    uint32_t bytesWritten;  //payload bytes, without the register address
+    uint32_t wireBytes;     //everything on the bus, incl. slave addresses and SPI commands
+    uint64_t busTimeNs;     //time the bus was busy
+    uint64_t delayTimeUs;   //time spent in cyhal_system_delay_ms()
+    uint64_t sleepTimeUs;   //time spent in DPS310_SIM_sleepUntilInt()
+    uint32_t wakeups;       //returns of DPS310_SIM_sleepUntilInt() on an active INT pin
+} DPS310_SIM_stats_t;
+
+// compensation coefficients as stored in the COEF registers
+typedef struct
+{
+    int32_t c0;
+    int32_t c1;
+    int32_t c00;
+    int32_t c10;
+    int32_t c01;
+    int32_t c11;
+    int32_t c20;
+    int32_t c21;
+    int32_t c30;
+} DPS310_SIM_coeffs_t;
+
+typedef struct
+{
+    uint32_t busId;
+    uint8_t address;        //I2C only
+    uint8_t spi;            //1 if the sensor sits on an SPI bus
+    uint8_t threeWire;      //SPI with SDI and SDO on one line
+    uint8_t regs[256];
+
+    DPS310_SIM_coeffs_t coeffs;
+    double temperature;     //degree Celsius the sensor sees
+    double pressure;        //Pa the sensor sees
+    uint32_t timingPercent; //conversion time relative to the datasheet, 100 = nominal
+
+    uint64_t readyAtUs;     //end of the power-on sequence
+    uint64_t convEndUs;     //end of the running one shot conversion
+    uint64_t nextTempUs;    //next background temperature result
+    uint64_t nextPrsUs;     //next background pressure result
+
+    int32_t fifo[DPS310_SIM_FIFO_SIZE];
+    uint8_t fifoHead;
+    uint8_t fifoCount;
+
+    uint32_t conversions;   //finished conversions, one shot and background
+} DPS310_SIM_sensor_t;
+
+void DPS310_SIM_reset(uint32_t busHz);
+void DPS310_SIM_setSpiHz(uint32_t spiHz);
+DPS310_SIM_sensor_t *DPS310_SIM_addSensor(uint32_t busId, uint8_t address);
+DPS310_SIM_sensor_t *DPS310_SIM_addSpiSensor(uint32_t busId, uint8_t threeWire);
+void DPS310_SIM_setCoeffs(DPS310_SIM_sensor_t *sensor, const DPS310_SIM_coeffs_t *coeffs);
+void DPS310_SIM_setEnvironment(DPS310_SIM_sensor_t *sensor, double temperature, double pressure);
+void DPS310_SIM_setTimingPercent(DPS310_SIM_sensor_t *sensor, uint32_t percent);
+void DPS310_SIM_powerCycle(DPS310_SIM_sensor_t *sensor);
+
+uint8_t DPS310_SIM_getIntPin(DPS310_SIM_sensor_t *sensor);
+uint64_t DPS310_SIM_sleepUntilInt(DPS310_SIM_sensor_t *sensor, uint64_t timeoutUs);
+
+uint64_t DPS310_SIM_getTimeUs(void);
+const DPS310_SIM_stats_t *DPS310_SIM_getStats(void);
+void DPS310_SIM_resetStats(void);
+
+#endif /* DPS310_SIM_H_ */
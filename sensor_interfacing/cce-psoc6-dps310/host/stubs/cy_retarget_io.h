@@ -0,0 +1,13 @@
+/******************************************************************************
+* File Name: cy_retarget_io.h
+*
+* Description: Host stand-in for retarget-io, printf goes to stdout.
+*
+*******************************************************************************/
+
+#ifndef HOST_CY_RETARGET_IO_H_
+#define HOST_CY_RETARGET_IO_H_
+
+#include <stdio.h>
+
+#endif /* HOST_CY_RETARGET_IO_H_ */
@@ -0,0 +1,13 @@
+/******************************************************************************
+* File Name: cybsp.h
+*
+* Description: Host stand-in for the board support package header.
+*
+*******************************************************************************/
+
+#ifndef HOST_CYBSP_H_
+#define HOST_CYBSP_H_
+
+#include "cyhal.h"
+
+#endif /* HOST_CYBSP_H_ */
@@ -46,6 +46,7 @@
 #include "cy_retarget_io.h"
 
 #include "dps310.h"
+#include "altitude.h"
 
 /*******************************************************************************
 * Macros
@@ -53,6 +54,180 @@
 #define OVERSAMPLING            7
 #define I2C_MASTER_FREQUENCY    1000000
 
+/* Set to 1 to talk to the DPS310 over SPI instead of I2C. SPI runs at up to
+ * 10 MHz and has no addressing overhead, which shortens every FIFO drain. */
+#define USE_SPI                 0
+#define SPI_MASTER_FREQUENCY    DPS310__SPI_MAX_FREQ
+/* DPS310_SPI_4WIRE, or DPS310_SPI_3WIRE with SDI and SDO on one data line */
+#define SPI_WIRING              DPS310_SPI_4WIRE
+
+/* Set to 1 to let the DPS310 measure in background mode and drain its FIFO in bursts */
+#define BACKGROUND_MODE         0
+
+/* Background mode settings: temperature once per second, pressure at 32 Hz.
+ * The 32-entry FIFO is then full a little less than once per second. */
+#define BG_TEMP_RATE            DPS__MEASUREMENT_RATE_1
+#define BG_TEMP_OVERSAMPLING    DPS__OVERSAMPLING_RATE_8
+#define BG_PRS_RATE             DPS__MEASUREMENT_RATE_32
+#define BG_PRS_OVERSAMPLING     DPS__OVERSAMPLING_RATE_8
+#define BG_DRAIN_INTERVAL_MS    900
+
+/* Set to 1 to turn the background pressure samples into altitude and climb
+ * rate. The first drain sets the reference, altitude is relative to it. */
+#define ALTITUDE_ESTIMATOR      0
+#define ALTITUDE_SAMPLE_RATE    (1U << BG_PRS_RATE)
+
+/* One shot mode measures the temperature only every TEMP_REFRESH_INTERVAL
+ * pressure samples, or earlier when a quick check every TEMP_CHECK_INTERVAL
+ * samples finds it drifted by TEMP_DRIFT_THRESHOLD degree Celsius. Pressure
+ * samples in between are compensated with the cached temperature. */
+#define TEMP_REFRESH_INTERVAL   60
+#define TEMP_CHECK_INTERVAL     10
+#define TEMP_DRIFT_THRESHOLD    0.1f
+
+/* Set to 1 to let the INT pin of the DPS310 wake the CPU from deep sleep
+ * instead of waiting out conversion times and drain intervals. The sensor
+ * outputs INT on its SDO pin, which is available in I2C and 3-wire SPI mode. */
+#define INTERRUPT_MODE          0
+#define DPS310_INT_PIN          P9_0
+#define DPS310_INT_PRIORITY     3
+
+/* Set to 1 to keep the DPS310 calibration data in the backup registers. They
+ * survive resets and hibernate, so a reboot skips reading the coefficients and
+ * the priming temperature measurement. */
+#define WARM_START              0
+#define CALIB_BREG_FIRST        0U
+#define CALIB_BREG_COUNT        (sizeof(DPS310_calib_t) / sizeof(uint32_t))
+
+/* Build with DEFINES+=DPS310_TRACE=1 in the Makefile to count the bus
+ * transactions and latency of every driver call. The statistics are printed
+ * and cleared every TRACE_DUMP_INTERVAL loop iterations. */
+#define TRACE_DUMP_INTERVAL     60
+
+#if INTERRUPT_MODE
+/* Set by the INT pin interrupt, cleared once the sensor has been serviced */
+static volatile bool sensor_int_pending = false;
+
+/*******************************************************************************
+ * Function Name: sensor_isr
+ ********************************************************************************
+ * Summary:
+ * GPIO interrupt handler of the DPS310 INT pin. The sensor is read in the main
+ * loop, the handler only flags the event.
+ *
+ *******************************************************************************/
+static void sensor_isr(void *handler_arg, cyhal_gpio_irq_event_t event)
+{
+    sensor_int_pending = true;
+}
+
+/*******************************************************************************
+ * Function Name: sensor_wait
+ ********************************************************************************
+ * Summary:
+ * Keeps the CPU in deep sleep until the DPS310 raises its INT pin.
+ *
+ *******************************************************************************/
+static void sensor_wait(void)
+{
+    /* Deep sleep stops the UART, let it send what is queued */
+    cy_retarget_io_wait_tx_complete(&cy_retarget_io_uart_obj, 10);
+
+    while (!sensor_int_pending)
+    {
+        /* A pending interrupt still ends the deep sleep while they are masked,
+         * so an event between the check and the sleep is not lost */
+        uint32_t state = cyhal_system_critical_section_enter();
+        if (!sensor_int_pending)
+        {
+            cyhal_syspm_deepsleep();
+        }
+        cyhal_system_critical_section_exit(state);
+    }
+    sensor_int_pending = false;
+}
+
+/*******************************************************************************
+ * Function Name: measure_once
+ ********************************************************************************
+ * Summary:
+ * Runs one temperature or pressure conversion and sleeps until the ready
+ * interrupt of the DPS310 reports its end.
+ *
+ *******************************************************************************/
+static int16_t measure_once(DPS310_t *dev, bool pressure, float *result)
+{
+    int16_t ret = pressure ? DPS310_startMeasurePressureAsync(dev, OVERSAMPLING, NULL)
+                           : DPS310_startMeasureTempAsync(dev, OVERSAMPLING, NULL);
+    while ((ret >= 0) && (dev->m_asyncState == DPS310_ASYNC_BUSY))
+    {
+        sensor_wait();
+        ret = DPS310_handleInterrupt(dev, result);
+    }
+    return (ret < 0) ? ret : DPS_SUCCEEDED;
+}
+#endif /* INTERRUPT_MODE */
+
+#if WARM_START
+/*******************************************************************************
+ * Function Name: calib_load
+ ********************************************************************************
+ * Summary:
+ * Copies the cached calibration data out of the backup registers.
+ *
+ *******************************************************************************/
+static void calib_load(DPS310_calib_t *calib)
+{
+    uint32_t *words = (uint32_t *)calib;
+    for (uint32_t i = 0; i < CALIB_BREG_COUNT; i++)
+    {
+        words[i] = BACKUP->BREG[CALIB_BREG_FIRST + i];
+    }
+}
+
+/*******************************************************************************
+ * Function Name: calib_store
+ ********************************************************************************
+ * Summary:
+ * Caches the calibration data and the last temperature of the DPS310 in the
+ * backup registers.
+ *
+ *******************************************************************************/
+static void calib_store(DPS310_t *dev)
+{
+    DPS310_calib_t calib;
+    const uint32_t *words = (const uint32_t *)&calib;
+
+    DPS310_getCalib(dev, &calib);
+    for (uint32_t i = 0; i < CALIB_BREG_COUNT; i++)
+    {
+        BACKUP->BREG[CALIB_BREG_FIRST + i] = words[i];
+    }
+}
+#endif /* WARM_START */
+
+#if DPS310_TRACE
+/*******************************************************************************
+ * Function Name: trace_tick
+ ********************************************************************************
+ * Summary:
+ * Prints the bus trace of the DPS310 driver every TRACE_DUMP_INTERVAL calls
+ * and starts over.
+ *
+ *******************************************************************************/
+static void trace_tick(void)
+{
+    static uint32_t loops = 0;
+
+    if (++loops >= TRACE_DUMP_INTERVAL)
+    {
+        DPS310_traceDump();
+        DPS310_traceReset();
+        loops = 0;
+    }
+}
+#endif /* DPS310_TRACE */
+
 /*******************************************************************************
  * Function Name: main
  ********************************************************************************
@@ -60,7 +235,7 @@
  * This is the main function for CM4 CPU
  *    1. Initializes the BSP
  *    2. Initializes retarget IO for UART debug printing
- *    3. Initializes I2C using HAL driver
+ *    3. Initializes I2C or SPI using HAL driver
  *    4. Initializes the DPS310 pressure sensor
  *    5. Measures the temperature and the pressure values and prints it on the
 *        serial terminal.
@@ -73,10 +248,18 @@ int main(void)
 {
     cy_rslt_t result;
     
+#if USE_SPI
+    cyhal_spi_t mSPI;
+#else
     cyhal_i2c_t mI2C;
+#endif
+
+    DPS310_t dps310;
     
+#if INTERRUPT_MODE && !BACKGROUND_MODE
     float temperature = 0;
     float pressure = 0;
+#endif
 
     int16_t ret;
 
@@ -103,6 +286,23 @@ int main(void)
     printf("Interfacing Infineon DPS310 Pressure Sensor with PSoC 6 \r\n");
     printf("========================================================\n\n\r");
 
+#if USE_SPI
+    /* Initialize the SPI master, the DPS310 supports SPI modes 0 and 3 */
+    result = cyhal_spi_init(&mSPI, CYBSP_SPI_MOSI, CYBSP_SPI_MISO, CYBSP_SPI_CLK, CYBSP_SPI_CS, NULL, 8,
+                            CYHAL_SPI_MODE_00_MSB, false);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("\r\nSPI initialization failed\r\n");
+        CY_ASSERT(0);
+    }
+
+    result = cyhal_spi_set_frequency(&mSPI, SPI_MASTER_FREQUENCY);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("\r\nFailed to configure SPI\r\n");
+        CY_ASSERT(0);
+    }
+#else
     /* Define the I2C master configuration structure */
     cyhal_i2c_cfg_t i2c_master_config = {CYHAL_I2C_MODE_MASTER, 0 /* address is not used for master mode */, I2C_MASTER_FREQUENCY};
 
@@ -121,26 +321,169 @@ int main(void)
         printf("\r\nFailed to configure I2C\r\n");
         CY_ASSERT(0);
     }
+#endif /* USE_SPI */
 
     /* Print message to the console */
     printf("Initializing DPS310 Pressure sensor\r\n");
 
+#if DPS310_TRACE
+    /* Starts the cycle counter, the first dump includes the initialization */
+    DPS310_traceInit();
+#endif
+
+#if WARM_START
+    /* Reuse the cached calibration data if it belongs to this sensor */
+    DPS310_calib_t calib;
+    calib_load(&calib);
+#if USE_SPI
+    ret = DPS310_initWarmSPI(&dps310, &mSPI, SPI_WIRING, &calib);
+#else
+    ret = DPS310_initWarm(&dps310, &mI2C, DPS310_I2C_SLAVE_ADDRESS, &calib);
+#endif
+    if (ret == DPS310_COLD_START)
+    {
+        calib_store(&dps310);
+    }
+    printf("%s start\r\n", (ret == DPS310_WARM_START) ? "Warm" : "Cold");
+#else
     /* Initialize the pressure sensor */
-    DPS310_init(&mI2C);
+#if USE_SPI
+    DPS310_initSPI(&dps310, &mSPI, SPI_WIRING);
+#else
+    DPS310_init(&dps310, &mI2C, DPS310_I2C_SLAVE_ADDRESS);
+#endif
+#endif /* WARM_START */
 
     printf("Initialization Complete\r\n");
 
+#if INTERRUPT_MODE
+    /* INT is active low, so the idle level matches the default address 0x77 */
+    result = cyhal_gpio_init(DPS310_INT_PIN, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_NONE, true);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("\r\nINT pin initialization failed\r\n");
+        CY_ASSERT(0);
+    }
+    cyhal_gpio_register_callback(DPS310_INT_PIN, sensor_isr, NULL);
+    cyhal_gpio_enable_event(DPS310_INT_PIN, CYHAL_GPIO_IRQ_FALL, DPS310_INT_PRIORITY, true);
+
+    /* Background mode only needs the FIFO full event, one shot conversions the ready events */
+    ret = DPS310_setInterruptSources(&dps310, BACKGROUND_MODE ? DPS310_FIFO_FULL_INTR : DPS310_BOTH_INTR,
+                                     DPS310_INT_ACTIVE_LOW);
+    if (ret != 0)
+    {
+        printf("Failed to configure the sensor interrupt\r\n");
+        CY_ASSERT(0);
+    }
+#endif /* INTERRUPT_MODE */
+
+#if BACKGROUND_MODE
+#if ALTITUDE_ESTIMATOR
+    int32_t temperatures[DPS__FIFO_SIZE];
+    int32_t pressures[DPS__FIFO_SIZE];
+    ALT_estimator_t altitude;
+
+    ALT_init(&altitude, ALTITUDE_SAMPLE_RATE, ALT_DEFAULT_ALPHA, ALT_DEFAULT_BETA);
+#else
+    float temperatures[DPS__FIFO_SIZE];
+    float pressures[DPS__FIFO_SIZE];
+#endif /* ALTITUDE_ESTIMATOR */
+    uint8_t temp_count;
+    uint8_t prs_count;
+
+    /* Let the DPS310 measure on its own, results are queued in its FIFO */
+    ret = DPS310_startMeasureBothCont(&dps310, BG_TEMP_RATE, BG_TEMP_OVERSAMPLING, BG_PRS_RATE, BG_PRS_OVERSAMPLING);
+    if (ret != 0)
+    {
+        printf("Failed to start background measurement\r\n");
+        CY_ASSERT(0);
+    }
+
+    for (;;)
+    {
+#if INTERRUPT_MODE
+        /* Sleep until the FIFO is full, no timer and no status polls */
+        sensor_wait();
+        ret = DPS310_handleInterrupt(&dps310, NULL);
+        if ((ret < 0) || !(ret & DPS310_FIFO_FULL_INTR))
+        {
+            continue;
+        }
+#else
+        /* The CPU is free while the FIFO fills up */
+        cyhal_system_delay_ms(BG_DRAIN_INTERVAL_MS);
+#endif /* INTERRUPT_MODE */
+
+        /* Drain the whole FIFO and compensate all results in one go */
+        temp_count = DPS__FIFO_SIZE;
+        prs_count = DPS__FIFO_SIZE;
+#if ALTITUDE_ESTIMATOR
+        ret = DPS310_getContResultsFixed(&dps310, temperatures, &temp_count, pressures, &prs_count);
+#else
+        ret = DPS310_getContResults(&dps310, temperatures, &temp_count, pressures, &prs_count);
+#endif
+        if (ret != 0)
+        {
+            printf("Failed to read FIFO from sensor\r\n");
+            continue;
+        }
+
+        printf("\r\n");
+        if (temp_count > 0)
+        {
+#if ALTITUDE_ESTIMATOR
+            printf("Temperature: %f degree Celsius\r\n", temperatures[temp_count - 1] / 256.0f);
+#else
+            printf("Temperature: %f degree Celsius\r\n", temperatures[temp_count - 1]);
+#endif
+#if WARM_START
+            calib_store(&dps310);
+#endif
+        }
+        if (prs_count > 0)
+        {
+#if ALTITUDE_ESTIMATOR
+            if (!altitude.valid)
+            {
+                ALT_setReference(&altitude, pressures[0]);
+            }
+            /* The whole batch at once, results are in Q8 Pascal */
+            ALT_update(&altitude, pressures, prs_count);
+            printf("Altitude: %ld mm, climb rate: %ld mm/s (%u samples)\r\n",
+                   (long)ALT_getAltitude(&altitude), (long)ALT_getVerticalSpeed(&altitude), prs_count);
+#else
+            float sum = 0;
+            for (uint8_t i = 0; i < prs_count; i++)
+            {
+                sum += pressures[i];
+            }
+            printf("Pressure: %f Pascal (average of %u samples)\r\n", sum / prs_count, prs_count);
+#endif /* ALTITUDE_ESTIMATOR */
+        }
+#if DPS310_TRACE
+        trace_tick();
+#endif
+    }
+#else
+#if !INTERRUPT_MODE
+    DPS310_tempSchedule_t schedule = {TEMP_REFRESH_INTERVAL, OVERSAMPLING, TEMP_CHECK_INTERVAL,
+                                      DPS__OVERSAMPLING_RATE_1, TEMP_DRIFT_THRESHOLD};
+    DPS310_prsSample_t sample;
+    DPS310_setTempSchedule(&dps310, &schedule);
+#endif
+
     for (;;)
     {
         printf("\r\n");
 
+#if INTERRUPT_MODE
         /* Lets the DPS310 perform a single temperature measurement with the last (or standard) configuration
         * The result will be written to the parameter temperature
         * Oversampling can be a value from 0 to 7
         * The DPS310 will perform 2^oversampling internal temperature measurements and combine them to one result with higher precision
         * measurements. Higher precision takes more time. Consult datasheet for more information.
         */
-        ret = DPS310_measureTempOnce_oversample(&temperature, OVERSAMPLING);
+        ret = measure_once(&dps310, false, &temperature);
         if (ret != 0)
         {
             printf("Failed to read temperature data from sensor\r\n");
@@ -148,10 +491,14 @@ int main(void)
         else
         {
             printf("Temperature: %f degree Celsius\r\n", temperature);
+#if WARM_START
+            /* Keep the cached temperature fresh for the next warm start */
+            calib_store(&dps310);
+#endif
         }
 
         /* Pressure measurement behaves similar to temperature measurement */
-        ret = DPS310_measurePressureOnce_oversample(&pressure, OVERSAMPLING);
+        ret = measure_once(&dps310, true, &pressure);
         if (ret != 0)
         {
             printf("Failed to read pressure data from sensor\r\n");
@@ -160,9 +507,37 @@ int main(void)
         {
             printf("Pressure: %f Pascal\r\n", pressure);
         }
+#else
+        /* Measures the pressure, and the temperature first if the schedule asks for it.
+        * Oversampling can be a value from 0 to 7
+        * The DPS310 will perform 2^oversampling internal measurements and combine them to one result with higher precision
+        * measurements. Higher precision takes more time. Consult datasheet for more information.
+        */
+        ret = DPS310_measurePressureScheduled(&dps310, &sample, OVERSAMPLING);
+        if (ret != 0)
+        {
+            printf("Failed to read data from sensor\r\n");
+        }
+        else
+        {
+            if (sample.tempAge == 0)
+            {
+                printf("Temperature: %f degree Celsius\r\n", sample.temperature);
+#if WARM_START
+                /* Keep the cached temperature fresh for the next warm start */
+                calib_store(&dps310);
+#endif
+            }
+            printf("Pressure: %f Pascal (temperature %u samples old)\r\n", sample.pressure, sample.tempAge);
+        }
+#endif /* INTERRUPT_MODE */
 
+#if DPS310_TRACE
+        trace_tick();
+#endif
         cyhal_system_delay_ms(1000);
     }
+#endif /* BACKGROUND_MODE */
 }
 
 /* [] END OF FILE */
@@ -8,9 +8,82 @@
 
 #include "dps422.h"
 
+/*******************************************************************************
+ * Global variable
+ *******************************************************************************/
+/* Flags */
+uint8_t m_initFail;
+
+/* Settings */
+uint8_t m_tempMr;
+uint8_t m_tempOsr;
+uint8_t m_prsMr;
+uint8_t m_prsOsr;
+
+/* Compensation coefficients */
+int32_t m_c00;
+int32_t m_c10;
+int32_t m_c01;
+int32_t m_c11;
+int32_t m_c20;
+int32_t m_c21;
+int32_t m_c30;
+
+/* Compensation coefficients (for simplicity use 32 bits) */
+float a_prime;
+float b_prime;
+int32_t m_c02;
+int32_t m_c12;
+
+/* Q8 copies of a_prime and b_prime for the fixed-point path */
+int32_t a_prime_q;
+int32_t b_prime_q;
+
+/* Last measured scaled temperature (necessary for pressure compensation) */
+float m_lastTempScal;
+int32_t m_lastTempScalQ; 	/* same in Q20 */
+int32_t m_lastTempCompQ; 	/* 8.5 * T / (1 + 8.8 * T) in Q20 */
+
+/* Bus specific */
+uint8_t m_SpiI2c; 			/* 0=SPI, 1=I2C */
+
+cyhal_i2c_t *I2C_ptr;
+
+enum Mode m_opMode;
+
+/* RAM copy of the configuration registers, dirty ones are written by DPS_422_flushShadow */
+uint8_t m_shadow[DPS422__SHADOW_NUM_REGS];
+uint8_t m_shadowDirty;
+uint8_t m_shadowValid;
+
+/* Asynchronous measurement */
+DPS_422_measureCallback_t m_asyncCallback;
+enum DPS_422_AsyncState_e m_asyncState;
+
 /* Calculation factor kP associated with each oversampling rate */
 const int32_t DPS_422_scaling_facts[DPS__NUM_OF_SCAL_FACTS] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
 
+/* 2^48 / kP, turns the division of the fixed-point path into a multiplication */
+const int32_t DPS_422_scaling_recips[DPS__NUM_OF_SCAL_FACTS] = {536870912, 178956971, 76695845, 35791394, 1108378657, 545392673, 270549121, 134744072};
+
+/*******************************************************************************
+ * Structure
+ *******************************************************************************/
+/* Pressure polynomial with the temperature terms folded in, Q12 Pa */
+typedef struct
+{
+	int64_t a0;
+	int64_t a1;
+	int64_t a2;
+	int64_t a3;
+} DPS_422_prsTerms_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static int16_t DPS_422_setTempConfig(uint8_t tempMr, uint8_t tempOsr);
+static int16_t DPS_422_setPressureConfig(uint8_t prsMr, uint8_t prsOsr);
+
 /*******************************************************************************
 * Function Name: DPS_422_Init
 ********************************************************************************
@@ -24,6 +97,7 @@ const int32_t DPS_422_scaling_facts[DPS__NUM_OF_SCAL_FACTS] = {524288, 1572864,
 *******************************************************************************/
 void DPS_422_Init (cyhal_i2c_t *I2C_DPS_422)
 {
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_INIT);
 	I2C_ptr = I2C_DPS_422;
 	/* This flag will show if the initialization was successful */
 	m_initFail = 0U;
@@ -33,9 +107,18 @@ void DPS_422_Init (cyhal_i2c_t *I2C_DPS_422)
 
 	cyhal_system_delay_ms(50);
 
+	/* Mirror the configuration registers, all further bitfield writes go to the shadow */
+	m_shadowValid = 0U;
+	if (DPS_422_loadShadow() < 0)
+	{
+		m_initFail = 1U;
+		return;
+	}
+
 	/* Read pressure calibration coefficients */
 	/* Sets TEMP_CFG[7] to '1' to configure the temperature measurement correctly */
-	if (DPS_422_readcoeffs() < 0 || DPS_422_writeByteBitfield_reg(0x01, registers[MUST_SET]) < 0)
+	DPS_422_writeByteBitfield_reg(0x01, registers[MUST_SET]);
+	if (DPS_422_readcoeffs() < 0 || DPS_422_flushShadow(0U) < 0)
 	{
 		m_initFail = 1U;
 		return;
@@ -56,6 +139,7 @@ void DPS_422_Init (cyhal_i2c_t *I2C_DPS_422)
 *******************************************************************************/
 int16_t DPS_422_standby(void)
 {
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_STANDBY);
 	/* Abort if initialization failed */
 	if (m_initFail)
 	{
@@ -86,6 +170,11 @@ int16_t DPS_422_setOpMode(uint8_t opMode)
 	{
 		return DPS_FAIL;
 	}
+	/* Pending configuration changes are written together with the new mode */
+	if (DPS_422_flushShadow(0U) != DPS_SUCCESS)
+	{
+		return DPS_FAIL;
+	}
 	m_opMode = (enum Mode)opMode;
 	return DPS_SUCCESS;
 }
@@ -115,10 +204,29 @@ void DPS_422_getTwosComplement(int32_t *raw, uint8_t length)
 *
 *******************************************************************************/
 int16_t DPS_422_configTemp(uint8_t tempMr, uint8_t tempOsr)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_CONFIG_TEMP);
+	if (DPS_422_setTempConfig(tempMr, tempOsr) != DPS_SUCCESS)
+	{
+		return DPS_FAIL;
+	}
+	return DPS_422_flushShadow(0U);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_setTempConfig
+********************************************************************************
+*
+* Summary:
+*  This function updates the temperature measurement and oversampling rate in
+*  the register shadow only. The next flush writes them to the sensor.
+*
+*******************************************************************************/
+static int16_t DPS_422_setTempConfig(uint8_t tempMr, uint8_t tempOsr)
 {
 	tempMr &= 0x07;
 	tempOsr &= 0x07;
-	/* Two accesses to the same register; for readability */
+	/* Two accesses to the same register; for readability, the shadow turns them into one write */
 	int16_t ret = DPS_422_writeByteBitfield_reg(tempMr, config_registers[TEMP_MR]);
 	ret = DPS_422_writeByteBitfield_reg(tempOsr, config_registers[TEMP_OSR]);
 
@@ -142,6 +250,25 @@ int16_t DPS_422_configTemp(uint8_t tempMr, uint8_t tempOsr)
 *
 *******************************************************************************/
 int16_t DPS_422_configPressure(uint8_t prsMr, uint8_t prsOsr)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_CONFIG_PRESSURE);
+	if (DPS_422_setPressureConfig(prsMr, prsOsr) != DPS_SUCCESS)
+	{
+		return DPS_FAIL;
+	}
+	return DPS_422_flushShadow(0U);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_setPressureConfig
+********************************************************************************
+*
+* Summary:
+*  This function updates the pressure measurement and oversampling rate in the
+*  register shadow only. The next flush writes them to the sensor.
+*
+*******************************************************************************/
+static int16_t DPS_422_setPressureConfig(uint8_t prsMr, uint8_t prsOsr)
 {
 	prsMr &= 0x07;
 	prsOsr &= 0x07;
@@ -213,7 +340,10 @@ int16_t DPS_422_correctTemp(void)
 *******************************************************************************/
 float DPS_422_calcTemp(int32_t raw)
 {
-	m_lastTempScal = (float)raw / 1048576;
+	/* Keep the fixed-point copy in sync, so both pressure paths can follow */
+	DPS_422_updateTempFixed(raw);
+
+	m_lastTempScal = (float)raw / DPS422_TEMP_RAW_SCALE;
 	float u = m_lastTempScal / (1 + DPS422_ALPHA * m_lastTempScal);
 	return ((a_prime * u) + b_prime);
 }
@@ -238,6 +368,144 @@ float DPS_422_calcPressure(int32_t raw_prs)
 	return prs;
 }
 
+/*******************************************************************************
+* Function Name: DPS_422_calcPressureBatch
+********************************************************************************
+*
+* Summary:
+*  This function calculates the final pressure values of count raw sensor
+*  values, e.g. read from the FIFO, with the last measured temperature. All
+*  temperature dependent terms are calculated once per call.
+*
+*******************************************************************************/
+void DPS_422_calcPressureBatch(const int32_t *raw_prs, float *result, uint8_t count)
+{
+	const float temp = (8.5f * m_lastTempScal) / (1 + 8.8f * m_lastTempScal);
+	const float scale = 1.0f / DPS_422_scaling_facts[m_prsOsr];
+
+	/* Polynomial in prs, coefficients only depend on the temperature */
+	const float a0 = m_c00 + temp * (m_c01 + temp * m_c02);
+	const float a1 = m_c10 + temp * (m_c11 + temp * m_c12);
+	const float a2 = m_c20 + temp * m_c21;
+	const float a3 = m_c30;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		float prs = raw_prs[i] * scale;
+		result[i] = a0 + prs * (a1 + prs * (a2 + prs * a3));
+	}
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_updateTempFixed
+********************************************************************************
+*
+* Summary:
+*  This function stores the scaled raw temperature in Q20 and derives the
+*  temperature term of the pressure compensation from it. The division is
+*  done once per temperature value instead of once per pressure value.
+*
+*******************************************************************************/
+void DPS_422_updateTempFixed(int32_t raw)
+{
+	/* raw / DPS422_TEMP_RAW_SCALE is the scaled temperature, so raw already is its Q20 value */
+	m_lastTempScalQ = raw;
+
+	/* 8.5 * T / (1 + 8.8 * T) */
+	int64_t num = ((int64_t)17 * raw) << (DPS__SCAL_FRAC_BITS - 1);
+	int64_t den = ((int64_t)1 << DPS__SCAL_FRAC_BITS) + ((int64_t)44 * raw) / 5;
+	m_lastTempCompQ = (int32_t)(num / den);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_calcTempFixed
+********************************************************************************
+*
+* Summary:
+*  This function calculates the final temperature value from raw sensor data
+*  without floating point. The result is in degree Celsius, Q8.
+*
+*******************************************************************************/
+int32_t DPS_422_calcTempFixed(int32_t raw)
+{
+	DPS_422_updateTempFixed(raw);
+	m_lastTempScal = (float)raw / DPS422_TEMP_RAW_SCALE;
+
+	/* u = T / (1 + alpha * T) */
+	int64_t den = ((int64_t)1 << DPS__SCAL_FRAC_BITS) + DPS__ROUND_SHIFT(DPS422_ALPHA_Q * raw, DPS__SCAL_FRAC_BITS);
+	int64_t u = ((int64_t)raw << DPS__SCAL_FRAC_BITS) / den;
+
+	return (int32_t)DPS__ROUND_SHIFT(a_prime_q * u, DPS__SCAL_FRAC_BITS) + b_prime_q;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_calcPressureTerms
+********************************************************************************
+*
+* Summary:
+*  This function folds the temperature dependent terms of the pressure
+*  polynomial into four Q12 coefficients.
+*
+*******************************************************************************/
+static void DPS_422_calcPressureTerms(DPS_422_prsTerms_t *terms)
+{
+	int64_t temp = m_lastTempCompQ;
+	int64_t inner;
+
+	terms->a3 = (int64_t)m_c30 << DPS__ACC_FRAC_BITS;
+	terms->a2 = ((int64_t)m_c20 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(m_c21 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+	inner = ((int64_t)m_c11 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(m_c12 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+	terms->a1 = ((int64_t)m_c10 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(inner * temp, DPS__SCAL_FRAC_BITS);
+	inner = ((int64_t)m_c01 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(m_c02 * temp, DPS__SCAL_FRAC_BITS - DPS__ACC_FRAC_BITS);
+	terms->a0 = ((int64_t)m_c00 << DPS__ACC_FRAC_BITS) + DPS__ROUND_SHIFT(inner * temp, DPS__SCAL_FRAC_BITS);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_calcPressureFixed
+********************************************************************************
+*
+* Summary:
+*  This function calculates the final pressure value from raw sensor data
+*  without floating point. The result is in Pascal, Q8.
+*
+*******************************************************************************/
+int32_t DPS_422_calcPressureFixed(int32_t raw_prs)
+{
+	int32_t prs;
+	DPS_422_calcPressureBatchFixed(&raw_prs, &prs, 1U);
+	return prs;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_calcPressureBatchFixed
+********************************************************************************
+*
+* Summary:
+*  This function calculates the final pressure values of count raw sensor
+*  values without floating point, results are in Pascal, Q8. The temperature
+*  dependent terms are calculated once per call, every value then only needs
+*  a three step Horner scheme.
+*
+*******************************************************************************/
+void DPS_422_calcPressureBatchFixed(const int32_t *raw_prs, int32_t *result, uint8_t count)
+{
+	DPS_422_prsTerms_t terms;
+	DPS_422_calcPressureTerms(&terms);
+	const int32_t recip = DPS_422_scaling_recips[m_prsOsr];
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		int64_t prs = DPS__ROUND_SHIFT((int64_t)raw_prs[i] * recip, 48 - DPS__SCAL_FRAC_BITS);
+
+		int64_t acc = terms.a3;
+		acc = terms.a2 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+		acc = terms.a1 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+		acc = terms.a0 + DPS__ROUND_SHIFT(acc * prs, DPS__SCAL_FRAC_BITS);
+
+		result[i] = (int32_t)DPS__ROUND_SHIFT(acc, DPS__ACC_FRAC_BITS - DPS__PRS_FRAC_BITS);
+	}
+}
+
 /*******************************************************************************
 * Function Name: DPS_422_getSingleResult
 ********************************************************************************
@@ -278,26 +546,46 @@ int16_t DPS_422_getSingleResult(float *result)
 		case 0: /* Ready flag not set, measurement still in progress */
 			return DPS_FAIL;
 		case 1: /* Measurement ready, expected case */
+			return DPS_422_readSingleResult(result);
+	}
+	return DPS_FAIL;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_readSingleResult
+********************************************************************************
+*
+* Summary:
+*  This function reads the raw data of a finished one shot measurement and
+*  calculates the final temperature/pressure value. The ready bit has to be
+*  checked by the caller.
+*
+*******************************************************************************/
+int16_t DPS_422_readSingleResult(float *result)
+{
+	enum Mode oldMode = m_opMode;
+	m_opMode = IDLE; /* Operation mode was automatically reseted by DPS422 */
+	m_shadow[DPS422__REG_ADR_MEAS_CFG - DPS422__SHADOW_FIRST_REG] &= ~config_registers[MSR_CTRL].mask;
+	int32_t raw_val = 0;
+	switch (oldMode)
+	{
+	case CMD_TEMP: /* temperature */
+		if (DPS_422_getRawResult(&raw_val, registerBlocks[TEMP]) != DPS_SUCCESS)
 		{
-			enum Mode oldMode = m_opMode;
-			m_opMode = IDLE; /* Operation mode was automatically reseted by DPS422 */
-			int32_t raw_val = 0;
-			switch (oldMode)
-			{
-			case CMD_TEMP: /* temperature */
-				DPS_422_getRawResult(&raw_val, registerBlocks[TEMP]);
-				*result = DPS_422_calcTemp(raw_val);
-				return DPS_SUCCESS;
-			case CMD_PRS: /* pressure */
-				DPS_422_getRawResult(&raw_val, registerBlocks[PRS]);
-				*result = DPS_422_calcPressure(raw_val);
-				return DPS_SUCCESS;
-			default:
-				return DPS_FAIL; /* Should already be filtered above */
-			}
+			return DPS_FAIL;
 		}
+		*result = DPS_422_calcTemp(raw_val);
+		return DPS_SUCCESS;
+	case CMD_PRS: /* pressure */
+		if (DPS_422_getRawResult(&raw_val, registerBlocks[PRS]) != DPS_SUCCESS)
+		{
+			return DPS_FAIL;
+		}
+		*result = DPS_422_calcPressure(raw_val);
+		return DPS_SUCCESS;
+	default:
+		return DPS_FAIL; /* Should already be filtered above */
 	}
-	return DPS_FAIL;
 }
 
 /*******************************************************************************
@@ -330,6 +618,7 @@ int16_t DPS_422_getRawResult(int32_t *raw, RegBlock_t reg)
 *******************************************************************************/
 int16_t DPS_422_measureTempOnceOversamplingRate(float *result, uint8_t oversamplingRate)
 {
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_MEASURE_TEMP);
 	/* Start measurement */
 	int16_t ret = DPS_422_setModeTempMeasurementOneShot(oversamplingRate);
 	if (ret != DPS_SUCCESS)
@@ -374,13 +663,13 @@ int16_t DPS_422_setModeTempMeasurementOneShot(uint8_t oversamplingRate)
 	if (oversamplingRate != m_tempOsr)
 	{
 		/* Configuration of oversampling rate, and lowest measure rate to avoid conflicts */
-		if (DPS_422_configTemp(0U, oversamplingRate) != DPS_SUCCESS)
+		if (DPS_422_setTempConfig(0U, oversamplingRate) != DPS_SUCCESS)
 		{
 			return DPS_FAIL;
 		}
 	}
 
-	/* Set device to temperature measuring mode */
+	/* Set device to temperature measuring mode, configuration is written along with it */
 	return DPS_422_setOpMode(CMD_TEMP);
 }
 
@@ -395,6 +684,7 @@ int16_t DPS_422_setModeTempMeasurementOneShot(uint8_t oversamplingRate)
 *******************************************************************************/
 int16_t DPS_422_measurePressureOnceOversamplingRate(float* result, uint8_t oversamplingRate)
 {
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_MEASURE_PRESSURE);
 	/* Start the measurement */
 	/* Set oversampling rate */
 	/* Set mode of operation to one shot pressure measurement */
@@ -440,15 +730,352 @@ int16_t DPS_422_setModePressureMeasurementOneShot(uint8_t oversamplingRate)
 	/* Configuration of oversampling rate, and lowest measure rate to avoid conflicts */
 	if (oversamplingRate != m_prsOsr)
 	{
-		if (DPS_422_configPressure(0U, oversamplingRate))
+		if (DPS_422_setPressureConfig(0U, oversamplingRate))
 		{
 			return DPS_FAIL;
 		}
 	}
-	/* Set device to pressure measuring mode */
+	/* Set device to pressure measuring mode, configuration is written along with it */
 	return DPS_422_setOpMode(CMD_PRS);
 }
 
+/*******************************************************************************
+* Function Name: DPS_422_measureBothOnceOversamplingRate
+********************************************************************************
+*
+* Summary:
+*  This function lets the sensor measure temperature and pressure in one
+*  conversion cycle and reads both results with a single burst read. The fresh
+*  temperature compensates the pressure right away.
+*
+*******************************************************************************/
+int16_t DPS_422_measureBothOnceOversamplingRate(float *temperature, float *pressure, uint8_t tempOsr, uint8_t prsOsr)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_MEASURE_BOTH);
+	int16_t ret = DPS_422_setModeBothMeasurementOneShot(tempOsr, prsOsr);
+	if (ret != DPS_SUCCESS)
+	{
+		return ret;
+	}
+
+	/* The sensor converts temperature first, then pressure */
+	cyhal_system_delay_ms((DPS_422_calcBusyTime(0U, m_tempOsr) + DPS_422_calcBusyTime(0U, m_prsOsr)) / DPS__BUSYTIME_SCALING);
+	cyhal_system_delay_ms(DPS_422__BUSYTIME_FAILSAFE);
+
+	ret = DPS_422_getBothResult(temperature, pressure);
+	if (ret != DPS_SUCCESS)
+	{
+		DPS_422_standby();
+	}
+	return ret;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_setModeBothMeasurementOneShot
+********************************************************************************
+*
+* Summary:
+*  This function sets the operation mode of the sensor to one shot temperature
+*  and pressure measurement.
+*
+*******************************************************************************/
+int16_t DPS_422_setModeBothMeasurementOneShot(uint8_t tempOsr, uint8_t prsOsr)
+{
+	/* Abort if initialization failed */
+	if (m_initFail)
+	{
+		return DPS_FAIL;
+	}
+	/* Abort if device is not in idling mode */
+	if (m_opMode != IDLE)
+	{
+		return DPS_FAIL;
+	}
+	/* Both configurations only go to the shadow, the mode write flushes them */
+	if ((tempOsr != m_tempOsr) && (DPS_422_setTempConfig(0U, tempOsr) != DPS_SUCCESS))
+	{
+		return DPS_FAIL;
+	}
+	if ((prsOsr != m_prsOsr) && (DPS_422_setPressureConfig(0U, prsOsr) != DPS_SUCCESS))
+	{
+		return DPS_FAIL;
+	}
+	return DPS_422_setOpMode(CMD_BOTH);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_readBothResult
+********************************************************************************
+*
+* Summary:
+*  This function reads the pressure and temperature result registers in one
+*  burst and calculates both final values, temperature first.
+*
+*******************************************************************************/
+static int16_t DPS_422_readBothResult(float *temperature, float *pressure)
+{
+	uint8_t buffer[DPS__BOTH_RESULT_BLOCK_LENGTH] = {0};
+	if (DPS_422_readBlock(bothResultBlock, buffer) != DPS__BOTH_RESULT_BLOCK_LENGTH)
+	{
+		return DPS_FAIL;
+	}
+
+	int32_t raw_prs = (uint32_t)buffer[0] << 16 | (uint32_t)buffer[1] << 8 | (uint32_t)buffer[2];
+	int32_t raw_temp = (uint32_t)buffer[3] << 16 | (uint32_t)buffer[4] << 8 | (uint32_t)buffer[5];
+	DPS_422_getTwosComplement(&raw_prs, 24);
+	DPS_422_getTwosComplement(&raw_temp, 24);
+
+	/* Updates m_lastTempScal, which the pressure calculation uses */
+	*temperature = DPS_422_calcTemp(raw_temp);
+	*pressure = DPS_422_calcPressure(raw_prs);
+	return DPS_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_getBothResult
+********************************************************************************
+*
+* Summary:
+*  This function provides the final temperature and pressure value of a one
+*  shot measurement started with DPS_422_setModeBothMeasurementOneShot. Both
+*  ready bits are checked with one read.
+*
+*******************************************************************************/
+int16_t DPS_422_getBothResult(float *temperature, float *pressure)
+{
+	if (m_initFail || (m_opMode != CMD_BOTH))
+	{
+		return DPS_FAIL;
+	}
+
+	/* TEMP_RDY and PRS_RDY are both in MEAS_CFG */
+	int16_t status = DPS_422_readByte(DPS422__REG_ADR_MEAS_CFG);
+	if (status < 0)
+	{
+		return DPS_FAIL;
+	}
+	if (!(status & config_registers[TEMP_RDY].mask) || !(status & config_registers[PRS_RDY].mask))
+	{
+		return DPS_FAIL;
+	}
+
+	m_opMode = IDLE; /* Operation mode was automatically reseted by DPS422 */
+	m_shadow[DPS422__REG_ADR_MEAS_CFG - DPS422__SHADOW_FIRST_REG] &= ~config_registers[MSR_CTRL].mask;
+	return DPS_422_readBothResult(temperature, pressure);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_startMeasureBothCont
+********************************************************************************
+*
+* Summary:
+*  This function starts continuous temperature and pressure measurement. The
+*  FIFO stays disabled, so the result registers always hold the latest pair.
+*
+*******************************************************************************/
+int16_t DPS_422_startMeasureBothCont(uint8_t tempMr, uint8_t tempOsr, uint8_t prsMr, uint8_t prsOsr)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_START_CONT);
+	/* Abort if initialization failed */
+	if (m_initFail)
+	{
+		return DPS_FAIL;
+	}
+	/* Abort if device is not in idling mode */
+	if (m_opMode != IDLE)
+	{
+		return DPS_FAIL;
+	}
+	/* Both conversions have to fit into one second */
+	if (DPS_422_calcBusyTime(tempMr, tempOsr) + DPS_422_calcBusyTime(prsMr, prsOsr) >= DPS310__MAX_BUSYTIME)
+	{
+		return DPS_FAIL;
+	}
+	if ((DPS_422_setTempConfig(tempMr, tempOsr) != DPS_SUCCESS)
+			|| (DPS_422_setPressureConfig(prsMr, prsOsr) != DPS_SUCCESS))
+	{
+		return DPS_FAIL;
+	}
+	return DPS_422_setOpMode(CONT_BOTH);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_getContBothResult
+********************************************************************************
+*
+* Summary:
+*  This function reads the latest temperature and pressure pair of the
+*  continuous measurement. It returns DPS_BUSY if no new pressure result has
+*  arrived since the last call.
+*
+*******************************************************************************/
+int16_t DPS_422_getContBothResult(float *temperature, float *pressure)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_GET_CONT);
+	if (m_initFail || (m_opMode != CONT_BOTH))
+	{
+		return DPS_FAIL;
+	}
+
+	int16_t rdy = DPS_422_readByteBitfield(config_registers[PRS_RDY]);
+	if (rdy < 0)
+	{
+		return DPS_FAIL;
+	}
+	if (rdy == 0)
+	{
+		return DPS_BUSY;
+	}
+	return DPS_422_readBothResult(temperature, pressure);
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_startMeasureTempAsync
+********************************************************************************
+*
+* Summary:
+*  This function starts a one shot temperature measurement and returns without
+*  waiting for the result. The result is fetched by DPS_422_pollAsync, which
+*  calls the callback (can be NULL) once the measurement is finished.
+*
+*******************************************************************************/
+int16_t DPS_422_startMeasureTempAsync(uint8_t oversamplingRate, DPS_422_measureCallback_t callback)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_START_ASYNC);
+	/* Only one measurement can be in progress at a time */
+	if (m_asyncState == DPS_422_ASYNC_BUSY)
+	{
+		return DPS_FAIL;
+	}
+	int16_t ret = DPS_422_setModeTempMeasurementOneShot(oversamplingRate);
+	if (ret != DPS_SUCCESS)
+	{
+		return ret;
+	}
+	m_asyncCallback = callback;
+	m_asyncState = DPS_422_ASYNC_BUSY;
+	return DPS_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_startMeasurePressureAsync
+********************************************************************************
+*
+* Summary:
+*  This function starts a one shot pressure measurement and returns without
+*  waiting for the result. The result is fetched by DPS_422_pollAsync, which
+*  calls the callback (can be NULL) once the measurement is finished.
+*
+*******************************************************************************/
+int16_t DPS_422_startMeasurePressureAsync(uint8_t oversamplingRate, DPS_422_measureCallback_t callback)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_START_ASYNC);
+	/* Only one measurement can be in progress at a time */
+	if (m_asyncState == DPS_422_ASYNC_BUSY)
+	{
+		return DPS_FAIL;
+	}
+	int16_t ret = DPS_422_setModePressureMeasurementOneShot(oversamplingRate);
+	if (ret != DPS_SUCCESS)
+	{
+		return ret;
+	}
+	m_asyncCallback = callback;
+	m_asyncState = DPS_422_ASYNC_BUSY;
+	return DPS_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_getConversionTime
+********************************************************************************
+*
+* Summary:
+*  This function returns the time in milliseconds the running one shot
+*  measurement is expected to take. It can be used to arm a timer or to put
+*  the CPU to sleep before calling DPS_422_pollAsync.
+*
+*******************************************************************************/
+uint16_t DPS_422_getConversionTime(void)
+{
+	switch (m_opMode)
+	{
+	case CMD_TEMP:
+		return DPS_422_calcBusyTime(0U, m_tempOsr) / DPS__BUSYTIME_SCALING + DPS_422__BUSYTIME_FAILSAFE;
+	case CMD_PRS:
+		return DPS_422_calcBusyTime(0U, m_prsOsr) / DPS__BUSYTIME_SCALING + DPS_422__BUSYTIME_FAILSAFE;
+	case CMD_BOTH:
+		return (DPS_422_calcBusyTime(0U, m_tempOsr) + DPS_422_calcBusyTime(0U, m_prsOsr)) / DPS__BUSYTIME_SCALING
+				+ DPS_422__BUSYTIME_FAILSAFE;
+	default:
+		return 0U;
+	}
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_pollAsync
+********************************************************************************
+*
+* Summary:
+*  This function checks the ready bit of the measurement started with
+*  DPS_422_startMeasureTempAsync or DPS_422_startMeasurePressureAsync. It
+*  returns DPS_BUSY while the measurement is in progress. Once the result is
+*  ready, it is read, written to result (can be NULL) and passed to the
+*  callback.
+*
+*******************************************************************************/
+int16_t DPS_422_pollAsync(float *result)
+{
+	DPS_422_TRACE_SCOPE(DPS_422_TRACE_POLL_ASYNC);
+	/* Nothing to poll if no measurement was started */
+	if (m_asyncState != DPS_422_ASYNC_BUSY)
+	{
+		return DPS_FAIL;
+	}
+
+	enum Mode mode = m_opMode;
+	int16_t rdy;
+	switch (mode)
+	{
+	case CMD_TEMP: /* temperature */
+		rdy = DPS_422_readByteBitfield(config_registers[TEMP_RDY]);
+		break;
+	case CMD_PRS: /* pressure */
+		rdy = DPS_422_readByteBitfield(config_registers[PRS_RDY]);
+		break;
+	default: /* Measurement was aborted, e.g. by DPS_422_standby */
+		rdy = DPS_FAIL;
+		break;
+	}
+	/* Measurement still in progress */
+	if (rdy == 0)
+	{
+		return DPS_BUSY;
+	}
+
+	float value = 0;
+	int16_t ret = DPS_FAIL;
+	if (rdy == 1)
+	{
+		ret = DPS_422_readSingleResult(&value);
+	}
+	if (ret != DPS_SUCCESS)
+	{
+		DPS_422_standby();
+	}
+	if (result != NULL)
+	{
+		*result = value;
+	}
+
+	/* Clear the state first, so the callback can start the next measurement */
+	m_asyncState = DPS_422_ASYNC_IDLE;
+	if (m_asyncCallback != NULL)
+	{
+		m_asyncCallback(mode, ret, value);
+	}
+	return ret;
+}
+
 /*******************************************************************************
 * Function Name: DPS_422_flushFIFO
 ********************************************************************************
@@ -460,7 +1087,8 @@ int16_t DPS_422_setModePressureMeasurementOneShot(uint8_t oversamplingRate)
 *******************************************************************************/
 int16_t DPS_422_flushFIFO()
 {
-	return DPS_422_writeByteBitfield_reg(1U, registers[FIFO_FL]);
+	/* The RESET register is write only, so there is nothing to read-modify-write */
+	return DPS_422_writeByte(registers[FIFO_FL].regAddress, registers[FIFO_FL].mask, 0U);
 }
 
 /*******************************************************************************
@@ -476,7 +1104,11 @@ int16_t DPS_422_disableFIFO()
 {
 	int16_t ret = DPS_422_flushFIFO();
 	ret = DPS_422_writeByteBitfield_reg(0U, config_registers[FIFO_EN]);
-	return ret;
+	if (ret != DPS_SUCCESS)
+	{
+		return ret;
+	}
+	return DPS_422_flushShadow(0U);
 }
 
 /*******************************************************************************
@@ -497,11 +1129,31 @@ int16_t DPS_422_writeByteBitfield_reg(uint8_t data, RegMask_t regMask)
 ********************************************************************************
 *
 * Summary:
-*  This function writes to sensor registers.
+*  This function writes to specific bit fields of sensor registers. Bit fields
+*  of the configuration registers are only updated in the register shadow and
+*  written to the sensor by DPS_422_flushShadow, unless check is requested.
 *
 *******************************************************************************/
 int16_t DPS_422_writeByteBitfield(uint8_t data, uint8_t regAddress, uint8_t mask, uint8_t shift, uint8_t check)
 {
+	if (m_shadowValid && (regAddress >= DPS422__SHADOW_FIRST_REG)
+			&& (regAddress < DPS422__SHADOW_FIRST_REG + DPS422__SHADOW_NUM_REGS))
+	{
+		uint8_t idx = regAddress - DPS422__SHADOW_FIRST_REG;
+		uint8_t value = (m_shadow[idx] & ~mask) | ((data << shift) & mask);
+		/* MEAS_CFG is a command, it has to be written even if it did not change */
+		if ((value != m_shadow[idx]) || (regAddress == DPS422__REG_ADR_MEAS_CFG))
+		{
+			m_shadow[idx] = value;
+			m_shadowDirty |= (uint8_t)(1U << idx);
+		}
+		if (check)
+		{
+			return DPS_422_flushShadow(check);
+		}
+		return DPS_SUCCESS;
+	}
+
 	int16_t old = DPS_422_readByte(regAddress);
 	if (old < 0)
 	{
@@ -511,6 +1163,67 @@ int16_t DPS_422_writeByteBitfield(uint8_t data, uint8_t regAddress, uint8_t mask
 	return DPS_422_writeByte(regAddress, ((uint8_t)old & ~mask) | ((data << shift) & mask), check);
 }
 
+/*******************************************************************************
+* Function Name: DPS_422_loadShadow
+********************************************************************************
+*
+* Summary:
+*  This function reads all configuration registers with one block read into
+*  the register shadow.
+*
+*******************************************************************************/
+int16_t DPS_422_loadShadow(void)
+{
+	RegBlock_t shadowBlock = {DPS422__SHADOW_FIRST_REG, DPS422__SHADOW_NUM_REGS};
+
+	m_shadowValid = 0U;
+	if (DPS_422_readBlock(shadowBlock, m_shadow) != DPS422__SHADOW_NUM_REGS)
+	{
+		return DPS_FAIL;
+	}
+	/* Only the measurement control bits of MEAS_CFG are writable, the rest are status flags */
+	m_shadow[DPS422__REG_ADR_MEAS_CFG - DPS422__SHADOW_FIRST_REG] &= config_registers[MSR_CTRL].mask;
+	m_shadowDirty = 0U;
+	m_shadowValid = 1U;
+	return DPS_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_flushShadow
+********************************************************************************
+*
+* Summary:
+*  This function writes every changed register of the register shadow to the
+*  sensor, one write per register. MEAS_CFG is written last, as it starts the
+*  measurement the other registers configure. With check set, every written
+*  register except MEAS_CFG is read back and compared.
+*
+*******************************************************************************/
+int16_t DPS_422_flushShadow(uint8_t check)
+{
+	const uint8_t order[DPS422__SHADOW_NUM_REGS] = {0x06, 0x07, 0x09, DPS422__REG_ADR_MEAS_CFG};
+	int16_t ret = DPS_SUCCESS;
+
+	for (uint8_t i = 0; i < DPS422__SHADOW_NUM_REGS; i++)
+	{
+		uint8_t idx = order[i] - DPS422__SHADOW_FIRST_REG;
+		if (!(m_shadowDirty & (1U << idx)))
+		{
+			continue;
+		}
+		/* MEAS_CFG reads back with status flags, it cannot be checked */
+		uint8_t regCheck = (order[i] == DPS422__REG_ADR_MEAS_CFG) ? 0U : check;
+		if (DPS_422_writeByte(order[i], m_shadow[idx], regCheck) != DPS_SUCCESS)
+		{
+			/* Register stays dirty and is written again with the next flush */
+			ret = DPS_FAIL;
+			continue;
+		}
+		m_shadowDirty &= (uint8_t)~(1U << idx);
+	}
+	return ret;
+}
+
 /*******************************************************************************
 * Function Name: DPS_422_writeByte
 ********************************************************************************
@@ -522,7 +1235,9 @@ int16_t DPS_422_writeByteBitfield(uint8_t data, uint8_t regAddress, uint8_t mask
 int16_t DPS_422_writeByte(uint8_t regAddress, uint8_t data, uint8_t check)
 {
 	cy_rslt_t result;
+	DPS_422_TRACE_BUS_START();
 	result = cyhal_i2c_master_mem_write(I2C_ptr, DPS__STD_SLAVE_ADDRESS, regAddress, 0x01, &data, 1, 200);
+	DPS_422_TRACE_BUS_END(DPS_422_TRACE_WRITE, regAddress, 1U);
 	if(result == CY_RSLT_SUCCESS)
 	{
 		if (check == 0)
@@ -540,7 +1255,7 @@ int16_t DPS_422_writeByte(uint8_t regAddress, uint8_t data, uint8_t check)
 		}
 	}
 	else
-		return result;
+		return DPS_FAIL;
 }
 
 /*******************************************************************************
@@ -573,7 +1288,9 @@ int16_t DPS_422_readByte(uint8_t regAddress)
 {
 	cy_rslt_t result;
 	uint8_t value;
+	DPS_422_TRACE_BUS_START();
 	result = cyhal_i2c_master_mem_read(I2C_ptr, DPS__STD_SLAVE_ADDRESS, regAddress, 1, &value, 1, 200);
+	DPS_422_TRACE_BUS_END(DPS_422_TRACE_READ, regAddress, 1U);
 	if(result == CY_RSLT_SUCCESS)
 	{
 		return value;
@@ -623,6 +1340,9 @@ int16_t DPS_422_readcoeffs(void)
 	// 7. calculate A' and B'
 	a_prime = DPS422_A_0 * (Vbe_cal + DPS422_ALPHA * dVbe_cal) * (1 + k_ptat);
 	b_prime = -273.15 * (1 + k_ptat) - k_ptat * T_calib;
+	/* Q8 copies for the fixed-point temperature calculation */
+	a_prime_q = (int32_t)(a_prime * (1 << DPS__TEMP_FRAC_BITS) + (a_prime < 0 ? -0.5f : 0.5f));
+	b_prime_q = (int32_t)(b_prime * (1 << DPS__TEMP_FRAC_BITS) + (b_prime < 0 ? -0.5f : 0.5f));
 
 	// c00, c01, c02, c10 : 20 bits
 	// c11, c12: 17 bits
@@ -667,7 +1387,9 @@ int16_t DPS_422_readBlock(RegBlock_t regBlock, uint8_t *buffer)
 	}
 
 	cy_rslt_t result;
+	DPS_422_TRACE_BUS_START();
 	result = cyhal_i2c_master_mem_read(I2C_ptr, DPS__STD_SLAVE_ADDRESS, regBlock.regAddress, 1, buffer, regBlock.length, 200);
+	DPS_422_TRACE_BUS_END(DPS_422_TRACE_READ, regBlock.regAddress, regBlock.length);
 	if(result == CY_RSLT_SUCCESS)
 	{
 		return regBlock.length;
@@ -10,43 +10,59 @@
 #define DPS_DPS422_H_
 
 #include "dps422_config.h"
+#include "dps422_trace.h"
 
 /*******************************************************************************
  * Global variable
  *******************************************************************************/
 /* Flags */
-uint8_t m_initFail;
+extern uint8_t m_initFail;
 
 /* Settings */
-uint8_t m_tempMr;
-uint8_t m_tempOsr;
-uint8_t m_prsMr;
-uint8_t m_prsOsr;
+extern uint8_t m_tempMr;
+extern uint8_t m_tempOsr;
+extern uint8_t m_prsMr;
+extern uint8_t m_prsOsr;
 
 /* Compensation coefficients */
-int32_t m_c00;
-int32_t m_c10;
-int32_t m_c01;
-int32_t m_c11;
-int32_t m_c20;
-int32_t m_c21;
-int32_t m_c30;
+extern int32_t m_c00;
+extern int32_t m_c10;
+extern int32_t m_c01;
+extern int32_t m_c11;
+extern int32_t m_c20;
+extern int32_t m_c21;
+extern int32_t m_c30;
 
 /* Compensation coefficients (for simplicity use 32 bits) */
-float a_prime;
-float b_prime;
-int32_t m_c02;
-int32_t m_c12;
+extern float a_prime;
+extern float b_prime;
+extern int32_t m_c02;
+extern int32_t m_c12;
+
+/* Q8 copies of a_prime and b_prime for the fixed-point path */
+extern int32_t a_prime_q;
+extern int32_t b_prime_q;
 
 /* Last measured scaled temperature (necessary for pressure compensation) */
-float m_lastTempScal;
+extern float m_lastTempScal;
+extern int32_t m_lastTempScalQ; 	/* same in Q20 */
+extern int32_t m_lastTempCompQ; 	/* 8.5 * T / (1 + 8.8 * T) in Q20 */
 
 /* Bus specific */
-uint8_t m_SpiI2c; 			/* 0=SPI, 1=I2C */
+extern uint8_t m_SpiI2c; 			/* 0=SPI, 1=I2C */
+
+extern cyhal_i2c_t *I2C_ptr;
+
+extern enum Mode m_opMode;
 
-cyhal_i2c_t *I2C_ptr;
+/* RAM copy of the configuration registers, dirty ones are written by DPS_422_flushShadow */
+extern uint8_t m_shadow[DPS422__SHADOW_NUM_REGS];
+extern uint8_t m_shadowDirty;
+extern uint8_t m_shadowValid;
 
-enum Mode m_opMode;
+/* Asynchronous measurement */
+extern DPS_422_measureCallback_t m_asyncCallback;
+extern enum DPS_422_AsyncState_e m_asyncState;
 
 /*******************************************************************************
 * Function Prototypes
@@ -61,16 +77,33 @@ uint16_t DPS_422_calcBusyTime(uint16_t mr, uint16_t osr);
 int16_t DPS_422_correctTemp(void);
 float DPS_422_calcTemp(int32_t raw);
 float DPS_422_calcPressure(int32_t raw_prs);
+void DPS_422_calcPressureBatch(const int32_t *raw_prs, float *result, uint8_t count);
+void DPS_422_updateTempFixed(int32_t raw);
+int32_t DPS_422_calcTempFixed(int32_t raw);
+int32_t DPS_422_calcPressureFixed(int32_t raw_prs);
+void DPS_422_calcPressureBatchFixed(const int32_t *raw_prs, int32_t *result, uint8_t count);
 int16_t DPS_422_getSingleResult(float *result);
+int16_t DPS_422_readSingleResult(float *result);
 int16_t DPS_422_getRawResult(int32_t *raw, RegBlock_t reg);
 int16_t DPS_422_measureTempOnceOversamplingRate(float *result, uint8_t oversamplingRate);
 int16_t DPS_422_setModeTempMeasurementOneShot(uint8_t oversamplingRate);
 int16_t DPS_422_measurePressureOnceOversamplingRate(float* result, uint8_t oversamplingRate);
 int16_t DPS_422_setModePressureMeasurementOneShot(uint8_t oversamplingRate);
+int16_t DPS_422_measureBothOnceOversamplingRate(float *temperature, float *pressure, uint8_t tempOsr, uint8_t prsOsr);
+int16_t DPS_422_setModeBothMeasurementOneShot(uint8_t tempOsr, uint8_t prsOsr);
+int16_t DPS_422_getBothResult(float *temperature, float *pressure);
+int16_t DPS_422_startMeasureBothCont(uint8_t tempMr, uint8_t tempOsr, uint8_t prsMr, uint8_t prsOsr);
+int16_t DPS_422_getContBothResult(float *temperature, float *pressure);
+int16_t DPS_422_startMeasureTempAsync(uint8_t oversamplingRate, DPS_422_measureCallback_t callback);
+int16_t DPS_422_startMeasurePressureAsync(uint8_t oversamplingRate, DPS_422_measureCallback_t callback);
+uint16_t DPS_422_getConversionTime(void);
+int16_t DPS_422_pollAsync(float *result);
 int16_t DPS_422_flushFIFO();
 int16_t DPS_422_disableFIFO();
 int16_t DPS_422_writeByteBitfield_reg(uint8_t data, RegMask_t regMask);
 int16_t DPS_422_writeByteBitfield(uint8_t data, uint8_t regAddress, uint8_t mask, uint8_t shift, uint8_t check);
+int16_t DPS_422_loadShadow(void);
+int16_t DPS_422_flushShadow(uint8_t check);
 int16_t DPS_422_writeByte(uint8_t regAddress, uint8_t data, uint8_t check);
 int16_t DPS_422_readByteBitfield(RegMask_t regMask);
 int16_t DPS_422_readByte(uint8_t regAddress);
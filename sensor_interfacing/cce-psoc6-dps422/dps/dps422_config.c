@@ -54,3 +54,5 @@ const RegBlock_t registerBlocks[2] = {
     {0x00, 3},
 };
 
+/* Pressure and temperature results are adjacent, one burst read returns both */
+const RegBlock_t bothResultBlock = {0x00, DPS__BOTH_RESULT_BLOCK_LENGTH};
@@ -19,11 +19,13 @@
  *******************************************************************************/
 #define DPS_SUCCESS					 0
 #define DPS_FAIL					 -1
+#define DPS_BUSY					 1
 
 /* Constants for temperature calculation */
 #define DPS422_T_REF 				 27
 #define DPS422_V_BE_TARGET 			 0.687027
 #define DPS422_ALPHA 				 9.45
+#define DPS422_ALPHA_Q				 ((int64_t)(DPS422_ALPHA * (1L << DPS__SCAL_FRAC_BITS) + 0.5)) 	/* Q20 */
 #define DPS422_T_C_VBE 				 -1.735e-3
 #define DPS422_K_PTAT_CORNER		 -0.8
 #define DPS422_K_PTAT_CURVATURE		  0.039
@@ -42,9 +44,15 @@
 #define DPS_422__BUSYTIME_FAILSAFE 	 10U
 #define DPS310__MAX_BUSYTIME 		 ((1000U - DPS_422__BUSYTIME_FAILSAFE) * DPS__BUSYTIME_SCALING)
 
+/* PRS_CFG, TEMP_CFG, MEAS_CFG and CFG_REG are mirrored in RAM */
+#define DPS422__SHADOW_FIRST_REG     0x06U
+#define DPS422__SHADOW_NUM_REGS      4U
+#define DPS422__REG_ADR_MEAS_CFG     0x08U
+
 #define DPS__FIFO_SIZE               32
 #define DPS__STD_SLAVE_ADDRESS       0x77U
 #define DPS__RESULT_BLOCK_LENGTH 	 3
+#define DPS__BOTH_RESULT_BLOCK_LENGTH 6	/* PSR_B2..PSR_B0 and TMP_B2..TMP_B0 in one read */
 #define NUM_OF_COMMON_REGMASKS		 16
 
 #define DPS__MEASUREMENT_RATE_1		 0
@@ -70,6 +78,23 @@
 
 #define DPS__NUM_OF_SCAL_FACTS		 8
 
+/* Fixed-point compensation: scaled raw values in Q20, intermediate sums in Q12,
+ * results in Q8 (1/256 Pa and 1/256 degree Celsius) */
+#define DPS__SCAL_FRAC_BITS			 20
+#define DPS__ACC_FRAC_BITS			 12
+#define DPS__PRS_FRAC_BITS			 8
+#define DPS__TEMP_FRAC_BITS			 8
+
+/* The scaled temperature is raw / 2^20, the fixed-point path takes the raw
+ * value as its Q20 copy as is, so the two scales have to stay equal */
+#define DPS422_TEMP_RAW_SCALE		 1048576
+#if DPS422_TEMP_RAW_SCALE != (1L << DPS__SCAL_FRAC_BITS)
+#error "DPS__SCAL_FRAC_BITS must match the raw temperature scale"
+#endif
+
+/* Arithmetic shift right with rounding to nearest */
+#define DPS__ROUND_SHIFT(value, bits) (((value) + ((int64_t)1 << ((bits) - 1))) >> (bits))
+
 /*******************************************************************************
  * Structure
  *******************************************************************************/
@@ -110,6 +135,18 @@ enum Mode
     CONT_BOTH = 0x07
 };
 
+enum DPS_422_AsyncState_e
+{
+    DPS_422_ASYNC_IDLE = 0,
+    DPS_422_ASYNC_BUSY,
+};
+
+/*******************************************************************************
+ * Callback
+ *******************************************************************************/
+/* Called from DPS_422_pollAsync once an asynchronous measurement is finished */
+typedef void (*DPS_422_measureCallback_t)(enum Mode mode, int16_t status, float result);
+
 enum Registers_e
 {
     /* flags */
@@ -159,5 +196,6 @@ extern const RegMask_t config_registers[NUM_OF_COMMON_REGMASKS];
 extern const RegMask_t registers[DPS422_NUM_OF_REGMASKS];
 extern const RegBlock_t coeffBlocks[4];
 extern const RegBlock_t registerBlocks[2];
+extern const RegBlock_t bothResultBlock;
 
 #endif /* DPS_DPS422_CONFIG_H_ */
@@ -0,0 +1,264 @@
+/******************************************************************************
+* File Name:  dps422_trace.c
+*
+* Description:  This file contains the optional bus transaction and latency
+*               instrumentation of the DPS422 driver. It is empty unless
+*               DPS_422_TRACE is set.
+*
+*******************************************************************************/
+
+#include "dps422_trace.h"
+
+#if DPS_422_TRACE
+
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Global variable
+*******************************************************************************/
+static const char *const traceScopeNames[DPS_422_TRACE_NUM_SCOPES] = {
+	"Init",
+	"configTemp",
+	"configPressure",
+	"measureTempOnce",
+	"measurePressureOnce",
+	"measureBothOnce",
+	"startMeasureAsync",
+	"pollAsync",
+	"startMeasureBothCont",
+	"getContBothResult",
+	"standby",
+};
+
+static const char *const traceBusNames[DPS_422_TRACE_NUM_BUS] = {
+	"read",
+	"write",
+};
+
+static DPS_422_traceStats_t traceScopes[DPS_422_TRACE_NUM_SCOPES];
+static DPS_422_traceStats_t traceBusStats[DPS_422_TRACE_NUM_BUS];
+static DPS_422_traceEntry_t traceLog[DPS_422_TRACE_LOG_SIZE];
+static uint32_t traceLogNext;
+
+/* Outermost open API call */
+static uint8_t traceDepth;
+static uint8_t traceScope = DPS_422_TRACE_NO_SCOPE;
+static uint32_t traceScopeStart;
+static uint32_t traceScopeTransactions;
+static uint32_t traceScopeBytes;
+
+/*******************************************************************************
+* Function Name: DPS_422_traceAddLatency
+********************************************************************************
+*
+* Summary:
+*  This function adds one latency to the minimum, maximum, sum and histogram.
+*
+*******************************************************************************/
+static void DPS_422_traceAddLatency(DPS_422_traceLatency_t *latency, uint32_t cycles)
+{
+	uint8_t bucket = 0U;
+	for (uint32_t v = cycles >> DPS_422_TRACE_HIST_SHIFT; v != 0U; v >>= 1)
+	{
+		bucket++;
+	}
+	if (bucket >= DPS_422_TRACE_HIST_BUCKETS)
+	{
+		bucket = DPS_422_TRACE_HIST_BUCKETS - 1U;
+	}
+
+	if ((latency->count == 0U) || (cycles < latency->min))
+	{
+		latency->min = cycles;
+	}
+	if (cycles > latency->max)
+	{
+		latency->max = cycles;
+	}
+	latency->count++;
+	latency->sum += cycles;
+	latency->hist[bucket]++;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceInit
+********************************************************************************
+*
+* Summary:
+*  This function starts the DWT cycle counter and clears the statistics.
+*
+*******************************************************************************/
+void DPS_422_traceInit(void)
+{
+	/* The cycle counter only runs with trace enabled */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0U;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	DPS_422_traceReset();
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceReset
+********************************************************************************
+*
+* Summary:
+*  This function clears the statistics and the transaction log.
+*
+*******************************************************************************/
+void DPS_422_traceReset(void)
+{
+	memset(traceScopes, 0, sizeof(traceScopes));
+	memset(traceBusStats, 0, sizeof(traceBusStats));
+	memset(traceLog, 0, sizeof(traceLog));
+	traceLogNext = 0U;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceBegin
+********************************************************************************
+*
+* Summary:
+*  This function opens the scope of a public API call. Only the outermost of
+*  nested calls is recorded.
+*
+*******************************************************************************/
+uint8_t DPS_422_traceBegin(uint8_t scope)
+{
+	if (traceDepth++ == 0U)
+	{
+		traceScope = scope;
+		traceScopeStart = DWT->CYCCNT;
+		traceScopeTransactions = 0U;
+		traceScopeBytes = 0U;
+	}
+	return scope;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceEnd
+********************************************************************************
+*
+* Summary:
+*  This function closes the scope of a public API call. It is called by the
+*  compiler when the function that opened the scope returns.
+*
+*******************************************************************************/
+void DPS_422_traceEnd(uint8_t *scope)
+{
+	(void)scope;
+	if (--traceDepth != 0U)
+	{
+		return;
+	}
+
+	/* The cycle counter wraps, unsigned subtraction still gives the duration */
+	DPS_422_traceStats_t *stats = &traceScopes[traceScope];
+	stats->transactions += traceScopeTransactions;
+	stats->bytes += traceScopeBytes;
+	DPS_422_traceAddLatency(&stats->latency, DWT->CYCCNT - traceScopeStart);
+	traceScope = DPS_422_TRACE_NO_SCOPE;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceBus
+********************************************************************************
+*
+* Summary:
+*  This function records one bus transaction that started at the given cycle.
+*
+*******************************************************************************/
+void DPS_422_traceBus(uint8_t kind, uint8_t regAddress, uint8_t length, uint32_t start)
+{
+	uint32_t cycles = DWT->CYCCNT - start;
+
+	DPS_422_traceStats_t *stats = &traceBusStats[kind];
+	stats->transactions++;
+	stats->bytes += length;
+	DPS_422_traceAddLatency(&stats->latency, cycles);
+
+	traceScopeTransactions++;
+	traceScopeBytes += length;
+
+	DPS_422_traceEntry_t *entry = &traceLog[traceLogNext++ % DPS_422_TRACE_LOG_SIZE];
+	entry->start = start;
+	entry->cycles = cycles;
+	entry->kind = kind;
+	entry->regAddress = regAddress;
+	entry->length = length;
+	entry->scope = traceScope;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceDumpStats
+********************************************************************************
+*
+* Summary:
+*  This function prints one line of statistics, if anything was recorded.
+*
+*******************************************************************************/
+static void DPS_422_traceDumpStats(const char *name, const DPS_422_traceStats_t *stats, uint32_t cyclesPerUs)
+{
+	const DPS_422_traceLatency_t *latency = &stats->latency;
+	if (latency->count == 0U)
+	{
+		return;
+	}
+
+	printf("%-25s %6lu %7lu %7lu %9lu %9lu %9lu  ", name, (unsigned long)latency->count,
+			(unsigned long)stats->transactions, (unsigned long)stats->bytes,
+			(unsigned long)(latency->min / cyclesPerUs),
+			(unsigned long)(latency->sum / latency->count / cyclesPerUs),
+			(unsigned long)(latency->max / cyclesPerUs));
+	for (uint8_t i = 0; i < DPS_422_TRACE_HIST_BUCKETS; i++)
+	{
+		printf(" %lu", (unsigned long)latency->hist[i]);
+	}
+	printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_traceDump
+********************************************************************************
+*
+* Summary:
+*  This function prints the statistics of every API call and bus direction
+*  and the last transactions on the debug UART.
+*
+*******************************************************************************/
+void DPS_422_traceDump(void)
+{
+	uint32_t cyclesPerUs = SystemCoreClock / 1000000U;
+	if (cyclesPerUs == 0U)
+	{
+		cyclesPerUs = 1U;
+	}
+
+	printf("\r\nDPS422 bus trace, %lu cycles per us\r\n", (unsigned long)cyclesPerUs);
+	printf("histogram: bucket 0 below %u cycles, bucket n from %u << (n - 1) cycles\r\n",
+			1U << DPS_422_TRACE_HIST_SHIFT, 1U << DPS_422_TRACE_HIST_SHIFT);
+	printf("%-25s %6s %7s %7s %9s %9s %9s   %s\r\n", "call", "count", "trans", "bytes", "min us", "avg us", "max us",
+			"histogram");
+	for (uint8_t i = 0; i < DPS_422_TRACE_NUM_SCOPES; i++)
+	{
+		DPS_422_traceDumpStats(traceScopeNames[i], &traceScopes[i], cyclesPerUs);
+	}
+	for (uint8_t i = 0; i < DPS_422_TRACE_NUM_BUS; i++)
+	{
+		DPS_422_traceDumpStats(traceBusNames[i], &traceBusStats[i], cyclesPerUs);
+	}
+
+	/* Oldest first */
+	printf("last transactions: start cycle, call, kind, register, bytes, us\r\n");
+	uint32_t first = (traceLogNext > DPS_422_TRACE_LOG_SIZE) ? traceLogNext - DPS_422_TRACE_LOG_SIZE : 0U;
+	for (uint32_t n = first; n < traceLogNext; n++)
+	{
+		const DPS_422_traceEntry_t *entry = &traceLog[n % DPS_422_TRACE_LOG_SIZE];
+		printf("%10lu %-25s %-5s 0x%02X %3u %6lu\r\n", (unsigned long)entry->start,
+				(entry->scope < DPS_422_TRACE_NUM_SCOPES) ? traceScopeNames[entry->scope] : "-",
+				traceBusNames[entry->kind], entry->regAddress, entry->length,
+				(unsigned long)(entry->cycles / cyclesPerUs));
+	}
+}
+
+#endif /* DPS_422_TRACE */
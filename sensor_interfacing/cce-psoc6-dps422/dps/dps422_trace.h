@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name:  dps422_trace.h
+*
+* Description:  This file contains the optional bus transaction and latency
+*               instrumentation of the DPS422 driver. Without DPS_422_TRACE
+*               all macros expand to nothing.
+*
+*******************************************************************************/
+
+#ifndef DPS_DPS422_TRACE_H_
+#define DPS_DPS422_TRACE_H_
+
+#include "cy_pdl.h"
+
+/* Set to 1, e.g. with DEFINES+=DPS_422_TRACE=1 in the Makefile, to record every bus transaction */
+#ifndef DPS_422_TRACE
+#define DPS_422_TRACE 0
+#endif
+
+#if DPS_422_TRACE
+
+#define DPS_422_TRACE_HIST_BUCKETS	16U
+#define DPS_422_TRACE_HIST_SHIFT	9U		/* Bucket 0 is below 512 cycles, every further bucket doubles */
+#define DPS_422_TRACE_LOG_SIZE		16U		/* Last transactions kept for the dump */
+#define DPS_422_TRACE_NO_SCOPE		0xFFU
+
+/* Public API calls the transactions are charged to, nested calls count for the outermost */
+enum DPS_422_traceScope_e
+{
+	DPS_422_TRACE_INIT = 0,
+	DPS_422_TRACE_CONFIG_TEMP,
+	DPS_422_TRACE_CONFIG_PRESSURE,
+	DPS_422_TRACE_MEASURE_TEMP,
+	DPS_422_TRACE_MEASURE_PRESSURE,
+	DPS_422_TRACE_MEASURE_BOTH,
+	DPS_422_TRACE_START_ASYNC,
+	DPS_422_TRACE_POLL_ASYNC,
+	DPS_422_TRACE_START_CONT,
+	DPS_422_TRACE_GET_CONT,
+	DPS_422_TRACE_STANDBY,
+	DPS_422_TRACE_NUM_SCOPES
+};
+
+enum DPS_422_traceBus_e
+{
+	DPS_422_TRACE_READ = 0,
+	DPS_422_TRACE_WRITE,
+	DPS_422_TRACE_NUM_BUS
+};
+
+/* Latency in CPU cycles */
+typedef struct
+{
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t hist[DPS_422_TRACE_HIST_BUCKETS];
+} DPS_422_traceLatency_t;
+
+typedef struct
+{
+	uint32_t transactions;
+	uint32_t bytes;
+	DPS_422_traceLatency_t latency;
+} DPS_422_traceStats_t;
+
+typedef struct
+{
+	uint32_t start;			/* Cycle counter when the transaction started */
+	uint32_t cycles;
+	uint8_t kind;			/* DPS_422_TRACE_READ or DPS_422_TRACE_WRITE */
+	uint8_t regAddress;
+	uint8_t length;			/* Payload bytes */
+	uint8_t scope;			/* Outermost API call, DPS_422_TRACE_NO_SCOPE outside of one */
+} DPS_422_traceEntry_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void DPS_422_traceInit(void);
+void DPS_422_traceReset(void);
+void DPS_422_traceDump(void);
+uint8_t DPS_422_traceBegin(uint8_t scope);
+void DPS_422_traceEnd(uint8_t *scope);
+void DPS_422_traceBus(uint8_t kind, uint8_t regAddress, uint8_t length, uint32_t start);
+
+/* Charges every transaction until the enclosing function returns to the scope, needs GCC or Arm Compiler 6 */
+#define DPS_422_TRACE_SCOPE(scope) \
+	uint8_t dps422TraceScope __attribute__((cleanup(DPS_422_traceEnd), unused)) = DPS_422_traceBegin(scope)
+#define DPS_422_TRACE_BUS_START() uint32_t dps422TraceStart = DWT->CYCCNT
+#define DPS_422_TRACE_BUS_END(kind, regAddress, length) DPS_422_traceBus((kind), (regAddress), (length), dps422TraceStart)
+
+#else
+
+#define DPS_422_TRACE_SCOPE(scope)
+#define DPS_422_TRACE_BUS_START()
+#define DPS_422_TRACE_BUS_END(kind, regAddress, length)
+
+#endif /* DPS_422_TRACE */
+
+#endif /* DPS_DPS422_TRACE_H_ */
@@ -0,0 +1,216 @@
+/******************************************************************************
+* File Name: bench_bus.c
+*
+* Description: Runs the DPS422 driver against the register model in
+*              dps422_sim.c and reports the initialization time, the bus cost
+*              per sample of the one shot, paired and asynchronous
+*              measurements and the compensation throughput.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "dps422.h"
+#include "dps422_sim.h"
+
+#define BENCH_BUS_HZ			100000U
+#define BENCH_SAMPLES			16U
+#define BENCH_OVERSAMPLING		DPS__OVERSAMPLING_RATE_8
+#define BENCH_ROUNDS			200000U
+
+#define BENCH_TEMPERATURE		25.0
+#define BENCH_PRESSURE			101325.0
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void print_stats(const char *name, uint32_t samples, uint64_t startUs)
+{
+	const DPS_422_SIM_stats_t *stats = DPS_422_SIM_getStats();
+	double n = (samples > 0U) ? samples : 1U;
+
+	printf("%s\n", name);
+	printf("  transactions  %6u reads, %6u writes, %u NACKs\n", stats->reads, stats->writes, stats->nacks);
+	printf("  payload       %6u bytes read, %6u bytes written\n", stats->bytesRead, stats->bytesWritten);
+	printf("  on the wire   %6u bytes, %.1f us bus time\n", stats->wireBytes, stats->busTimeNs / 1000.0);
+	printf("  elapsed       %.1f ms, of that %.1f ms in delays\n",
+		   (DPS_422_SIM_getTimeUs() - startUs) / 1000.0, stats->delayTimeUs / 1000.0);
+	if (samples > 0U)
+	{
+		printf("  per sample    %.2f transactions, %.1f wire bytes, %.1f us bus time\n",
+			   (stats->reads + stats->writes) / n, stats->wireBytes / n, stats->busTimeNs / 1000.0 / n);
+	}
+}
+
+static void bench_init(cyhal_i2c_t *i2c)
+{
+	uint64_t start = DPS_422_SIM_getTimeUs();
+	DPS_422_SIM_resetStats();
+	DPS_422_Init(i2c);
+	print_stats("DPS_422_Init", 0U, start);
+	printf("  result        %s, product ID 0x%x\n\n", m_initFail ? "failed" : "ok",
+		   DPS_422_readByteBitfield(registers[PROD_ID]));
+}
+
+static void bench_one_shot(void)
+{
+	double errTemp = 0.0;
+	double errPrs = 0.0;
+	uint64_t start = DPS_422_SIM_getTimeUs();
+
+	DPS_422_SIM_resetStats();
+	for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+	{
+		float temp;
+		float prs;
+		DPS_422_measureTempOnceOversamplingRate(&temp, BENCH_OVERSAMPLING);
+		DPS_422_measurePressureOnceOversamplingRate(&prs, BENCH_OVERSAMPLING);
+		errTemp = fmax(errTemp, fabs(temp - BENCH_TEMPERATURE));
+		errPrs = fmax(errPrs, fabs(prs - BENCH_PRESSURE));
+	}
+	print_stats("One shot, temperature + pressure pairs", 2U * BENCH_SAMPLES, start);
+	printf("  max error     %.4f C, %.3f Pa\n\n", errTemp, errPrs);
+}
+
+static void bench_both(void)
+{
+	double errTemp = 0.0;
+	double errPrs = 0.0;
+	uint64_t start = DPS_422_SIM_getTimeUs();
+
+	DPS_422_SIM_resetStats();
+	for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+	{
+		float temp;
+		float prs;
+		DPS_422_measureBothOnceOversamplingRate(&temp, &prs, BENCH_OVERSAMPLING, BENCH_OVERSAMPLING);
+		errTemp = fmax(errTemp, fabs(temp - BENCH_TEMPERATURE));
+		errPrs = fmax(errPrs, fabs(prs - BENCH_PRESSURE));
+	}
+	print_stats("One shot, paired measurement", BENCH_SAMPLES, start);
+	printf("  max error     %.4f C, %.3f Pa\n\n", errTemp, errPrs);
+}
+
+static void bench_both_cont(void)
+{
+	uint32_t pairs = 0U;
+	double errPrs = 0.0;
+
+	if (DPS_422_startMeasureBothCont(DPS__MEASUREMENT_RATE_8, BENCH_OVERSAMPLING,
+			DPS__MEASUREMENT_RATE_8, BENCH_OVERSAMPLING) != DPS_SUCCESS)
+	{
+		printf("Continuous paired measurement could not be started\n\n");
+		return;
+	}
+	uint64_t start = DPS_422_SIM_getTimeUs();
+	DPS_422_SIM_resetStats();
+	while (pairs < BENCH_SAMPLES)
+	{
+		float temp;
+		float prs;
+		/* Poll every 50 ms, faster than the 125 ms result period */
+		cyhal_system_delay_ms(50);
+		if (DPS_422_getContBothResult(&temp, &prs) == DPS_SUCCESS)
+		{
+			errPrs = fmax(errPrs, fabs(prs - BENCH_PRESSURE));
+			pairs++;
+		}
+	}
+	print_stats("Continuous paired measurement, 8 Hz", pairs, start);
+	printf("  max error     %.3f Pa\n\n", errPrs);
+	DPS_422_standby();
+}
+
+static void bench_async(void)
+{
+	uint32_t polls = 0U;
+	uint64_t start = DPS_422_SIM_getTimeUs();
+
+	DPS_422_SIM_resetStats();
+	for (uint32_t i = 0; i < BENCH_SAMPLES; i++)
+	{
+		float prs;
+		DPS_422_startMeasurePressureAsync(BENCH_OVERSAMPLING, NULL);
+		/* Poll once per millisecond, as a scheduler tick would */
+		do
+		{
+			cyhal_system_delay_ms(1);
+			polls++;
+		} while (DPS_422_pollAsync(&prs) == DPS_BUSY);
+	}
+	print_stats("Asynchronous pressure, polled every 1 ms", BENCH_SAMPLES, start);
+	printf("  polls         %.1f per sample\n\n", (double)polls / BENCH_SAMPLES);
+}
+
+static void bench_compensation(DPS_422_SIM_sensor_t *sensor)
+{
+	int32_t raw[DPS__FIFO_SIZE];
+	float outFloat[DPS__FIFO_SIZE];
+	int32_t outFixed[DPS__FIFO_SIZE];
+	volatile float sinkFloat = 0;
+	volatile int32_t sinkFixed = 0;
+
+	/* One batch of raw pressure values over a few hundred Pa */
+	for (uint8_t k = 0; k < DPS__FIFO_SIZE; k++)
+	{
+		float prs;
+		DPS_422_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE - 200.0 + 12.5 * k);
+		DPS_422_measurePressureOnceOversamplingRate(&prs, BENCH_OVERSAMPLING);
+		DPS_422_getRawResult(&raw[k], registerBlocks[PRS]);
+	}
+
+	double start = now_ns();
+	for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+	{
+		DPS_422_calcPressureBatch(raw, outFloat, DPS__FIFO_SIZE);
+		sinkFloat += outFloat[r % DPS__FIFO_SIZE];
+	}
+	double tFloat = (now_ns() - start) / ((double)BENCH_ROUNDS * DPS__FIFO_SIZE);
+
+	start = now_ns();
+	for (uint32_t r = 0; r < BENCH_ROUNDS; r++)
+	{
+		DPS_422_calcPressureBatchFixed(raw, outFixed, DPS__FIFO_SIZE);
+		sinkFixed += outFixed[r % DPS__FIFO_SIZE];
+	}
+	double tFixed = (now_ns() - start) / ((double)BENCH_ROUNDS * DPS__FIFO_SIZE);
+
+	printf("Compensation throughput on this host, batches of %d samples\n", DPS__FIFO_SIZE);
+	printf("  %-30s %8.2f ns/sample\n", "DPS_422_calcPressureBatch", tFloat);
+	printf("  %-30s %8.2f ns/sample\n", "DPS_422_calcPressureBatchFixed", tFixed);
+}
+
+int main(void)
+{
+	cyhal_i2c_t i2c = {0};
+
+	DPS_422_SIM_reset(BENCH_BUS_HZ);
+	DPS_422_SIM_sensor_t *sensor = DPS_422_SIM_addSensor(i2c.bus_id, DPS__STD_SLAVE_ADDRESS);
+	DPS_422_SIM_setEnvironment(sensor, BENCH_TEMPERATURE, BENCH_PRESSURE);
+
+	printf("Simulated DPS422 at %u kHz, %.1f C, %.0f Pa\n\n", BENCH_BUS_HZ / 1000U, BENCH_TEMPERATURE, BENCH_PRESSURE);
+#if DPS_422_TRACE
+	DPS_422_traceInit();
+#endif
+	bench_init(&i2c);
+	if (m_initFail)
+	{
+		return 1;
+	}
+	bench_one_shot();
+	bench_both();
+	bench_both_cont();
+	bench_async();
+	bench_compensation(sensor);
+#if DPS_422_TRACE
+	/* Everything on the bus, charged to the API calls */
+	DPS_422_traceDump();
+#endif
+	return 0;
+}
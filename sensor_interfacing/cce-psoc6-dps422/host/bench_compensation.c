@@ -0,0 +1,208 @@
+/******************************************************************************
+* File Name: bench_compensation.c
+*
+* Description: Host benchmark of the DPS422 compensation. Compares the float,
+*              float batch and fixed-point kernels against a double precision
+*              reference and measures their throughput.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "dps422.h"
+
+#define BENCH_BATCH			DPS__FIFO_SIZE
+#define BENCH_ROUNDS		200000
+#define BENCH_TEMP_STEPS	64
+#define BENCH_PRS_STEPS		4096
+
+/* Scaled temperature of the benchmark range, roughly -40 .. 85 degree Celsius with the coefficients below */
+#define BENCH_TEMP_MIN		0.05
+#define BENCH_TEMP_MAX		0.125
+
+typedef struct
+{
+	double max_err;
+	double sum_sq;
+	uint32_t count;
+} error_stats_t;
+
+static const int32_t scaling_facts[DPS__NUM_OF_SCAL_FACTS] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
+
+/*******************************************************************************
+* Function Name: set_typical_coeffs
+********************************************************************************
+*
+* Summary:
+*  Loads the calibration data of a typical DPS422.
+*
+*******************************************************************************/
+static void set_typical_coeffs(void)
+{
+	m_c00 = 83150;
+	m_c10 = -31220;
+	m_c01 = -41710;
+	m_c02 = 26300;
+	m_c11 = 3285;
+	m_c12 = -1180;
+	m_c20 = -3710;
+	m_c21 = 510;
+	m_c30 = -420;
+
+	a_prime = 6380.0f;
+	b_prime = -273.3f;
+	a_prime_q = (int32_t)lroundf(a_prime * (1 << DPS__TEMP_FRAC_BITS));
+	b_prime_q = (int32_t)lroundf(b_prime * (1 << DPS__TEMP_FRAC_BITS));
+}
+
+static double reference_temp(int32_t raw)
+{
+	double t = raw / 1048576.0;
+	double u = t / (1 + DPS422_ALPHA * t);
+	return (double)a_prime * u + b_prime;
+}
+
+static double reference_pressure(int32_t raw_temp, int32_t raw_prs)
+{
+	double t_scal = raw_temp / 1048576.0;
+	double t = 8.5 * t_scal / (1 + 8.8 * t_scal);
+	double p = (double)raw_prs / scaling_facts[m_prsOsr];
+	return m_c00 + m_c10 * p + m_c01 * t + m_c20 * p * p + m_c02 * t * t + m_c30 * p * p * p +
+		   m_c11 * t * p + m_c12 * p * t * t + m_c21 * p * p * t;
+}
+
+static void add_error(error_stats_t *stats, double value, double reference)
+{
+	double err = fabs(value - reference);
+	if (err > stats->max_err)
+	{
+		stats->max_err = err;
+	}
+	stats->sum_sq += err * err;
+	stats->count++;
+}
+
+static void print_error(const char *name, const error_stats_t *stats, const char *unit)
+{
+	printf("  %-30s max %8.4f %s   rms %8.4f %s\n", name, stats->max_err, unit, sqrt(stats->sum_sq / stats->count), unit);
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void run_accuracy(void)
+{
+	error_stats_t err_temp = {0};
+	error_stats_t err_temp_fixed = {0};
+	error_stats_t err_float = {0};
+	error_stats_t err_batch = {0};
+	error_stats_t err_fixed = {0};
+	int32_t raw[BENCH_BATCH];
+	float out_float[BENCH_BATCH];
+	int32_t out_fixed[BENCH_BATCH];
+
+	for (uint8_t osr = 0; osr < DPS__NUM_OF_SCAL_FACTS; osr++)
+	{
+		m_prsOsr = osr;
+		for (int ti = 0; ti < BENCH_TEMP_STEPS; ti++)
+		{
+			double scaled_temp = BENCH_TEMP_MIN + (BENCH_TEMP_MAX - BENCH_TEMP_MIN) * ti / BENCH_TEMP_STEPS;
+			int32_t raw_temp = (int32_t)(scaled_temp * 1048576);
+
+			add_error(&err_temp_fixed, (double)DPS_422_calcTempFixed(raw_temp) / (1 << DPS__TEMP_FRAC_BITS), reference_temp(raw_temp));
+			add_error(&err_temp, DPS_422_calcTemp(raw_temp), reference_temp(raw_temp));
+
+			for (int pi = 0; pi < BENCH_PRS_STEPS; pi += BENCH_BATCH)
+			{
+				/* scaled pressure -0.7 .. 0.95 */
+				for (int k = 0; k < BENCH_BATCH; k++)
+				{
+					double scaled = -0.7 + 1.65 * (pi + k) / BENCH_PRS_STEPS;
+					raw[k] = (int32_t)(scaled * scaling_facts[osr]);
+				}
+				DPS_422_calcPressureBatch(raw, out_float, BENCH_BATCH);
+				DPS_422_calcPressureBatchFixed(raw, out_fixed, BENCH_BATCH);
+				for (int k = 0; k < BENCH_BATCH; k++)
+				{
+					double ref = reference_pressure(raw_temp, raw[k]);
+					add_error(&err_float, DPS_422_calcPressure(raw[k]), ref);
+					add_error(&err_batch, out_float[k], ref);
+					add_error(&err_fixed, (double)out_fixed[k] / (1 << DPS__PRS_FRAC_BITS), ref);
+				}
+			}
+		}
+	}
+
+	printf("Accuracy against double precision, %u pressure samples over all oversampling rates\n", err_float.count);
+	print_error("DPS_422_calcTemp", &err_temp, "C ");
+	print_error("DPS_422_calcTempFixed", &err_temp_fixed, "C ");
+	print_error("DPS_422_calcPressure", &err_float, "Pa");
+	print_error("DPS_422_calcPressureBatch", &err_batch, "Pa");
+	print_error("DPS_422_calcPressureBatchFixed", &err_fixed, "Pa");
+}
+
+static void run_throughput(void)
+{
+	int32_t raw[BENCH_BATCH];
+	float out_float[BENCH_BATCH];
+	int32_t out_fixed[BENCH_BATCH];
+	volatile float sink_float = 0;
+	volatile int32_t sink_fixed = 0;
+	const double samples = (double)BENCH_ROUNDS * BENCH_BATCH;
+
+	m_prsOsr = DPS__OVERSAMPLING_RATE_8;
+	DPS_422_calcTemp(87700);
+	for (int k = 0; k < BENCH_BATCH; k++)
+	{
+		raw[k] = -2500000 + 1000 * k;
+	}
+
+	double start = now_ns();
+	for (int r = 0; r < BENCH_ROUNDS; r++)
+	{
+		for (int k = 0; k < BENCH_BATCH; k++)
+		{
+			out_float[k] = DPS_422_calcPressure(raw[k]);
+		}
+		sink_float += out_float[r % BENCH_BATCH];
+	}
+	double t_single = (now_ns() - start) / samples;
+
+	start = now_ns();
+	for (int r = 0; r < BENCH_ROUNDS; r++)
+	{
+		DPS_422_calcPressureBatch(raw, out_float, BENCH_BATCH);
+		sink_float += out_float[r % BENCH_BATCH];
+	}
+	double t_batch = (now_ns() - start) / samples;
+
+	start = now_ns();
+	for (int r = 0; r < BENCH_ROUNDS; r++)
+	{
+		DPS_422_calcPressureBatchFixed(raw, out_fixed, BENCH_BATCH);
+		sink_fixed += out_fixed[r % BENCH_BATCH];
+	}
+	double t_fixed = (now_ns() - start) / samples;
+
+	printf("\nThroughput on this host, batches of %d samples\n", BENCH_BATCH);
+	printf("  %-30s %8.2f ns/sample\n", "DPS_422_calcPressure", t_single);
+	printf("  %-30s %8.2f ns/sample\n", "DPS_422_calcPressureBatch", t_batch);
+	printf("  %-30s %8.2f ns/sample\n", "DPS_422_calcPressureBatchFixed", t_fixed);
+	printf("\nHost timings show the gain of the batch layout. On the FPU-less CM0+ every\n"
+		   "float operation is a library call, which the fixed-point kernel avoids.\n");
+}
+
+int main(void)
+{
+	set_typical_coeffs();
+
+	run_accuracy();
+	run_throughput();
+	return 0;
+}
@@ -0,0 +1,618 @@
+/******************************************************************************
+* File Name: dps422_sim.c
+*
+* Description: Host implementation of the HAL calls used by the DPS422 driver,
+*              backed by a register model of the sensor. It covers PROD_ID,
+*              the coefficient blocks, the ready bits, one shot and background
+*              conversions, the FIFO and the interrupt status register.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "dps422_sim.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define SIM_RSLT_NACK				((cy_rslt_t)0x00000001U)
+
+#define SIM_REG_PSR_B2				0x00U
+#define SIM_REG_TMP_B2				0x03U
+#define SIM_REG_PRS_CFG				0x06U
+#define SIM_REG_TMP_CFG				0x07U
+#define SIM_REG_MEAS_CFG			0x08U
+#define SIM_REG_CFG_REG				0x09U
+#define SIM_REG_INT_STS				0x0AU
+#define SIM_REG_FIFO_STS			0x0CU
+#define SIM_REG_RESET				0x0DU
+#define SIM_REG_ID					0x1DU
+#define SIM_REG_COEF_TEMP			0x20U
+#define SIM_REG_COEF_PRS			0x26U
+
+#define SIM_MEAS_INIT_DONE			0x80U
+#define SIM_MEAS_CONT_FLAG			0x40U
+#define SIM_MEAS_TMP_RDY			0x20U
+#define SIM_MEAS_PRS_RDY			0x10U
+#define SIM_MEAS_CTRL				0x07U
+
+#define SIM_CFG_INT_FIFO_FULL		0x80U
+#define SIM_CFG_INT_TMP				0x20U
+#define SIM_CFG_INT_PRS				0x10U
+#define SIM_CFG_FIFO_EN				0x02U
+
+#define SIM_INT_FIFO				0x04U
+#define SIM_INT_TMP					0x02U
+#define SIM_INT_PRS					0x01U
+
+#define SIM_FIFO_STS_FULL			0x02U
+#define SIM_FIFO_STS_EMPTY			0x01U
+
+#define SIM_RESET_FIFO_FLUSH		0x80U
+#define SIM_RESET_SOFT_RST			0x09U
+
+#define SIM_FIFO_EMPTY_VALUE		0x800000
+
+/* Power-on until the coefficients can be read */
+#define SIM_STARTUP_US				40000U
+/* Start and stop/restart conditions, in bus clocks */
+#define SIM_I2C_START_STOP_CLOCKS	3U
+/* Background results the model catches up at once, older ones are skipped */
+#define SIM_MAX_CATCH_UP			64U
+
+/* Temperature model constants, same as in dps422_config.h */
+#define SIM_T_REF					27.0
+#define SIM_V_BE_TARGET				0.687027
+#define SIM_ALPHA					9.45
+#define SIM_T_C_VBE					-1.735e-3
+#define SIM_K_PTAT_CORNER			-0.8
+#define SIM_K_PTAT_CURVATURE		0.039
+#define SIM_A_0						5030.0
+
+/*******************************************************************************
+ * Global variable
+ *******************************************************************************/
+static const int32_t SIM_scaling_facts[8] = {524288, 1572864, 3670016, 7864320, 253952, 516096, 1040384, 2088960};
+
+/* A plausible DPS422, about -0.05 scaled pressure at 101325 Pa and 25 degree Celsius */
+static const DPS_422_SIM_coeffs_t SIM_default_coeffs = {12, -5, 30, 90000, -50000, 20000, -2000, -3700, -400, -3000, 500, 500};
+
+static DPS_422_SIM_sensor_t SIM_sensors[DPS_422_SIM_MAX_SENSORS];
+static uint8_t SIM_numSensors;
+static uint32_t SIM_busHz = 100000U;
+static uint64_t SIM_nowNs;
+static DPS_422_SIM_stats_t SIM_stats;
+
+/*******************************************************************************
+ * Register model
+ *******************************************************************************/
+static uint64_t SIM_nowUs(void)
+{
+	return SIM_nowNs / 1000U;
+}
+
+static void SIM_putBits(uint8_t *regs, uint8_t first, uint8_t lastBit, uint32_t value, uint8_t bits)
+{
+	/* Write value MSB first into the bit stream, starting at bit lastBit of regs[first] */
+	uint32_t pos = (uint32_t)first * 8U + (7U - lastBit);
+	for (int8_t b = bits - 1; b >= 0; b--, pos++)
+	{
+		uint8_t mask = (uint8_t)(0x80U >> (pos % 8U));
+		if (value & (1UL << b))
+		{
+			regs[pos / 8U] |= mask;
+		}
+		else
+		{
+			regs[pos / 8U] &= (uint8_t)~mask;
+		}
+	}
+}
+
+static void SIM_writeCoeffs(DPS_422_SIM_sensor_t *s)
+{
+	const DPS_422_SIM_coeffs_t *c = &s->coeffs;
+	uint8_t *temp = &s->regs[SIM_REG_COEF_TEMP];
+	uint8_t *prs = &s->regs[SIM_REG_COEF_PRS];
+
+	/* Layout as read by DPS_422_readcoeffs, every value in two's complement */
+	temp[0] = (uint8_t)c->tGain;
+	temp[1] = (uint8_t)((((uint32_t)c->tDVbe & 0x7FU) << 1) | ((uint32_t)c->tVbe & 0x01U));
+	temp[2] = (uint8_t)(((uint32_t)c->tVbe & 0x1FFU) >> 1);
+
+	memset(prs, 0, 20);
+	SIM_putBits(prs, 0, 7, (uint32_t)c->c00 & 0xFFFFFU, 20);
+	SIM_putBits(prs, 2, 3, (uint32_t)c->c10 & 0xFFFFFU, 20);
+	SIM_putBits(prs, 5, 7, (uint32_t)c->c01 & 0xFFFFFU, 20);
+	SIM_putBits(prs, 7, 3, (uint32_t)c->c02 & 0xFFFFFU, 20);
+	SIM_putBits(prs, 10, 6, (uint32_t)c->c20 & 0x7FFFU, 15);
+	SIM_putBits(prs, 12, 3, (uint32_t)c->c30 & 0xFFFU, 12);
+	SIM_putBits(prs, 14, 7, (uint32_t)c->c11 & 0x1FFFFU, 17);
+	SIM_putBits(prs, 16, 6, (uint32_t)c->c12 & 0x1FFFFU, 17);
+	SIM_putBits(prs, 18, 5, (uint32_t)c->c21 & 0x3FFFU, 14);
+}
+
+static void SIM_powerOn(DPS_422_SIM_sensor_t *s)
+{
+	memset(s->regs, 0, sizeof(s->regs));
+	/* Product ID 0x0A, revision 0 */
+	s->regs[SIM_REG_ID] = 0x0AU;
+	s->regs[SIM_REG_FIFO_STS] = SIM_FIFO_STS_EMPTY;
+	SIM_writeCoeffs(s);
+
+	s->readyAtUs = SIM_nowUs() + SIM_STARTUP_US;
+	s->convEndUs = 0U;
+	s->fifoHead = 0U;
+	s->fifoCount = 0U;
+}
+
+static uint64_t SIM_convTimeUs(const DPS_422_SIM_sensor_t *s, uint8_t osr)
+{
+	/* Same nominal time as DPS_422_calcBusyTime */
+	return (uint64_t)(20U + (32U << osr)) * 100U * s->timingPercent / 100U;
+}
+
+static uint64_t SIM_periodUs(uint8_t mr)
+{
+	return 1000000U >> mr;
+}
+
+static int32_t SIM_clampRaw(double raw)
+{
+	raw = floor(raw + 0.5);
+	if (raw > 0x7FFFFF)
+	{
+		raw = 0x7FFFFF;
+	}
+	if (raw < -0x7FFFFF)
+	{
+		raw = -0x7FFFFF;
+	}
+	return (int32_t)raw;
+}
+
+static double SIM_scaledTemp(const DPS_422_SIM_sensor_t *s)
+{
+	const DPS_422_SIM_coeffs_t *c = &s->coeffs;
+
+	/* A' and B' as derived by DPS_422_readcoeffs */
+	double vbe = c->tVbe * 1.05031e-4 + 0.463232422;
+	double dVbe = c->tDVbe * 1.25885e-5 + 0.04027621;
+	double aAdc = c->tGain * 8.4375e-5 + 0.675;
+	double vbeCal = vbe / aAdc;
+	double dVbeCal = dVbe / aAdc;
+	double tCalib = SIM_A_0 * dVbeCal - 273.15;
+	double vbeCalTref = vbeCal - (tCalib - SIM_T_REF) * SIM_T_C_VBE;
+	double kPtat = (SIM_V_BE_TARGET - vbeCalTref) * SIM_K_PTAT_CORNER + SIM_K_PTAT_CURVATURE;
+	double aPrime = SIM_A_0 * (vbeCal + SIM_ALPHA * dVbeCal) * (1 + kPtat);
+	double bPrime = -273.15 * (1 + kPtat) - kPtat * tCalib;
+
+	/* Inverse of T = A' * Tsc / (1 + alpha * Tsc) + B' */
+	double u = (s->temperature - bPrime) / aPrime;
+	return u / (1 - SIM_ALPHA * u);
+}
+
+static int32_t SIM_rawTemp(const DPS_422_SIM_sensor_t *s)
+{
+	return SIM_clampRaw(SIM_scaledTemp(s) * 1048576.0);
+}
+
+static int32_t SIM_rawPressure(const DPS_422_SIM_sensor_t *s)
+{
+	const DPS_422_SIM_coeffs_t *c = &s->coeffs;
+	double tScal = SIM_scaledTemp(s);
+	double t = 8.5 * tScal / (1 + 8.8 * tScal);
+	double p = 0.0;
+
+	/* Newton iteration on the compensation polynomial */
+	for (uint8_t i = 0; i < 20U; i++)
+	{
+		double f = c->c00 + c->c10 * p + c->c01 * t + c->c20 * p * p + c->c02 * t * t + c->c30 * p * p * p +
+				   c->c11 * t * p + c->c12 * p * t * t + c->c21 * p * p * t - s->pressure;
+		double df = c->c10 + 2.0 * c->c20 * p + 3.0 * c->c30 * p * p + c->c11 * t + c->c12 * t * t + 2.0 * c->c21 * p * t;
+		p -= f / df;
+	}
+	return SIM_clampRaw(p * SIM_scaling_facts[s->regs[SIM_REG_PRS_CFG] & 0x07U]);
+}
+
+static void SIM_setResult(DPS_422_SIM_sensor_t *s, uint8_t reg, int32_t raw)
+{
+	s->regs[reg] = (uint8_t)(raw >> 16);
+	s->regs[reg + 1U] = (uint8_t)(raw >> 8);
+	s->regs[reg + 2U] = (uint8_t)raw;
+}
+
+static void SIM_updateFifoStatus(DPS_422_SIM_sensor_t *s)
+{
+	/* Fill level in bits 7:2 */
+	s->regs[SIM_REG_FIFO_STS] = (uint8_t)(s->fifoCount << 2);
+	if (s->fifoCount == 0U)
+	{
+		s->regs[SIM_REG_FIFO_STS] |= SIM_FIFO_STS_EMPTY;
+	}
+	if (s->fifoCount == DPS_422_SIM_FIFO_SIZE)
+	{
+		s->regs[SIM_REG_FIFO_STS] |= SIM_FIFO_STS_FULL;
+	}
+}
+
+static void SIM_fifoPush(DPS_422_SIM_sensor_t *s, int32_t raw)
+{
+	/* A full FIFO drops new results */
+	if (s->fifoCount == DPS_422_SIM_FIFO_SIZE)
+	{
+		return;
+	}
+	s->fifo[(s->fifoHead + s->fifoCount) % DPS_422_SIM_FIFO_SIZE] = raw;
+	s->fifoCount++;
+	if ((s->fifoCount == DPS_422_SIM_FIFO_SIZE) && (s->regs[SIM_REG_CFG_REG] & SIM_CFG_INT_FIFO_FULL))
+	{
+		s->regs[SIM_REG_INT_STS] |= SIM_INT_FIFO;
+	}
+	SIM_updateFifoStatus(s);
+}
+
+static void SIM_finishConversion(DPS_422_SIM_sensor_t *s, uint8_t isPressure)
+{
+	int32_t raw = isPressure ? SIM_rawPressure(s) : SIM_rawTemp(s);
+
+	s->conversions++;
+	if (s->regs[SIM_REG_CFG_REG] & SIM_CFG_FIFO_EN)
+	{
+		/* The LSB of a FIFO entry tells pressure (1) from temperature (0) */
+		SIM_fifoPush(s, isPressure ? (raw | 0x01) : (raw & ~0x01));
+		return;
+	}
+
+	SIM_setResult(s, isPressure ? SIM_REG_PSR_B2 : SIM_REG_TMP_B2, raw);
+	s->regs[SIM_REG_MEAS_CFG] |= isPressure ? SIM_MEAS_PRS_RDY : SIM_MEAS_TMP_RDY;
+	if (s->regs[SIM_REG_CFG_REG] & (isPressure ? SIM_CFG_INT_PRS : SIM_CFG_INT_TMP))
+	{
+		s->regs[SIM_REG_INT_STS] |= isPressure ? SIM_INT_PRS : SIM_INT_TMP;
+	}
+}
+
+static void SIM_catchUp(uint64_t *next, uint64_t period, uint64_t now)
+{
+	/* Skip results the FIFO could not hold anyway */
+	if (*next + SIM_MAX_CATCH_UP * period < now)
+	{
+		*next += ((now - *next) / period - SIM_MAX_CATCH_UP) * period;
+	}
+}
+
+static void SIM_update(DPS_422_SIM_sensor_t *s)
+{
+	uint64_t now = SIM_nowUs();
+	uint8_t ctrl = s->regs[SIM_REG_MEAS_CFG] & SIM_MEAS_CTRL;
+
+	if (now >= s->readyAtUs)
+	{
+		s->regs[SIM_REG_MEAS_CFG] |= SIM_MEAS_INIT_DONE;
+	}
+
+	/* One shot conversion, the sensor returns to standby afterwards */
+	if ((ctrl >= 0x01U) && (ctrl <= 0x03U) && (now >= s->convEndUs))
+	{
+		s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_CTRL;
+		if (ctrl & 0x02U)
+		{
+			SIM_finishConversion(s, 0U);
+		}
+		if (ctrl & 0x01U)
+		{
+			SIM_finishConversion(s, 1U);
+		}
+		return;
+	}
+
+	/* Background mode, results in time order */
+	if (ctrl >= 0x05U)
+	{
+		uint8_t doTemp = (ctrl & 0x02U) != 0U;
+		uint8_t doPrs = (ctrl & 0x01U) != 0U;
+		uint64_t tempPeriod = SIM_periodUs((s->regs[SIM_REG_TMP_CFG] >> 4) & 0x07U);
+		uint64_t prsPeriod = SIM_periodUs((s->regs[SIM_REG_PRS_CFG] >> 4) & 0x07U);
+
+		if (doTemp)
+		{
+			SIM_catchUp(&s->nextTempUs, tempPeriod, now);
+		}
+		if (doPrs)
+		{
+			SIM_catchUp(&s->nextPrsUs, prsPeriod, now);
+		}
+		for (;;)
+		{
+			uint8_t tempDue = doTemp && (s->nextTempUs <= now);
+			uint8_t prsDue = doPrs && (s->nextPrsUs <= now);
+			if (tempDue && (!prsDue || s->nextTempUs <= s->nextPrsUs))
+			{
+				SIM_finishConversion(s, 0U);
+				s->nextTempUs += tempPeriod;
+			}
+			else if (prsDue)
+			{
+				SIM_finishConversion(s, 1U);
+				s->nextPrsUs += prsPeriod;
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+}
+
+static void SIM_writeMeasCfg(DPS_422_SIM_sensor_t *s, uint8_t value)
+{
+	uint8_t ctrl = value & SIM_MEAS_CTRL;
+	uint64_t now = SIM_nowUs();
+	uint64_t tempTime = SIM_convTimeUs(s, s->regs[SIM_REG_TMP_CFG] & 0x07U);
+	uint64_t prsTime = SIM_convTimeUs(s, s->regs[SIM_REG_PRS_CFG] & 0x07U);
+
+	/* Only the mode bits are writable, a new mode clears the ready flags */
+	s->regs[SIM_REG_MEAS_CFG] = (s->regs[SIM_REG_MEAS_CFG] & SIM_MEAS_INIT_DONE) | ctrl;
+	switch (ctrl)
+	{
+	case 0x01U:
+		s->convEndUs = now + prsTime;
+		break;
+	case 0x02U:
+		s->convEndUs = now + tempTime;
+		break;
+	case 0x03U:
+		/* Temperature first, then pressure */
+		s->convEndUs = now + tempTime + prsTime;
+		break;
+	case 0x05U:
+	case 0x06U:
+	case 0x07U:
+		s->regs[SIM_REG_MEAS_CFG] |= SIM_MEAS_CONT_FLAG;
+		s->nextTempUs = now + tempTime;
+		s->nextPrsUs = now + prsTime;
+		break;
+	default:
+		break;
+	}
+}
+
+static void SIM_writeReg(DPS_422_SIM_sensor_t *s, uint8_t reg, uint8_t value)
+{
+	switch (reg)
+	{
+	case SIM_REG_MEAS_CFG:
+		SIM_writeMeasCfg(s, value);
+		break;
+	case SIM_REG_RESET:
+		if ((value & 0x0FU) == SIM_RESET_SOFT_RST)
+		{
+			SIM_powerOn(s);
+		}
+		else if (value & SIM_RESET_FIFO_FLUSH)
+		{
+			s->fifoCount = 0U;
+			SIM_updateFifoStatus(s);
+		}
+		break;
+	case SIM_REG_INT_STS:
+	case SIM_REG_FIFO_STS:
+	case SIM_REG_ID:
+		/* Read only */
+		break;
+	default:
+		s->regs[reg] = value;
+		break;
+	}
+}
+
+static uint8_t SIM_readReg(DPS_422_SIM_sensor_t *s, uint8_t reg)
+{
+	uint8_t value;
+
+	/* Reading PSR_B2 with the FIFO enabled pops the next entry into the result registers */
+	if ((reg == SIM_REG_PSR_B2) && (s->regs[SIM_REG_CFG_REG] & SIM_CFG_FIFO_EN))
+	{
+		int32_t raw = SIM_FIFO_EMPTY_VALUE;
+		if (s->fifoCount > 0U)
+		{
+			raw = s->fifo[s->fifoHead];
+			s->fifoHead = (s->fifoHead + 1U) % DPS_422_SIM_FIFO_SIZE;
+			s->fifoCount--;
+			SIM_updateFifoStatus(s);
+		}
+		SIM_setResult(s, SIM_REG_PSR_B2, raw);
+	}
+
+	value = s->regs[reg];
+	if (reg == SIM_REG_INT_STS)
+	{
+		/* Cleared on read */
+		s->regs[SIM_REG_INT_STS] = 0U;
+	}
+	else if (reg == SIM_REG_PSR_B2 + 2U)
+	{
+		s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_PRS_RDY;
+	}
+	else if (reg == SIM_REG_TMP_B2 + 2U)
+	{
+		s->regs[SIM_REG_MEAS_CFG] &= (uint8_t)~SIM_MEAS_TMP_RDY;
+	}
+	return value;
+}
+
+static DPS_422_SIM_sensor_t *SIM_find(const cyhal_i2c_t *obj, uint16_t address)
+{
+	uint32_t busId = (obj != NULL) ? obj->bus_id : 0U;
+	for (uint8_t i = 0; i < SIM_numSensors; i++)
+	{
+		if ((SIM_sensors[i].busId == busId) && (SIM_sensors[i].address == address))
+		{
+			return &SIM_sensors[i];
+		}
+	}
+	return NULL;
+}
+
+static void SIM_transfer(uint32_t wireBytes)
+{
+	/* 9 clocks per byte (8 data + ACK) plus start, restart and stop */
+	uint64_t clocks = (uint64_t)wireBytes * 9U + SIM_I2C_START_STOP_CLOCKS;
+	uint64_t ns = clocks * 1000000000ULL / SIM_busHz;
+	SIM_nowNs += ns;
+	SIM_stats.wireBytes += wireBytes;
+	SIM_stats.busTimeNs += ns;
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_SIM_reset
+********************************************************************************
+*
+* Summary:
+*  This function removes all sensors, sets the bus clock and restarts the
+*  virtual time and the statistics.
+*
+*******************************************************************************/
+void DPS_422_SIM_reset(uint32_t busHz)
+{
+	memset(SIM_sensors, 0, sizeof(SIM_sensors));
+	SIM_numSensors = 0U;
+	SIM_busHz = busHz;
+	SIM_nowNs = 0U;
+	DPS_422_SIM_resetStats();
+}
+
+/*******************************************************************************
+* Function Name: DPS_422_SIM_addSensor
+********************************************************************************
+*
+* Summary:
+*  This function powers on a sensor at the given bus and slave address, with
+*  typical coefficients at 25 degree Celsius and 101325 Pa.
+*
+*******************************************************************************/
+DPS_422_SIM_sensor_t *DPS_422_SIM_addSensor(uint32_t busId, uint8_t address)
+{
+	if (SIM_numSensors >= DPS_422_SIM_MAX_SENSORS)
+	{
+		return NULL;
+	}
+	DPS_422_SIM_sensor_t *s = &SIM_sensors[SIM_numSensors++];
+	s->busId = busId;
+	s->address = address;
+	s->coeffs = SIM_default_coeffs;
+	s->temperature = 25.0;
+	s->pressure = 101325.0;
+	s->timingPercent = 100U;
+	SIM_powerOn(s);
+	return s;
+}
+
+void DPS_422_SIM_setCoeffs(DPS_422_SIM_sensor_t *sensor, const DPS_422_SIM_coeffs_t *coeffs)
+{
+	sensor->coeffs = *coeffs;
+	SIM_writeCoeffs(sensor);
+}
+
+void DPS_422_SIM_setEnvironment(DPS_422_SIM_sensor_t *sensor, double temperature, double pressure)
+{
+	sensor->temperature = temperature;
+	sensor->pressure = pressure;
+}
+
+void DPS_422_SIM_setTimingPercent(DPS_422_SIM_sensor_t *sensor, uint32_t percent)
+{
+	sensor->timingPercent = percent;
+}
+
+uint64_t DPS_422_SIM_getTimeUs(void)
+{
+	return SIM_nowUs();
+}
+
+/* The stub cycle counter runs on the virtual time once enabled, writes to it are lost */
+uint32_t SystemCoreClock = DPS_422_SIM_CPU_HZ;
+CoreDebug_Type DPS_422_SIM_coreDebug;
+static DWT_Type SIM_dwt;
+
+DWT_Type *DPS_422_SIM_getDwt(void)
+{
+	if (SIM_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+	{
+		SIM_dwt.CYCCNT = (uint32_t)(SIM_nowNs * (SystemCoreClock / 1000000U) / 1000U);
+	}
+	return &SIM_dwt;
+}
+
+const DPS_422_SIM_stats_t *DPS_422_SIM_getStats(void)
+{
+	return &SIM_stats;
+}
+
+void DPS_422_SIM_resetStats(void)
+{
+	memset(&SIM_stats, 0, sizeof(SIM_stats));
+}
+
+/*******************************************************************************
+ * HAL
+ *******************************************************************************/
+cy_rslt_t cyhal_i2c_master_mem_read(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+									uint8_t *data, uint16_t size, uint32_t timeout)
+{
+	(void)timeout;
+	DPS_422_SIM_sensor_t *s = SIM_find(obj, address);
+
+	SIM_stats.reads++;
+	if (s == NULL)
+	{
+		/* The slave address is not acknowledged */
+		SIM_stats.nacks++;
+		SIM_transfer(1U);
+		return SIM_RSLT_NACK;
+	}
+
+	/* Slave address (write), register address, slave address (read), data */
+	SIM_transfer(2U + mem_addr_size + size);
+	SIM_stats.bytesRead += size;
+	SIM_update(s);
+	for (uint16_t i = 0; i < size; i++)
+	{
+		data[i] = SIM_readReg(s, (uint8_t)(mem_addr + i));
+	}
+	return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_i2c_master_mem_write(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+									 const uint8_t *data, uint16_t size, uint32_t timeout)
+{
+	(void)timeout;
+	DPS_422_SIM_sensor_t *s = SIM_find(obj, address);
+
+	SIM_stats.writes++;
+	if (s == NULL)
+	{
+		SIM_stats.nacks++;
+		SIM_transfer(1U);
+		return SIM_RSLT_NACK;
+	}
+
+	/* Slave address, register address, data */
+	SIM_transfer(1U + mem_addr_size + size);
+	SIM_stats.bytesWritten += size;
+	SIM_update(s);
+	for (uint16_t i = 0; i < size; i++)
+	{
+		SIM_writeReg(s, (uint8_t)(mem_addr + i), data[i]);
+	}
+	return CY_RSLT_SUCCESS;
+}
+
+void cyhal_system_delay_ms(uint32_t milliseconds)
+{
+	SIM_nowNs += (uint64_t)milliseconds * 1000000U;
+	SIM_stats.delayTimeUs += (uint64_t)milliseconds * 1000U;
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name: dps422_sim.h
+*
+* Description: Register model of the DPS422 behind the host versions of
+*              cyhal_i2c_master_mem_read/write and cyhal_system_delay_ms.
+*              Time is virtual: delays and bus transfers advance it, so
+*              conversion timing and bus cost can be measured without a board.
+*
+*******************************************************************************/
+
+#ifndef DPS422_SIM_H_
+#define DPS422_SIM_H_
+
+#include <stdint.h>
+
+#define DPS_422_SIM_MAX_SENSORS		4U
+#define DPS_422_SIM_FIFO_SIZE		32U
+#define DPS_422_SIM_CPU_HZ			100000000U	/* Clock of the stub cycle counter */
+
+/*******************************************************************************
+ * Structure
+ *******************************************************************************/
+/* Bus traffic since the last DPS_422_SIM_resetStats */
+typedef struct
+{
+	uint32_t reads;				/* read transactions */
+	uint32_t writes;			/* write transactions */
+	uint32_t nacks;				/* transactions no sensor answered */
+	uint32_t bytesRead;			/* payload bytes */
+	uint32_t bytesWritten;		/* payload bytes, without the register address */
+	uint32_t wireBytes;			/* everything on the bus, incl. slave and register addresses */
+	uint64_t busTimeNs;			/* time the bus was busy */
+	uint64_t delayTimeUs;		/* time spent in cyhal_system_delay_ms */
+} DPS_422_SIM_stats_t;
+
+/* Calibration data as stored in the coefficient registers */
+typedef struct
+{
+	int32_t tGain;
+	int32_t tDVbe;
+	int32_t tVbe;
+	int32_t c00;
+	int32_t c10;
+	int32_t c01;
+	int32_t c02;
+	int32_t c20;
+	int32_t c30;
+	int32_t c11;
+	int32_t c12;
+	int32_t c21;
+} DPS_422_SIM_coeffs_t;
+
+typedef struct
+{
+	uint32_t busId;
+	uint8_t address;
+	uint8_t regs[256];
+
+	DPS_422_SIM_coeffs_t coeffs;
+	double temperature;			/* degree Celsius the sensor sees */
+	double pressure;			/* Pa the sensor sees */
+	uint32_t timingPercent;		/* conversion time relative to nominal, 100 = nominal */
+
+	uint64_t readyAtUs;			/* end of the power-on sequence */
+	uint64_t convEndUs;			/* end of the running one shot conversion */
+	uint64_t nextTempUs;		/* next background temperature result */
+	uint64_t nextPrsUs;			/* next background pressure result */
+
+	int32_t fifo[DPS_422_SIM_FIFO_SIZE];
+	uint8_t fifoHead;
+	uint8_t fifoCount;
+
+	uint32_t conversions;		/* finished conversions, one shot and background */
+} DPS_422_SIM_sensor_t;
+
+/*******************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+void DPS_422_SIM_reset(uint32_t busHz);
+DPS_422_SIM_sensor_t *DPS_422_SIM_addSensor(uint32_t busId, uint8_t address);
+void DPS_422_SIM_setCoeffs(DPS_422_SIM_sensor_t *sensor, const DPS_422_SIM_coeffs_t *coeffs);
+void DPS_422_SIM_setEnvironment(DPS_422_SIM_sensor_t *sensor, double temperature, double pressure);
+void DPS_422_SIM_setTimingPercent(DPS_422_SIM_sensor_t *sensor, uint32_t percent);
+
+uint64_t DPS_422_SIM_getTimeUs(void);
+const DPS_422_SIM_stats_t *DPS_422_SIM_getStats(void);
+void DPS_422_SIM_resetStats(void);
+
+#endif /* DPS422_SIM_H_ */
@@ -0,0 +1,37 @@
+/******************************************************************************
+* File Name: cy_pdl.h
+*
+* Description: Host stand-in for the PSoC 6 PDL header.
+*
+*******************************************************************************/
+
+#ifndef HOST_CY_PDL_H_
+#define HOST_CY_PDL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Cycle counter for dps422_trace.c, host/dps422_sim.c derives it from its virtual time */
+typedef struct
+{
+	uint32_t CTRL;
+	uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk			(1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk		(1UL << 24)
+
+DWT_Type *DPS_422_SIM_getDwt(void);
+extern CoreDebug_Type DPS_422_SIM_coreDebug;
+extern uint32_t SystemCoreClock;
+
+#define DWT (DPS_422_SIM_getDwt())
+#define CoreDebug (&DPS_422_SIM_coreDebug)
+
+#endif /* HOST_CY_PDL_H_ */
@@ -0,0 +1,34 @@
+/******************************************************************************
+* File Name: cyhal.h
+*
+* Description: Host stand-in for the parts of the PSoC 6 HAL used by the
+*              DPS422 driver. Only used to build the driver on a PC.
+*
+*******************************************************************************/
+
+#ifndef HOST_CYHAL_H_
+#define HOST_CYHAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0x00000000U)
+#define CY_ASSERT(x) do { if (!(x)) { abort(); } } while (0)
+
+typedef struct
+{
+    uint32_t bus_id;
+} cyhal_i2c_t;
+
+cy_rslt_t cyhal_i2c_master_mem_read(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+                                    uint8_t *data, uint16_t size, uint32_t timeout);
+cy_rslt_t cyhal_i2c_master_mem_write(cyhal_i2c_t *obj, uint16_t address, uint16_t mem_addr, uint16_t mem_addr_size,
+                                     const uint8_t *data, uint16_t size, uint32_t timeout);
+
+void cyhal_system_delay_ms(uint32_t milliseconds);
+
+#endif /* HOST_CYHAL_H_ */
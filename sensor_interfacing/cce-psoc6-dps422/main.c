@@ -131,6 +131,13 @@ int main(void)
 
     printf("**                   Initializing Pressure Sensor                   **\r\n");
 
+#if DPS_422_TRACE
+    /* Built with DEFINES+=DPS_422_TRACE=1, the bus transactions of every driver
+     * call are printed after each measurement. The first dump includes the
+     * initialization. */
+    DPS_422_traceInit();
+#endif
+
     /* Initialize DPS422 Pressure Sensor */
     DPS_422_Init(&I2C_DPS_422);
 
@@ -155,27 +162,21 @@ int main(void)
         if(interrupt_flag == true)
         {
 
-            /* Read and display temperature value */
-            ret = DPS_422_measureTempOnceOversamplingRate(&temperature, oversampling);
+            /* Measure temperature and pressure in one conversion cycle */
+            ret = DPS_422_measureBothOnceOversamplingRate(&temperature, &pressure, oversampling, oversampling);
             if (ret != 0)
             {
-                printf("Failed to read temperature data from sensor\r\n");
+                printf("Failed to read temperature and pressure data from sensor\r\n");
             }
             else
             {
                 printf("\r\nTemperature  : %f C\r\n", temperature);
-            }
-
-            /* Read and display pressure value */
-            ret = DPS_422_measurePressureOnceOversamplingRate(&pressure, oversampling);
-            if (ret != 0)
-            {
-                printf("Failed to read pressure data from sensor\r\n");
-            }
-            else
-            {
                 printf("Pressure     : %f Pascal\r\n", pressure);
             }
+#if DPS_422_TRACE
+            DPS_422_traceDump();
+            DPS_422_traceReset();
+#endif
             printf("End\r\n");
 
             interrupt_flag = false;
@@ -0,0 +1,537 @@
+/******************************************************************************
+* File Name: bench_speed.c
+*
+* Description: Host benchmark of the TLx4966 speed estimators. Feeds the
+*              driver synthetic pulse trains through the model in
+*              tlx4966_sim.c, with edge jitter, interrupt latency, steps,
+*              stops, a stop across the timer wrap and direction reversals,
+*              reads the speed at 1 kHz and reports the error against the
+*              true speed, the time the reading takes to follow a change and
+*              the host time per edge interrupt.
+*              Build it once as is and once with -DTLx4966_CAPTURE=1 to
+*              compare the GPIO interrupt with the hardware capture.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "tlx4966.h"
+#include "tlx4966_sim.h"
+
+#define BENCH_SPEED_PIN     ((cyhal_gpio_t)0U)
+#define BENCH_DIR_PIN       ((cyhal_gpio_t)1U)
+#define BENCH_OTHER_PIN     ((cyhal_gpio_t)2U)
+
+#define BENCH_READ_NS       1000000ULL  /* speed read at 1 kHz */
+#define BENCH_JITTER        0.001       /* edge jitter, standard deviation per period */
+#define BENCH_LATENCY_NS    10000U      /* interrupt latency, uniform from 0 */
+#define BENCH_WINDOW_MS     100U
+#define BENCH_TIMEOUT_MS    150000U     /* longer than the period at 1 RPM */
+#define BENCH_GAP_NS        200000000000ULL  /* rest between runs, longer than any timeout */
+#define BENCH_SETTLE        0.02        /* band of the settling time */
+#define BENCH_STEP_S        2.0         /* s before and after a step */
+#define BENCH_ROUNDS        1000000
+
+/* Piecewise linear speed profile in RPM, negative turns backwards. The speed
+ * pin gives one pulse per revolution, as the speed coefficients assume. */
+typedef struct
+{
+    double duration;    /* s */
+    double rpm_start;
+    double rpm_end;
+} segment_t;
+
+/* Read statistics of one run */
+typedef struct
+{
+    double from;        /* s, reads before this are not counted */
+    uint32_t reads;
+    double sum_sq;      /* relative error, or RPM if absolute */
+    double max;
+    bool absolute;
+    double change;      /* s, time of the change the settling times refer to */
+    double settled;     /* s after the change, last read outside BENCH_SETTLE */
+    double below;       /* s after the change, first read below 10 % of before */
+    double zero;        /* s after the change, first read of 0 */
+    double rpm_before;
+    double dir_lag;     /* s after the reversal until TLx4966_readDir follows */
+} stats_t;
+
+static const char *const estimator_names[] = {"M", "T", "hybrid"};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Normal distributed noise, Box-Muller */
+static double noise(double sigma)
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static uint32_t latency(void)
+{
+    return (uint32_t)(rand() % (BENCH_LATENCY_NS + 1U));
+}
+
+static double profile_rpm(const segment_t *profile, uint32_t segments, double t)
+{
+    for (uint32_t i = 0; i < segments; i++)
+    {
+        if (t < profile[i].duration)
+        {
+            return profile[i].rpm_start + (profile[i].rpm_end - profile[i].rpm_start) * t / profile[i].duration;
+        }
+        t -= profile[i].duration;
+    }
+    return profile[segments - 1U].rpm_end;
+}
+
+/* Time from the start of a segment until the shaft covered the given
+ * revolutions, negative if it does not within the segment. Speed changes
+ * linearly, so the revolutions are quadratic in time. */
+static double segment_reach(const segment_t *segment, double revolutions)
+{
+    double f0 = fabs(segment->rpm_start) / 60.0;
+    double f1 = fabs(segment->rpm_end) / 60.0;
+    double a = (f1 - f0) / segment->duration;
+    double disc = f0 * f0 + 2.0 * a * revolutions;
+
+    if ((disc < 0.0) || (f0 + sqrt(disc) <= 0.0))
+    {
+        return -1.0;
+    }
+    double t = 2.0 * revolutions / (f0 + sqrt(disc));
+    return (t <= segment->duration) ? t : -1.0;
+}
+
+static double segment_revolutions(const segment_t *segment)
+{
+    return (fabs(segment->rpm_start) + fabs(segment->rpm_end)) / 120.0 * segment->duration;
+}
+
+static void stats_read(stats_t *stats, double t, double rpm_true, float rpm_read, bool dir_true)
+{
+    double rpm = fabs(rpm_true);
+
+    if ((stats->change > 0.0) && (t >= stats->change))
+    {
+        double after = t - stats->change;
+        if (fabs(rpm_read - rpm) > BENCH_SETTLE * rpm)
+        {
+            stats->settled = after;
+        }
+        if ((stats->below < 0.0) && (rpm_read < 0.1 * stats->rpm_before))
+        {
+            stats->below = after;
+        }
+        if ((stats->zero < 0.0) && (rpm_read == 0.0f))
+        {
+            stats->zero = after;
+        }
+        if ((stats->dir_lag < 0.0) && ((TLx4966_readDir() == TLx4966_DIR_UP) == dir_true))
+        {
+            stats->dir_lag = after;
+        }
+    }
+
+    if (t < stats->from)
+    {
+        return;
+    }
+    double err = stats->absolute ? fabs(rpm_read - rpm) : fabs(rpm_read - rpm) / rpm;
+    stats->sum_sq += err * err;
+    if (err > stats->max)
+    {
+        stats->max = err;
+    }
+    stats->reads++;
+}
+
+/* Plays the profile into the model after a rest, reading the speed at 1 kHz.
+ * The edges jitter by the given part of the period. The direction pin follows
+ * the sign of the speed with the next speed edge, as the sensor outputs it. */
+static void run_profile(const segment_t *profile, uint32_t segments, double jitter_rel, stats_t *stats)
+{
+    uint64_t start = TLx4966_SIM_now() + BENCH_GAP_NS;
+    uint64_t next_read = start;
+    double total = 0.0;
+    double seg_start = 0.0;
+    double seg_done = 0.0;      /* revolutions within the current segment */
+    double pulse_left = 1.0;    /* revolutions until the next pulse */
+    uint32_t seg = 0U;
+
+    for (uint32_t i = 0; i < segments; i++)
+    {
+        total += profile[i].duration;
+    }
+    TLx4966_SIM_advance(start);
+
+    while (true)
+    {
+        /* Next edge without jitter, carrying the pulse phase across segments */
+        double edge = -1.0;
+        while (seg < segments)
+        {
+            double t = segment_reach(&profile[seg], seg_done + pulse_left);
+            if (t >= 0.0)
+            {
+                edge = seg_start + t;
+                break;
+            }
+            pulse_left -= segment_revolutions(&profile[seg]) - seg_done;
+            seg_start += profile[seg].duration;
+            seg_done = 0.0;
+            seg++;
+        }
+        if (edge < 0.0)
+        {
+            edge = total;
+        }
+
+        /* Jitter before the reads, time can't go back to an earlier edge */
+        double rpm = profile_rpm(profile, segments, edge);
+        double period = 60.0 / fmax(fabs(rpm), 1e-3);
+        double jitter = (seg < segments) ? noise(jitter_rel * period * 1e9) : 0.0;
+        uint64_t edge_ns = start + (uint64_t)(edge * 1e9 + jitter);
+        while ((next_read < edge_ns) && (next_read <= start + (uint64_t)(total * 1e9)))
+        {
+            double t = (double)(next_read - start) / 1e9;
+            double rpm_true = profile_rpm(profile, segments, t);
+            TLx4966_SIM_advance(next_read);
+            stats_read(stats, t, rpm_true, TLx4966_readSpeed(), rpm_true > 0.0);
+            next_read += BENCH_READ_NS;
+        }
+        if (seg >= segments)
+        {
+            return;
+        }
+
+        TLx4966_SIM_setLevel(BENCH_DIR_PIN, (rpm >= 0.0) ? TLx4966_DIR_UP : !TLx4966_DIR_UP, edge_ns);
+        TLx4966_SIM_risingEdge(BENCH_SPEED_PIN, edge_ns, latency());
+
+        seg_done += pulse_left;
+        pulse_left = 1.0;
+    }
+}
+
+static void stats_init(stats_t *stats, double from, bool absolute)
+{
+    *stats = (stats_t){0};
+    stats->from = from;
+    stats->absolute = absolute;
+    stats->settled = 0.0;
+    stats->below = -1.0;
+    stats->zero = -1.0;
+    stats->dir_lag = -1.0;
+}
+
+/* Without jitter, what is left is the timer resolution and, for the GPIO
+ * interrupt, the interrupt latency */
+static void run_steady(double jitter_rel)
+{
+    static const double speeds[] = {1, 10, 100, 1000, 5000, 10000, 20000};
+
+    printf("Constant speed, %.1f %% period jitter, up to %u us latency, %u ms window\n",
+           jitter_rel * 100.0, BENCH_LATENCY_NS / 1000U, BENCH_WINDOW_MS);
+    printf("  %8s  %-22s %-22s %-22s\n", "RPM", "M rms/max %", "T rms/max %", "hybrid rms/max %");
+    for (uint32_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++)
+    {
+        /* At least 12 pulses, reads count from the 6th on */
+        double period = 60.0 / speeds[i];
+        double duration = fmax(2.0, 12.0 * period);
+        double from = fmax(0.5, 6.0 * period);
+        segment_t profile[] = {{duration, speeds[i], speeds[i]}};
+
+        printf("  %8.0f ", speeds[i]);
+        for (uint32_t e = 0; e < 3U; e++)
+        {
+            stats_t stats;
+            stats_init(&stats, from, false);
+            TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, BENCH_TIMEOUT_MS);
+            run_profile(profile, 1U, jitter_rel, &stats);
+            printf(" %9.3f %9.3f   ", sqrt(stats.sum_sq / stats.reads) * 100.0, stats.max * 100.0);
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+static void run_steps(void)
+{
+    static const double steps[][2] = {{1000, 2000}, {10000, 5000}, {100, 200}};
+
+    printf("Speed step, time until the reading stays within %.0f %%\n", BENCH_SETTLE * 100.0);
+    printf("  %14s  %10s %10s %10s\n", "RPM", "M ms", "T ms", "hybrid ms");
+    for (uint32_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+        segment_t profile[] = {{BENCH_STEP_S, steps[i][0], steps[i][0]}, {BENCH_STEP_S, steps[i][1], steps[i][1]}};
+
+        printf("  %6.0f > %5.0f ", steps[i][0], steps[i][1]);
+        for (uint32_t e = 0; e < 3U; e++)
+        {
+            stats_t stats;
+            stats_init(&stats, 2.0 * BENCH_STEP_S, false);
+            stats.change = BENCH_STEP_S;
+            TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, BENCH_TIMEOUT_MS);
+            run_profile(profile, 2U, BENCH_JITTER, &stats);
+            /* Still outside the band in the last window, it never settles */
+            if (stats.settled > BENCH_STEP_S - BENCH_WINDOW_MS / 1000.0)
+            {
+                printf(" %10s", "never");
+            }
+            else
+            {
+                printf(" %10.1f", stats.settled * 1000.0);
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+static void run_stop(void)
+{
+    segment_t profile[] = {{1.0, 3000, 3000}, {0.001, 3000, 0}, {3.0, 0, 0}};
+
+    printf("Stop from 3000 RPM within 1 ms, %u ms timeout\n", TLx4966_DEFAULT_TIMEOUT_MS);
+    printf("  %-8s %14s %14s\n", "", "below 10 % ms", "reads 0 ms");
+    for (uint32_t e = 0; e < 3U; e++)
+    {
+        stats_t stats;
+        stats_init(&stats, 5.0, false);
+        stats.change = 1.0;
+        stats.rpm_before = 3000.0;
+        TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, TLx4966_DEFAULT_TIMEOUT_MS);
+        run_profile(profile, 3U, BENCH_JITTER, &stats);
+        printf("  %-8s %14.1f %14.1f\n", estimator_names[e], stats.below * 1000.0, stats.zero * 1000.0);
+    }
+    printf("\n");
+}
+
+/* Stopped for longer than the timer takes to wrap. The time since the last
+ * edge wraps with it, the speed has to stay 0 nevertheless */
+static void run_wrap(void)
+{
+    double wrap = 4294967296.0 / TIMER_FREQUENCY;
+    segment_t profile[] = {{1.0, 3000, 3000}, {0.001, 3000, 0}, {wrap + 1.0, 0, 0}};
+
+    printf("Stop from 3000 RPM held across the timer wrap after %.0f s, %u ms timeout\n", wrap,
+           TLx4966_DEFAULT_TIMEOUT_MS);
+    printf("  %-8s %14s\n", "", "max RPM after");
+    for (uint32_t e = 0; e < 3U; e++)
+    {
+        stats_t stats;
+        stats_init(&stats, 1.001 + TLx4966_DEFAULT_TIMEOUT_MS / 1000.0, true);
+        TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, TLx4966_DEFAULT_TIMEOUT_MS);
+        run_profile(profile, 3U, BENCH_JITTER, &stats);
+        printf("  %-8s %14.1f\n", estimator_names[e], stats.max);
+    }
+    printf("\n");
+}
+
+static void run_reversal(void)
+{
+    segment_t profile[] = {{1.0, 3000, 3000}, {0.5, 3000, 0}, {0.5, 0, -3000}, {1.0, -3000, -3000}};
+
+    printf("Reversal, 3000 RPM down to 0 and up to -3000 RPM in 1 s\n");
+    printf("  %-8s %14s %14s %14s\n", "", "rms RPM", "max RPM", "dir lag ms");
+    for (uint32_t e = 0; e < 3U; e++)
+    {
+        stats_t stats;
+        stats_init(&stats, 0.5, true);
+        stats.change = 1.5;
+        TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, TLx4966_DEFAULT_TIMEOUT_MS);
+        run_profile(profile, 4U, BENCH_JITTER, &stats);
+        printf("  %-8s %14.1f %14.1f %14.1f\n", estimator_names[e], sqrt(stats.sum_sq / stats.reads), stats.max,
+               stats.dir_lag * 1000.0);
+    }
+    printf("\n");
+}
+
+#if TLx4966_ODOMETER
+/* Odometer state driven by hand: the pins, the position they should give and
+ * the time of the next edge */
+typedef struct
+{
+    uint64_t t;
+    bool up;
+    int32_t position;
+    int failures;
+} odometer_t;
+
+/* Pulses on the speed pin. The handlers run after every pulse, or only at the
+ * next TLx4966_SIM_runPending() */
+static void odo_pulses(odometer_t *odo, uint32_t pulses, bool run)
+{
+    for (uint32_t i = 0; i < pulses; i++)
+    {
+        odo->t += 1000000U;
+        if (run)
+        {
+            TLx4966_SIM_risingEdge(BENCH_SPEED_PIN, odo->t, latency());
+        }
+        else
+        {
+            TLx4966_SIM_setLevel(BENCH_SPEED_PIN, true, odo->t);
+            TLx4966_SIM_setLevel(BENCH_SPEED_PIN, false, odo->t + 500000U);
+        }
+        odo->position += odo->up ? 1 : -1;
+    }
+}
+
+static void odo_reverse(odometer_t *odo, bool run)
+{
+    odo->t += 500000U;
+    odo->up = !odo->up;
+    TLx4966_SIM_setLevel(BENCH_DIR_PIN, odo->up ? TLx4966_DIR_UP : !TLx4966_DIR_UP, odo->t);
+    if (run)
+    {
+        TLx4966_SIM_runPending();
+    }
+}
+
+static void odo_check(odometer_t *odo, const char *name)
+{
+    int32_t position = TLx4966_readPosition();
+
+    printf("  %-40s %8ld %8ld   %s\n", name, (long)odo->position, (long)position,
+           (position == odo->position) ? "ok" : "FAIL");
+    if (position != odo->position)
+    {
+        odo->failures++;
+    }
+}
+
+/* The odometer through reversals, with the interrupt after every reversal and
+ * late enough to see two of them */
+static int run_odometer(void)
+{
+    odometer_t odo = {TLx4966_SIM_now() + BENCH_GAP_NS, true, 0, 0};
+
+    printf("Odometer position through reversals\n");
+    printf("  %-40s %8s %8s\n", "", "expected", "read");
+    TLx4966_SIM_setLevel(BENCH_DIR_PIN, TLx4966_DIR_UP, odo.t);
+    TLx4966_SIM_runPending();
+    TLx4966_resetPosition();
+    odo_check(&odo, "after TLx4966_resetPosition");
+
+    odo_pulses(&odo, 5U, true);
+    odo_reverse(&odo, true);
+    odo_pulses(&odo, 3U, true);
+    odo_reverse(&odo, true);
+    odo_pulses(&odo, 7U, true);
+    odo_check(&odo, "5 up, 3 down, 7 up");
+
+    odo_pulses(&odo, 4U, true);
+    odo_reverse(&odo, false);
+    odo_pulses(&odo, 2U, false);
+    odo_reverse(&odo, false);
+    odo_pulses(&odo, 3U, false);
+    TLx4966_SIM_runPending();
+    odo_check(&odo, "2 reversals before the interrupt");
+
+    odo_reverse(&odo, true);
+    odo_reverse(&odo, false);
+    odo_pulses(&odo, 6U, false);
+    odo_reverse(&odo, false);
+    TLx4966_SIM_runPending();
+    odo_check(&odo, "same, no pulse before the first one");
+
+    odo_pulses(&odo, 2U, true);
+    odo_reverse(&odo, false);
+    odo_reverse(&odo, false);
+    TLx4966_SIM_runPending();
+    odo_pulses(&odo, 2U, true);
+    odo_check(&odo, "same, no pulse between them");
+
+    odo_reverse(&odo, false);
+    odo_pulses(&odo, 4U, false);
+    odo_check(&odo, "read before the interrupt");
+    TLx4966_SIM_runPending();
+    odo_check(&odo, "read after it");
+
+    odo_reverse(&odo, true);
+    odo_pulses(&odo, 9U, true);
+    odo_check(&odo, "reversal between two reads");
+
+    printf("\n");
+    return odo.failures != 0;
+}
+#endif /* TLx4966_ODOMETER */
+
+static void run_cost(void)
+{
+    volatile float sink = 0.0f;
+    uint64_t t = TLx4966_SIM_now() + BENCH_GAP_NS;
+
+    /* Edges on a pin without handler give the cost of the model alone */
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        t += 3000000U;
+        TLx4966_SIM_risingEdge(BENCH_OTHER_PIN, t, 0U);
+    }
+    double t_model = (now_ns() - start) / BENCH_ROUNDS;
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        t += 3000000U;
+        TLx4966_SIM_risingEdge(BENCH_SPEED_PIN, t, 0U);
+    }
+    double t_edge = (now_ns() - start) / BENCH_ROUNDS - t_model;
+
+    printf("Cost on this host\n");
+    printf("  %-28s %8.1f ns\n", "edge interrupt handler", t_edge);
+    for (uint32_t e = 0; e < 3U; e++)
+    {
+        TLx4966_setEstimator((TLx4966_estimator_t)e, BENCH_WINDOW_MS, TLx4966_DEFAULT_TIMEOUT_MS);
+        start = now_ns();
+        for (int r = 0; r < BENCH_ROUNDS; r++)
+        {
+            sink += TLx4966_readSpeed();
+        }
+        printf("  TLx4966_readSpeed, %-8s %8.1f ns\n", estimator_names[e], (now_ns() - start) / BENCH_ROUNDS);
+    }
+    (void)sink;
+}
+
+int main(void)
+{
+    int result = 0;
+
+    srand(1);
+    TLx4966_SIM_reset();
+    if (TLx4966_init(BENCH_SPEED_PIN, BENCH_DIR_PIN, TLx4966_SPEED_COEF_RPM) != CY_RSLT_SUCCESS)
+    {
+        printf("TLx4966_init failed\n");
+        return 1;
+    }
+    printf("TLx4966 speed estimators, edges timed by the %s\n\n",
+           TLx4966_CAPTURE ? "hardware capture" : "GPIO interrupt");
+
+    run_steady(BENCH_JITTER);
+    run_steady(0.0);
+    run_steps();
+    run_stop();
+    run_wrap();
+    run_reversal();
+#if TLx4966_ODOMETER
+    result |= run_odometer();
+#endif
+    run_cost();
+
+    const TLx4966_SIM_stats_t *sim = TLx4966_SIM_getStats();
+    printf("\n%lu edges, %lu GPIO and %lu capture interrupts\n", (unsigned long)sim->edges,
+           (unsigned long)sim->gpioIrqs, (unsigned long)sim->timerIrqs);
+    return result;
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name: decode_telemetry.c
+*
+* Description: Host decoder of the binary telemetry frames. Reads the bytes
+*              captured from the debug UART from a file or stdin, resyncs on
+*              the sync byte and the CRC, and prints one CSV line per frame
+*              with the speed, followed by a summary of lost frames and
+*              discarded bytes on stderr.
+*
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "telemetry.h"
+
+/* Timer ticks per second by default, see TIMER_FREQUENCY in tlx4966.h */
+#define TIMER_TICKS_PER_S   1000000.0
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-p pulses_per_rev] [-f timer_hz] [file]\n"
+                    "  reads stdin without a file, prints CSV on stdout\n"
+                    "  -f 10000000 for a build with TLx4966_CAPTURE\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    double pulses_per_rev = 1.0;
+    double ticks_per_s = TIMER_TICKS_PER_S;
+    uint8_t window[TELEMETRY_FRAME_SIZE];
+    uint32_t fill = 0;
+    uint32_t frames = 0;
+    uint32_t lost = 0;
+    uint32_t discarded = 0;
+    uint16_t next_sequence = 0;
+    uint32_t last_timestamp = 0;
+    uint64_t time_high = 0;
+    int c;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            pulses_per_rev = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc))
+        {
+            ticks_per_s = atof(argv[++i]);
+        }
+        else if ((argv[i][0] == '-') || (in != stdin))
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else if ((in = fopen(argv[i], "rb")) == NULL)
+        {
+            perror(argv[i]);
+            return 1;
+        }
+    }
+    if ((pulses_per_rev <= 0.0) || (ticks_per_s <= 0.0))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("sequence,time_s,period_us,count,direction,stopped,change,rpm\n");
+    while ((c = fgetc(in)) != EOF)
+    {
+        telemetry_frame_t frame;
+
+        window[fill++] = (uint8_t)c;
+        if (fill < TELEMETRY_FRAME_SIZE)
+        {
+            continue;
+        }
+
+        /* No frame here, drop the first byte and look for the next sync byte */
+        if (!Telemetry_decode(window, &frame))
+        {
+            uint32_t skip = 1;
+            while ((skip < fill) && (window[skip] != TELEMETRY_SYNC))
+            {
+                skip++;
+            }
+            discarded += skip;
+            fill -= skip;
+            memmove(window, &window[skip], fill);
+            continue;
+        }
+        fill = 0;
+
+        if ((frames != 0) && (frame.sequence != next_sequence))
+        {
+            lost += (uint16_t)(frame.sequence - next_sequence);
+        }
+        next_sequence = frame.sequence + 1u;
+
+        /* The timestamp wraps after 71 minutes at 1 MHz, 429 s at 10 MHz */
+        if ((frames != 0) && (frame.timestamp < last_timestamp))
+        {
+            time_high += 1ull << 32;
+        }
+        last_timestamp = frame.timestamp;
+        frames++;
+
+        printf("%u,%.7f,%.1f,%lu,%u,%u,%u,%.3f\n", frame.sequence,
+               (double)(time_high + frame.timestamp) / ticks_per_s,
+               frame.period * 1e6 / ticks_per_s, (unsigned long)frame.count,
+               (frame.flags & TELEMETRY_FLAG_DIR) ? 1u : 0u,
+               (frame.flags & TELEMETRY_FLAG_STOPPED) ? 1u : 0u,
+               (frame.flags & TELEMETRY_FLAG_CHANGE) ? 1u : 0u,
+               (frame.period != 0) ? 60.0 * ticks_per_s / (frame.period * pulses_per_rev) : 0.0);
+    }
+    discarded += fill;
+
+    fprintf(stderr, "%u frames, %u lost, %u bytes discarded\n", frames, lost, discarded);
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name: cy_pdl.h
+*
+* Description: Host stand-in for the parts of the PSoC 6 PDL used by the
+*              TLx4966 driver: clock divider types, TCPWM counters in
+*              capture mode, the trigger multiplexer and HSIOM.
+*
+*******************************************************************************/
+
+#ifndef HOST_CY_PDL_H_
+#define HOST_CY_PDL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define CY_SYSCLK_DIV_24_5_BIT          (3)
+
+typedef struct
+{
+    uint32_t block;
+} TCPWM_Type;
+
+extern TCPWM_Type TLx4966_SIM_tcpwm0;
+#define TCPWM0 (&TLx4966_SIM_tcpwm0)
+
+typedef struct
+{
+    uint32_t period;
+    uint32_t clockPrescaler;
+    uint32_t runMode;
+    uint32_t countDirection;
+    uint32_t compareOrCapture;
+    uint32_t compare0;
+    uint32_t compare1;
+    bool enableCompareSwap;
+    uint32_t interruptSources;
+    uint32_t captureInputMode;
+    uint32_t captureInput;
+    uint32_t reloadInputMode;
+    uint32_t reloadInput;
+    uint32_t startInputMode;
+    uint32_t startInput;
+    uint32_t stopInputMode;
+    uint32_t stopInput;
+    uint32_t countInputMode;
+    uint32_t countInput;
+} cy_stc_tcpwm_counter_config_t;
+
+#define CY_TCPWM_SUCCESS                        (0U)
+#define CY_TCPWM_COUNTER_PRESCALER_DIVBY_1      (0U)
+#define CY_TCPWM_COUNTER_CONTINUOUS             (0U)
+#define CY_TCPWM_COUNTER_COUNT_UP               (0U)
+#define CY_TCPWM_COUNTER_MODE_COMPARE           (0U)
+#define CY_TCPWM_COUNTER_MODE_CAPTURE           (2U)
+#define CY_TCPWM_INT_ON_CC                      (2U)
+#define CY_TCPWM_INPUT_RISINGEDGE               (0U)
+#define CY_TCPWM_INPUT_FALLINGEDGE              (1U)
+#define CY_TCPWM_INPUT_EITHEREDGE               (2U)
+#define CY_TCPWM_INPUT_LEVEL                    (3U)
+#define CY_TCPWM_INPUT_0                        (0U)
+#define CY_TCPWM_INPUT_1                        (1U)
+#define CY_TCPWM_INPUT_TRIG(n)                  ((uint32_t)(n) + 2U)
+
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, const cy_stc_tcpwm_counter_config_t *config);
+void Cy_TCPWM_Counter_Disable(TCPWM_Type *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_Counter_GetCapture(const TCPWM_Type *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_Counter_GetCaptureBuf(const TCPWM_Type *base, uint32_t cntNum);
+uint32_t Cy_TCPWM_Counter_GetCounter(const TCPWM_Type *base, uint32_t cntNum);
+
+typedef enum
+{
+    TRIGGER_TYPE_LEVEL = 0,
+    TRIGGER_TYPE_EDGE = 1
+} en_trig_type_t;
+
+#define CY_TRIGMUX_SUCCESS                      (0U)
+
+uint32_t Cy_TrigMux_Connect(uint32_t inTrig, uint32_t outTrig, bool invert, en_trig_type_t trigType);
+
+typedef uint32_t en_hsiom_sel_t;
+typedef struct
+{
+    uint32_t port;
+} GPIO_PRT_Type;
+
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, en_hsiom_sel_t value);
+
+#endif /* HOST_CY_PDL_H_ */
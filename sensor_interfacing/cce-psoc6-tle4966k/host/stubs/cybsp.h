@@ -0,0 +1,32 @@
+/******************************************************************************
+* File Name: cybsp.h
+*
+* Description: Host stand-in for the board support package header. Gives the
+*              trigger routes of the speed and direction pins in the model:
+*              the HSIOM setting is the trigger multiplexer input, and the
+*              multiplexer output is the TCPWM trigger input.
+*
+*******************************************************************************/
+
+#ifndef HOST_CYBSP_H_
+#define HOST_CYBSP_H_
+
+#include "cyhal.h"
+
+#define CYBSP_BTN_OFF (1U)
+
+#ifndef TLx4966_SPEED_HSIOM
+#define TLx4966_SPEED_HSIOM         (1U)
+#define TLx4966_SPEED_TRIG_SRC      (1U)
+#define TLx4966_SPEED_TRIG_DEST     (0U)
+#define TLx4966_SPEED_TRIG_LINE     (0U)
+#endif
+
+#ifndef TLx4966_DIR_HSIOM
+#define TLx4966_DIR_HSIOM           (2U)
+#define TLx4966_DIR_TRIG_SRC        (2U)
+#define TLx4966_DIR_TRIG_DEST       (1U)
+#define TLx4966_DIR_TRIG_LINE       (1U)
+#endif
+
+#endif /* HOST_CYBSP_H_ */
@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name: cyhal.h
+*
+* Description: Host stand-in for the parts of the PSoC 6 HAL used by the
+*              TLx4966 driver: GPIO, clock and timer. Only used to build the
+*              driver on a PC, host/tlx4966_sim.c implements the functions.
+*
+*******************************************************************************/
+
+#ifndef HOST_CYHAL_H_
+#define HOST_CYHAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "cy_pdl.h"
+
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0x00000000U)
+#define CY_ASSERT(x) do { if (!(x)) { abort(); } } while (0)
+
+#define CY_RSLT_TYPE_ERROR                  (2U)
+#define CY_RSLT_MODULE_MIDDLEWARE_BASE      (0x0A00U)
+#define CY_RSLT_CREATE(type, module, code) \
+    ((((type) & 0x3U) << 30) | (((module) & 0x3FFFU) << 16) | ((code) & 0xFFFFU))
+
+/* Pins are plain numbers on the host, the port is not modelled */
+typedef uint32_t cyhal_gpio_t;
+
+#define NC ((cyhal_gpio_t)0xFFFFFFFFU)
+#define CYHAL_GET_PORTADDR(pin) ((GPIO_PRT_Type *)NULL)
+#define CYHAL_GET_PIN(pin) ((uint32_t)(pin))
+
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_STRONG
+} cyhal_gpio_drive_mode_t;
+
+typedef enum
+{
+    CYHAL_GPIO_IRQ_NONE = 0,
+    CYHAL_GPIO_IRQ_RISE = 1,
+    CYHAL_GPIO_IRQ_FALL = 2,
+    CYHAL_GPIO_IRQ_BOTH = 3
+} cyhal_gpio_irq_event_t;
+
+typedef void (*cyhal_gpio_event_callback_t)(void *callback_arg, cyhal_gpio_irq_event_t event);
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction, cyhal_gpio_drive_mode_t drive_mode,
+                          bool init_val);
+bool cyhal_gpio_read(cyhal_gpio_t pin);
+void cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_event_callback_t callback, void *callback_arg);
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_irq_event_t event, uint8_t intr_priority, bool enable);
+
+typedef struct
+{
+    uint32_t frequency;
+} cyhal_clock_t;
+
+cy_rslt_t cyhal_clock_allocate(cyhal_clock_t *clock, int block);
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz, const void *tolerance);
+bool cyhal_clock_is_enabled(const cyhal_clock_t *clock);
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled, bool wait_for_lock);
+
+typedef struct
+{
+    uint8_t block_num;
+    uint8_t channel_num;
+} cyhal_resource_inst_t;
+
+typedef struct
+{
+    TCPWM_Type *base;
+    cyhal_resource_inst_t resource;
+} cyhal_tcpwm_t;
+
+typedef struct
+{
+    cyhal_tcpwm_t tcpwm;
+} cyhal_timer_t;
+
+typedef enum
+{
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN
+} cyhal_timer_direction_t;
+
+typedef struct
+{
+    bool is_continuous;
+    cyhal_timer_direction_t direction;
+    bool is_compare;
+    uint32_t period;
+    uint32_t compare_value;
+    uint32_t value;
+} cyhal_timer_cfg_t;
+
+typedef enum
+{
+    CYHAL_TIMER_IRQ_NONE = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT = 1,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 2,
+    CYHAL_TIMER_IRQ_ALL = 3
+} cyhal_timer_event_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void *callback_arg, cyhal_timer_event_t event);
+
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin, const cyhal_clock_t *clk);
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj, const cyhal_timer_cfg_t *cfg);
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj);
+uint32_t cyhal_timer_read(const cyhal_timer_t *obj);
+void cyhal_timer_register_callback(cyhal_timer_t *obj, cyhal_timer_event_callback_t callback, void *callback_arg);
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event, uint8_t intr_priority, bool enable);
+
+uint32_t cyhal_system_critical_section_enter(void);
+void cyhal_system_critical_section_exit(uint32_t old_state);
+
+#endif /* HOST_CYHAL_H_ */
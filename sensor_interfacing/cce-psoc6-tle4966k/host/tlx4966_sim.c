@@ -0,0 +1,413 @@
+/******************************************************************************
+* File Name: tlx4966_sim.c
+*
+* Description: Host implementation of the HAL and PDL calls used by the
+*              TLx4966 driver. GPIO pins hold a level and one event callback.
+*              Timers count the virtual time at their clock frequency, or the
+*              edges of their count input. A counter in capture mode latches
+*              its count on the edges of its capture input, the previous
+*              capture moves to the buffer register. Configuring a timer or
+*              initializing a counter restarts its count. A pin drives the
+*              trigger multiplexer input given by its HSIOM setting, and
+*              multiplexer output n is trigger input n of the TCPWM block.
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include "cy_pdl.h"
+#include "cyhal.h"
+#include "tlx4966_sim.h"
+
+typedef struct
+{
+    bool level;
+    en_hsiom_sel_t hsiom;               /* trigger multiplexer input it drives, 0 for none */
+    cyhal_gpio_event_callback_t callback;
+    void *callbackArg;
+    uint32_t events;
+    cyhal_gpio_irq_event_t pending;     /* edges waiting for the handler */
+} TLx4966_SIM_pin_t;
+
+typedef struct
+{
+    uint32_t hz;
+    uint32_t offset;                    /* clock ticks at which the counter was 0 */
+    bool capture;                       /* counter in capture mode */
+    uint32_t captureInput;
+    uint32_t captureInputMode;
+    uint32_t countInput;                /* CY_TCPWM_INPUT_1 counts the clock */
+    uint32_t countInputMode;
+    uint32_t edges;                     /* count of a counter that counts an input */
+    uint32_t cc;                        /* capture register */
+    uint32_t ccBuff;                    /* capture buffer register */
+    cyhal_timer_event_callback_t callback;
+    void *callbackArg;
+    uint32_t events;
+    bool pending;                       /* capture waiting for the handler */
+} TLx4966_SIM_timer_t;
+
+TCPWM_Type TLx4966_SIM_tcpwm0;
+
+static uint64_t simNow;
+static TLx4966_SIM_pin_t simPins[TLx4966_SIM_MAX_PINS];
+static TLx4966_SIM_timer_t simTimers[TLx4966_SIM_MAX_TIMERS];
+static uint32_t simTimerCount;
+static uint32_t simMux[TLx4966_SIM_MAX_LINES];     /* multiplexer input of each TCPWM trigger input, 0 for none */
+static bool simPending;
+static TLx4966_SIM_stats_t simStats;
+
+void TLx4966_SIM_reset(void)
+{
+    simNow = 0U;
+    memset(simPins, 0, sizeof(simPins));
+    memset(simTimers, 0, sizeof(simTimers));
+    simTimerCount = 0U;
+    memset(simMux, 0, sizeof(simMux));
+    simPending = false;
+    memset(&simStats, 0, sizeof(simStats));
+}
+
+uint64_t TLx4966_SIM_now(void)
+{
+    return simNow;
+}
+
+/* Time only moves forward, a handler may already have run past timeNs */
+void TLx4966_SIM_advance(uint64_t timeNs)
+{
+    if (timeNs > simNow)
+    {
+        simNow = timeNs;
+    }
+}
+
+static uint32_t TLx4966_SIM_ticks(const TLx4966_SIM_timer_t *timer, uint64_t timeNs)
+{
+    /* A counter of an input counts its edges */
+    if (timer->countInput != CY_TCPWM_INPUT_1)
+    {
+        return timer->edges;
+    }
+    /* Split at whole seconds so the product can't overflow, the 32 bit
+     * counter wraps like the hardware */
+    return (uint32_t)((timeNs / 1000000000ULL) * timer->hz + (timeNs % 1000000000ULL) * timer->hz / 1000000000ULL)
+           - timer->offset;
+}
+
+/* The counter reads value from now on */
+static void TLx4966_SIM_setCounter(TLx4966_SIM_timer_t *timer, uint32_t value)
+{
+    timer->edges = value;
+    timer->offset = 0U;
+    timer->offset = TLx4966_SIM_ticks(timer, simNow) - value;
+}
+
+/* The pin reaches the counter input through HSIOM and the trigger multiplexer,
+ * and the input mode takes the edge */
+static bool TLx4966_SIM_triggers(const TLx4966_SIM_pin_t *p, uint32_t input, uint32_t mode, bool rising)
+{
+    uint32_t line = input - CY_TCPWM_INPUT_TRIG(0);
+
+    if ((input < CY_TCPWM_INPUT_TRIG(0)) || (line >= TLx4966_SIM_MAX_LINES) ||
+        (p->hsiom == 0U) || (simMux[line] != p->hsiom))
+    {
+        return false;
+    }
+    return (mode == CY_TCPWM_INPUT_EITHEREDGE) ||
+           (mode == (rising ? CY_TCPWM_INPUT_RISINGEDGE : CY_TCPWM_INPUT_FALLINGEDGE));
+}
+
+/* The counters count and capture at the edge, the handlers wait for
+ * TLx4966_SIM_runPending() */
+void TLx4966_SIM_setLevel(cyhal_gpio_t pin, bool level, uint64_t timeNs)
+{
+    TLx4966_SIM_pin_t *p = &simPins[pin];
+    cyhal_gpio_irq_event_t edge = level ? CYHAL_GPIO_IRQ_RISE : CYHAL_GPIO_IRQ_FALL;
+
+    TLx4966_SIM_advance(timeNs);
+    if (p->level == level)
+    {
+        return;
+    }
+    p->level = level;
+
+    /* Counting first, a capture on the same edge sees the new count */
+    for (uint32_t i = 0; i < simTimerCount; i++)
+    {
+        TLx4966_SIM_timer_t *timer = &simTimers[i];
+        if (TLx4966_SIM_triggers(p, timer->countInput, timer->countInputMode, level))
+        {
+            timer->edges++;
+        }
+    }
+    for (uint32_t i = 0; i < simTimerCount; i++)
+    {
+        TLx4966_SIM_timer_t *timer = &simTimers[i];
+        if (timer->capture && TLx4966_SIM_triggers(p, timer->captureInput, timer->captureInputMode, level))
+        {
+            timer->ccBuff = timer->cc;
+            timer->cc = TLx4966_SIM_ticks(timer, timeNs);
+            if ((timer->events & CYHAL_TIMER_IRQ_CAPTURE_COMPARE) != 0U)
+            {
+                timer->pending = true;
+                simPending = true;
+            }
+        }
+    }
+    if ((p->events & (uint32_t)edge) != 0U)
+    {
+        p->pending = (cyhal_gpio_irq_event_t)(p->pending | edge);
+        simPending = true;
+    }
+}
+
+/* Runs every handler with an event waiting once, like the NVIC */
+void TLx4966_SIM_runPending(void)
+{
+    if (!simPending)
+    {
+        return;
+    }
+    simPending = false;
+    for (uint32_t i = 0; i < TLx4966_SIM_MAX_PINS; i++)
+    {
+        TLx4966_SIM_pin_t *p = &simPins[i];
+        cyhal_gpio_irq_event_t event = p->pending;
+        p->pending = CYHAL_GPIO_IRQ_NONE;
+        if ((event != CYHAL_GPIO_IRQ_NONE) && (p->callback != NULL))
+        {
+            simStats.gpioIrqs++;
+            p->callback(p->callbackArg, event);
+        }
+    }
+    for (uint32_t i = 0; i < simTimerCount; i++)
+    {
+        TLx4966_SIM_timer_t *timer = &simTimers[i];
+        bool pending = timer->pending;
+        timer->pending = false;
+        if (pending && (timer->callback != NULL))
+        {
+            simStats.timerIrqs++;
+            timer->callback(timer->callbackArg, CYHAL_TIMER_IRQ_CAPTURE_COMPARE);
+        }
+    }
+}
+
+/* A pulse on the pin, the handlers run latencyNs after the rising edge. A pin
+ * left high by its pull-up goes low first */
+void TLx4966_SIM_risingEdge(cyhal_gpio_t pin, uint64_t timeNs, uint32_t latencyNs)
+{
+    simStats.edges++;
+    TLx4966_SIM_setLevel(pin, false, timeNs);
+    TLx4966_SIM_setLevel(pin, true, timeNs);
+    TLx4966_SIM_advance(timeNs + latencyNs);
+    TLx4966_SIM_runPending();
+    TLx4966_SIM_setLevel(pin, false, simNow);
+}
+
+const TLx4966_SIM_stats_t *TLx4966_SIM_getStats(void)
+{
+    return &simStats;
+}
+
+/* HAL GPIO */
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction, cyhal_gpio_drive_mode_t drive_mode,
+                          bool init_val)
+{
+    (void)direction;
+    (void)drive_mode;
+    if (pin >= TLx4966_SIM_MAX_PINS)
+    {
+        return ~CY_RSLT_SUCCESS;
+    }
+    simPins[pin].level = init_val;
+    return CY_RSLT_SUCCESS;
+}
+
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    return simPins[pin].level;
+}
+
+void cyhal_gpio_register_callback(cyhal_gpio_t pin, cyhal_gpio_event_callback_t callback, void *callback_arg)
+{
+    simPins[pin].callback = callback;
+    simPins[pin].callbackArg = callback_arg;
+}
+
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_irq_event_t event, uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+    if (enable)
+    {
+        simPins[pin].events |= (uint32_t)event;
+    }
+    else
+    {
+        simPins[pin].events &= ~(uint32_t)event;
+    }
+}
+
+/* HAL clock */
+
+cy_rslt_t cyhal_clock_allocate(cyhal_clock_t *clock, int block)
+{
+    (void)block;
+    clock->frequency = 0U;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz, const void *tolerance)
+{
+    (void)tolerance;
+    clock->frequency = hz;
+    return CY_RSLT_SUCCESS;
+}
+
+bool cyhal_clock_is_enabled(const cyhal_clock_t *clock)
+{
+    (void)clock;
+    return true;
+}
+
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled, bool wait_for_lock)
+{
+    (void)clock;
+    (void)enabled;
+    (void)wait_for_lock;
+    return CY_RSLT_SUCCESS;
+}
+
+/* HAL timer, all counters of TCPWM0 */
+
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin, const cyhal_clock_t *clk)
+{
+    (void)pin;
+    if (simTimerCount >= TLx4966_SIM_MAX_TIMERS)
+    {
+        return ~CY_RSLT_SUCCESS;
+    }
+    obj->tcpwm.base = TCPWM0;
+    obj->tcpwm.resource.block_num = 0U;
+    obj->tcpwm.resource.channel_num = (uint8_t)simTimerCount;
+    simTimers[simTimerCount].hz = ((clk != NULL) && (clk->frequency != 0U)) ? clk->frequency : TLx4966_SIM_DEFAULT_HZ;
+    simTimers[simTimerCount].countInput = CY_TCPWM_INPUT_1;
+    simTimerCount++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj, const cyhal_timer_cfg_t *cfg)
+{
+    TLx4966_SIM_setCounter(&simTimers[obj->tcpwm.resource.channel_num], cfg->value);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj)
+{
+    (void)obj;
+    return CY_RSLT_SUCCESS;
+}
+
+uint32_t cyhal_timer_read(const cyhal_timer_t *obj)
+{
+    return TLx4966_SIM_ticks(&simTimers[obj->tcpwm.resource.channel_num], simNow);
+}
+
+void cyhal_timer_register_callback(cyhal_timer_t *obj, cyhal_timer_event_callback_t callback, void *callback_arg)
+{
+    simTimers[obj->tcpwm.resource.channel_num].callback = callback;
+    simTimers[obj->tcpwm.resource.channel_num].callbackArg = callback_arg;
+}
+
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event, uint8_t intr_priority, bool enable)
+{
+    TLx4966_SIM_timer_t *timer = &simTimers[obj->tcpwm.resource.channel_num];
+
+    (void)intr_priority;
+    if (enable)
+    {
+        timer->events |= (uint32_t)event;
+    }
+    else
+    {
+        timer->events &= ~(uint32_t)event;
+    }
+}
+
+/* Handlers only run from TLx4966_SIM_risingEdge(), nothing can interrupt the caller */
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    return 0U;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+}
+
+/* PDL */
+
+uint32_t Cy_TCPWM_Counter_Init(TCPWM_Type *base, uint32_t cntNum, const cy_stc_tcpwm_counter_config_t *config)
+{
+    TLx4966_SIM_timer_t *timer = &simTimers[cntNum];
+
+    (void)base;
+    timer->capture = (config->compareOrCapture == CY_TCPWM_COUNTER_MODE_CAPTURE);
+    timer->captureInput = config->captureInput;
+    timer->captureInputMode = config->captureInputMode;
+    timer->countInput = config->countInput;
+    timer->countInputMode = config->countInputMode;
+    /* Like the PDL, an up counter restarts at 0 and a down counter at the period */
+    TLx4966_SIM_setCounter(timer, (config->countDirection == CY_TCPWM_COUNTER_COUNT_UP) ? 0U : config->period);
+    timer->cc = config->compare0;
+    timer->ccBuff = config->compare1;
+    return CY_TCPWM_SUCCESS;
+}
+
+void Cy_TCPWM_Counter_Disable(TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    (void)cntNum;
+}
+
+uint32_t Cy_TCPWM_Counter_GetCapture(const TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    return simTimers[cntNum].cc;
+}
+
+uint32_t Cy_TCPWM_Counter_GetCaptureBuf(const TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    return simTimers[cntNum].ccBuff;
+}
+
+uint32_t Cy_TCPWM_Counter_GetCounter(const TCPWM_Type *base, uint32_t cntNum)
+{
+    (void)base;
+    return TLx4966_SIM_ticks(&simTimers[cntNum], simNow);
+}
+
+/* Output n of the multiplexer is trigger input n of the TCPWM block */
+uint32_t Cy_TrigMux_Connect(uint32_t inTrig, uint32_t outTrig, bool invert, en_trig_type_t trigType)
+{
+    (void)invert;
+    (void)trigType;
+    if (outTrig >= TLx4966_SIM_MAX_LINES)
+    {
+        return ~CY_TRIGMUX_SUCCESS;
+    }
+    simMux[outTrig] = inTrig;
+    return CY_TRIGMUX_SUCCESS;
+}
+
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, en_hsiom_sel_t value)
+{
+    (void)base;
+    if (pinNum < TLx4966_SIM_MAX_PINS)
+    {
+        simPins[pinNum].hsiom = value;
+    }
+}
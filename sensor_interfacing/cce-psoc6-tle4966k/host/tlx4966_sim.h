@@ -0,0 +1,41 @@
+/******************************************************************************
+* File Name: tlx4966_sim.h
+*
+* Description: Model of the GPIO, clock and timer behind the host versions of
+*              the HAL and PDL calls used by the TLx4966 driver. Time is
+*              virtual: the bench moves it forward and drives the pins. The
+*              counters count and latch the capture registers at the edge,
+*              the interrupt handlers run when the bench lets them.
+*
+*******************************************************************************/
+
+#ifndef TLX4966_SIM_H_
+#define TLX4966_SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cyhal.h"
+
+#define TLx4966_SIM_MAX_PINS        64U
+#define TLx4966_SIM_MAX_TIMERS      4U
+#define TLx4966_SIM_MAX_LINES       8U         /* trigger inputs of the TCPWM block */
+#define TLx4966_SIM_DEFAULT_HZ      1000000U   /* timer clock without a clock object */
+
+/* Counts since the last TLx4966_SIM_reset() */
+typedef struct
+{
+    uint32_t edges;         /* pulses of TLx4966_SIM_risingEdge() */
+    uint32_t gpioIrqs;      /* GPIO handler calls */
+    uint32_t timerIrqs;     /* timer capture handler calls, speed and odometer */
+} TLx4966_SIM_stats_t;
+
+void TLx4966_SIM_reset(void);
+uint64_t TLx4966_SIM_now(void);
+void TLx4966_SIM_advance(uint64_t timeNs);
+void TLx4966_SIM_setLevel(cyhal_gpio_t pin, bool level, uint64_t timeNs);
+void TLx4966_SIM_runPending(void);
+void TLx4966_SIM_risingEdge(cyhal_gpio_t pin, uint64_t timeNs, uint32_t latencyNs);
+const TLx4966_SIM_stats_t *TLx4966_SIM_getStats(void);
+
+#endif /* TLX4966_SIM_H_ */
@@ -44,6 +44,47 @@
 #include "cybsp.h"
 #include "cy_retarget_io.h"
 #include "tlx4966.h"
+#include "telemetry.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 1, e.g. with DEFINES+=TLx4966_TELEMETRY=1 in the Makefile, to send
+ * binary frames, see telemetry.h, instead of text and sleep between them */
+#ifndef TLx4966_TELEMETRY
+#define TLx4966_TELEMETRY 0
+#endif
+
+/* The CPU wakes up and decides about a frame every tick, so at most one frame
+ * is sent per tick. A frame takes 1.6 ms at 115200 baud */
+#define TELEMETRY_TICK_MS           (10u)
+
+/* A frame at least this often, 0 for frames on change only */
+#define TELEMETRY_INTERVAL_MS       (100u)
+
+/* Set to 1 to send a frame as soon as the direction, the stop state or the
+ * period change, the period by more than 1 / 2^TELEMETRY_CHANGE_SHIFT */
+#define TELEMETRY_ON_CHANGE         (1u)
+#define TELEMETRY_CHANGE_SHIFT      (4u)
+
+#define TELEMETRY_TIMER_FREQUENCY   (10000u)
+#define TELEMETRY_TIMER_PRIORITY    (7u)
+
+#if TLx4966_TELEMETRY
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void telemetry_run(void);
+static void telemetry_timer_handler(void *handler_arg, cyhal_timer_event_t event);
+static bool telemetry_changed(const telemetry_frame_t *frame, const telemetry_frame_t *sent);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Timer waking the CPU every TELEMETRY_TICK_MS */
+cyhal_timer_t telemetry_timer;
+volatile bool telemetry_tick;
+#endif
 
 /*******************************************************************************
 * Function Name: main
@@ -63,8 +104,13 @@
 int main(void)
 {
     cy_rslt_t result;
+#if !TLx4966_TELEMETRY
     uint8_t dir, prev_dir = 0;
     float speed, prev_speed = 0;
+#if TLx4966_ODOMETER
+    int32_t position, prev_position = 0;
+#endif
+#endif
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -88,12 +134,14 @@ int main(void)
         CY_ASSERT(0);
     }
 
+#if !TLx4966_TELEMETRY
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
     printf("\x1b[2J\x1b[;H");
 
     printf("********************************************************************\r\n"
            "Interfacing Infineon TLE4966K Direction and Speed Sensor with PSoC 6\r\n"
            "********************************************************************\r\n\n");
+#endif
 
     /* Initialize resources required for Direction and Speed measurement from TLE4966K*/
     result = TLx4966_init(P10_0, P10_3, TLx4966_SPEED_COEF_RPM);
@@ -103,12 +151,31 @@ int main(void)
         CY_ASSERT(0);
     }
 
+#if TLx4966_TELEMETRY
+    telemetry_run();
+#else
     for (;;)
     {
         /* Read the current speed and direction */
         speed = TLx4966_readSpeed();
         dir = TLx4966_readDir();
 
+#if TLx4966_ODOMETER
+        position = TLx4966_readPosition();
+
+        /* Print the data only when the speed, direction or position changes */
+        if(speed != prev_speed || dir != prev_dir || position != prev_position)
+        {
+            printf("Speed = %f %s   \r\nDirection = %d\r\n", speed, SPEED_UNIT, dir);
+            printf("Position = %ld pulses, %ld revolutions   \r\n", (long)position,
+                   (long)(position / (int32_t)TLx4966_PULSES_PER_REV));
+            prev_speed = speed;
+            prev_dir = dir;
+            prev_position = position;
+            /* Move cursor to previous line */
+            printf("\x1b[1F\x1b[1F\x1b[1F");
+        }
+#else
         /* Print the data only when the speed or direction changes */
         if(speed != prev_speed || dir != prev_dir)
         {
@@ -118,7 +185,143 @@ int main(void)
             /* Move cursor to previous line */
             printf("\x1b[1F\x1b[1F");
         }
+#endif
     }
+#endif /* TLx4966_TELEMETRY */
+}
+
+#if TLx4966_TELEMETRY
+/*******************************************************************************
+* Function Name: telemetry_run
+********************************************************************************
+* Summary:
+*  Sends telemetry frames on the debug UART, every TELEMETRY_INTERVAL_MS and on
+*  changes. Between the ticks the CPU sleeps, the speed edges wake it up only
+*  for their interrupt. The frames are written with cyhal_uart_write, as the
+*  retarget-io output would insert a carriage return before every 0x0A byte.
+*
+*******************************************************************************/
+static void telemetry_run(void)
+{
+    cy_rslt_t result;
+    uint8_t buffer[TELEMETRY_FRAME_SIZE];
+    telemetry_frame_t frame = {0};
+    telemetry_frame_t sent = {0};
+    uint32_t since_sent = 0;
+    uint32_t intr_state;
+    size_t length;
+    bool send;
+
+    const cyhal_timer_cfg_t timer_cfg =
+    {
+        .compare_value = 0,
+        .period = TELEMETRY_TICK_MS * (TELEMETRY_TIMER_FREQUENCY / 1000u) - 1u,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .is_continuous = true,
+        .value = 0
+    };
+
+    result = cyhal_timer_init(&telemetry_timer, NC, NULL);
+    result |= cyhal_timer_configure(&telemetry_timer, &timer_cfg);
+    result |= cyhal_timer_set_frequency(&telemetry_timer, TELEMETRY_TIMER_FREQUENCY);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    cyhal_timer_register_callback(&telemetry_timer, telemetry_timer_handler, NULL);
+    cyhal_timer_enable_event(&telemetry_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                             TELEMETRY_TIMER_PRIORITY, true);
+    cyhal_timer_start(&telemetry_timer);
+
+    for (;;)
+    {
+        /* With interrupts masked a tick can't slip in between the check and
+         * the sleep, a pending interrupt still ends the sleep */
+        intr_state = cyhal_system_critical_section_enter();
+        if (!telemetry_tick)
+        {
+            cyhal_syspm_sleep();
+        }
+        cyhal_system_critical_section_exit(intr_state);
+        if (!telemetry_tick)
+        {
+            continue;
+        }
+        telemetry_tick = false;
+        since_sent += TELEMETRY_TICK_MS;
+
+        frame.timestamp = cyhal_timer_read(&timer_obj);
+        frame.period = TLx4966_readPeriod();
+        frame.count = TLx4966_readCount();
+        frame.flags = (TLx4966_readDir() != 0) ? TELEMETRY_FLAG_DIR : 0;
+        if (frame.period == 0)
+        {
+            frame.flags |= TELEMETRY_FLAG_STOPPED;
+        }
+
+        send = (TELEMETRY_INTERVAL_MS != 0) && (since_sent >= TELEMETRY_INTERVAL_MS);
+        if (!send && TELEMETRY_ON_CHANGE && telemetry_changed(&frame, &sent))
+        {
+            frame.flags |= TELEMETRY_FLAG_CHANGE;
+            send = true;
+        }
+        if (send)
+        {
+            Telemetry_encode(&frame, buffer);
+            length = TELEMETRY_FRAME_SIZE;
+            cyhal_uart_write(&cy_retarget_io_uart_obj, buffer, &length);
+            sent = frame;
+            frame.sequence++;
+            since_sent = 0;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: telemetry_changed
+********************************************************************************
+* Summary:
+*  Compares a frame with the last one sent.
+*
+* Parameters:
+*  frame            frame taken now
+*  sent             frame sent last
+*
+* Return:
+*  bool    true if the direction or the stop state differ, or the period by
+*          more than 1 / 2^TELEMETRY_CHANGE_SHIFT
+*
+*******************************************************************************/
+static bool telemetry_changed(const telemetry_frame_t *frame, const telemetry_frame_t *sent)
+{
+    const uint8_t state = TELEMETRY_FLAG_DIR | TELEMETRY_FLAG_STOPPED;
+    uint32_t diff;
+
+    if ((frame->flags & state) != (sent->flags & state))
+    {
+        return true;
+    }
+    diff = (frame->period > sent->period) ? frame->period - sent->period
+                                          : sent->period - frame->period;
+    return diff > (sent->period >> TELEMETRY_CHANGE_SHIFT);
+}
+
+/*******************************************************************************
+* Function Name: telemetry_timer_handler
+********************************************************************************
+* Summary:
+*   Telemetry tick interrupt handler.
+*
+* Parameters:
+*  handler_arg (unused)
+*  event (unused)
+*
+*******************************************************************************/
+static void telemetry_timer_handler(void *handler_arg, cyhal_timer_event_t event)
+{
+    telemetry_tick = true;
 }
+#endif /* TLx4966_TELEMETRY */
 
 /* [] END OF FILE */
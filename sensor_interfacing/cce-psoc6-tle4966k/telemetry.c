@@ -0,0 +1,181 @@
+/******************************************************************************
+* File Name:   telemetry.c
+*
+* Description: This file contains the encoder and decoder of the binary
+*              telemetry frames.
+*
+*******************************************************************************
+* (c) 2021, Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "telemetry.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void put_u16(uint8_t *buffer, uint16_t value);
+static void put_u32(uint8_t *buffer, uint32_t value);
+static uint16_t get_u16(const uint8_t *buffer);
+static uint32_t get_u32(const uint8_t *buffer);
+
+/*******************************************************************************
+* Function Name: Telemetry_encode
+********************************************************************************
+* Summary:
+*  Writes a frame into a buffer of TELEMETRY_FRAME_SIZE bytes.
+*
+* Parameters:
+*  frame            frame contents
+*  buffer           TELEMETRY_FRAME_SIZE bytes
+*
+*******************************************************************************/
+void Telemetry_encode(const telemetry_frame_t *frame, uint8_t *buffer)
+{
+    buffer[0] = TELEMETRY_SYNC;
+    buffer[1] = frame->flags;
+    put_u16(&buffer[2], frame->sequence);
+    put_u32(&buffer[4], frame->timestamp);
+    put_u32(&buffer[8], frame->period);
+    put_u32(&buffer[12], frame->count);
+    put_u16(&buffer[16], Telemetry_crc(buffer, TELEMETRY_FRAME_SIZE - 2u));
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_decode
+********************************************************************************
+* Summary:
+*  Reads a frame from TELEMETRY_FRAME_SIZE bytes if they start with the sync
+*  byte and the CRC matches.
+*
+* Parameters:
+*  buffer           TELEMETRY_FRAME_SIZE bytes
+*  frame            returns the frame contents
+*
+* Return:
+*  bool    true if the bytes are a valid frame
+*
+*******************************************************************************/
+bool Telemetry_decode(const uint8_t *buffer, telemetry_frame_t *frame)
+{
+    if ((buffer[0] != TELEMETRY_SYNC) ||
+        (get_u16(&buffer[16]) != Telemetry_crc(buffer, TELEMETRY_FRAME_SIZE - 2u)))
+    {
+        return false;
+    }
+    frame->flags = buffer[1];
+    frame->sequence = get_u16(&buffer[2]);
+    frame->timestamp = get_u32(&buffer[4]);
+    frame->period = get_u32(&buffer[8]);
+    frame->count = get_u32(&buffer[12]);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Telemetry_crc
+********************************************************************************
+* Summary:
+*  CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF, bitwise. A
+*  frame is only 16 bytes, a table would not pay off.
+*
+* Parameters:
+*  data             bytes to check
+*  length           number of bytes
+*
+* Return:
+*  uint16_t    CRC
+*
+*******************************************************************************/
+uint16_t Telemetry_crc(const uint8_t *data, uint32_t length)
+{
+    uint16_t crc = 0xFFFFu;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8u; bit++)
+        {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: put_u16
+********************************************************************************
+* Summary:
+*  Stores a 16 bit value little endian.
+*
+*******************************************************************************/
+static void put_u16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+}
+
+/*******************************************************************************
+* Function Name: put_u32
+********************************************************************************
+* Summary:
+*  Stores a 32 bit value little endian.
+*
+*******************************************************************************/
+static void put_u32(uint8_t *buffer, uint32_t value)
+{
+    put_u16(&buffer[0], (uint16_t)value);
+    put_u16(&buffer[2], (uint16_t)(value >> 16));
+}
+
+/*******************************************************************************
+* Function Name: get_u16
+********************************************************************************
+* Summary:
+*  Loads a 16 bit value stored little endian.
+*
+*******************************************************************************/
+static uint16_t get_u16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | ((uint16_t)buffer[1] << 8));
+}
+
+/*******************************************************************************
+* Function Name: get_u32
+********************************************************************************
+* Summary:
+*  Loads a 32 bit value stored little endian.
+*
+*******************************************************************************/
+static uint32_t get_u32(const uint8_t *buffer)
+{
+    return get_u16(&buffer[0]) | ((uint32_t)get_u16(&buffer[2]) << 16);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   telemetry.h
+*
+* Description: This file contains the layout of the binary telemetry frames
+*              and the declarations of their encoder and decoder. It is also
+*              compiled by the host decoder, so it only needs the C library.
+*
+*******************************************************************************
+* (c) 2021, Cypress Semiconductor Corporation. All rights reserved.
+*******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software"), is owned by Cypress Semiconductor Corporation or one of its
+* subsidiaries ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame layout, all fields little endian:
+ *  0       sync byte TELEMETRY_SYNC
+ *  1       flags, TELEMETRY_FLAG_...
+ *  2..3    sequence number, counts every frame sent
+ *  4..7    timestamp, timer ticks when the frame was taken, see TIMER_FREQUENCY
+ *  8..11   estimated pulse period in timer ticks, 0 when stopped
+ *  12..15  rising edges of the speed pin since start
+ *  16..17  CRC-16/CCITT-FALSE of bytes 0..15 */
+#define TELEMETRY_FRAME_SIZE    (18u)
+#define TELEMETRY_SYNC          (0xA5u)
+
+#define TELEMETRY_FLAG_DIR      (0x01u)     /* Level of the direction output */
+#define TELEMETRY_FLAG_STOPPED  (0x02u)     /* No edge within the timeout */
+#define TELEMETRY_FLAG_CHANGE   (0x04u)     /* Sent on a change, not on the interval */
+
+/* Frame contents */
+typedef struct
+{
+    uint8_t flags;
+    uint16_t sequence;
+    uint32_t timestamp;
+    uint32_t period;
+    uint32_t count;
+} telemetry_frame_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Telemetry_encode(const telemetry_frame_t *frame, uint8_t *buffer);
+bool Telemetry_decode(const uint8_t *buffer, telemetry_frame_t *frame);
+uint16_t Telemetry_crc(const uint8_t *data, uint32_t length);
+
+#endif /* TELEMETRY_H_ */
+
+/* [] END OF FILE */
@@ -36,25 +36,80 @@
 * indemnify Cypress against all liability.
 *******************************************************************************/
 
+#include <string.h>
+
 #include "tlx4966.h"
 
+#define EDGE_INDEX_MASK (TLx4966_EDGE_BUFFER_SIZE - 1u)
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
  static cy_rslt_t timer_init(void);
+#if TLx4966_CAPTURE
+static cy_rslt_t capture_init(cyhal_gpio_t speed_pin);
+static void capture_interrupt_handler(void *handler_arg, cyhal_timer_event_t event);
+#else
 static void gpio_interrupt_handler(void *handler_arg, cyhal_gpio_irq_event_t event);
+#endif
+#if TLx4966_CAPTURE || TLx4966_ODOMETER
+static cy_rslt_t route_init(cyhal_gpio_t pin, en_hsiom_sel_t hsiom, uint32_t trig_src, uint32_t trig_dest);
+#endif
+#if TLx4966_ODOMETER
+static cy_rslt_t odometer_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin);
+static void odometer_update(void);
+static void odometer_interrupt_handler(void *handler_arg, cyhal_timer_event_t event);
+#endif
+static void edge_push(uint32_t timestamp);
+static void estimate(uint32_t *pulses, uint32_t *ticks);
+static float speed_from(uint32_t pulses, uint32_t ticks);
 
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
+/* Timer object used to time the speed pulses */
+cyhal_timer_t timer_obj;
+
+/* Speed unit to measure */
+float speed_unit;
+
 /* Variable to hold the direction pin - Connected to Q1 of TLx4966l */
 cyhal_gpio_t dir_gpio;
 
-/* Time variables used to measure speed of rotation */
-uint32_t curr_time, prev_time;
+/* Timer ticks of the last TLx4966_EDGE_BUFFER_SIZE rising edges, written by
+ * the interrupt only. Edge n is at edge_time[n & EDGE_INDEX_MASK] */
+volatile uint32_t edge_time[TLx4966_EDGE_BUFFER_SIZE];
+
+/* Rising edges since TLx4966_init */
+volatile uint32_t edge_count;
+
+/* Estimator settings, window and timeout in timer ticks */
+TLx4966_estimator_t estimator;
+uint32_t window_ticks;
+uint32_t timeout_ticks;
+
+/* M-method: start of the running window and the pulses and ticks of the
+ * last one */
+uint32_t m_start_time, m_start_count;
+uint32_t m_pulses, m_ticks;
+
+/* Edge count at which the timeout was reached. The time since the newest edge
+ * wraps with the timer, so the speed stays 0 until the next edge instead */
+uint32_t timeout_count;
 
-/* Variable to store the measured speed */
-float speed;
+#if TLx4966_ODOMETER
+/* Counter of the speed pulses, it latches its count on every direction edge */
+cyhal_timer_t odometer_obj;
+
+/* Position at the last latched count, the count, and the direction since.
+ * Updated by the odometer interrupt and by TLx4966_readPosition */
+int32_t odo_position;
+uint32_t odo_capture;
+bool odo_up;
+
+/* Position set to 0 by TLx4966_resetPosition */
+int32_t odo_zero;
+#endif
 
 /*******************************************************************************
 * Function Name: TLx4966_init
@@ -87,14 +142,35 @@ cy_rslt_t TLx4966_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin, float user_
     result |= cyhal_gpio_init(dir_pin, CYHAL_GPIO_DIR_INPUT,
                     CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF);
     dir_gpio = dir_pin;
+
+    /* Initialize timer */
+    result |= timer_init();
+
+#if TLx4966_CAPTURE
+    /* The counter latches the edges, the CPU only reads the capture registers */
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = capture_init(speed_pin);
+    }
+#else
     /* Configure GPIO interrupt */
     cyhal_gpio_register_callback(speed_pin,
                                  gpio_interrupt_handler, NULL);
     cyhal_gpio_enable_event(speed_pin, CYHAL_GPIO_IRQ_RISE,
                                  GPIO_INTERRUPT_PRIORITY, true);
+#endif
 
-    /* Initialize timer */
-    result |= timer_init();
+#if TLx4966_ODOMETER
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = odometer_init(speed_pin, dir_pin);
+    }
+#endif
+
+    /* Only now, the capture setup restarts the counter the M-method window
+     * starts from */
+    TLx4966_setEstimator(TLx4966_DEFAULT_ESTIMATOR, TLx4966_DEFAULT_WINDOW_MS,
+                         TLx4966_DEFAULT_TIMEOUT_MS);
     return result;
 }
 
@@ -115,7 +191,7 @@ cy_rslt_t TLx4966_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin, float user_
 
     result = cyhal_clock_allocate(&clock_obj, CY_SYSCLK_DIV_24_5_BIT);
 
-    result |= cyhal_clock_set_frequency(&clock_obj, 1000, NULL);
+    result |= cyhal_clock_set_frequency(&clock_obj, TIMER_FREQUENCY, NULL);
     if (!cyhal_clock_is_enabled(&clock_obj))
     {
     	result |= cyhal_clock_set_enabled(&clock_obj, true, true);
@@ -145,6 +221,142 @@ cy_rslt_t TLx4966_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin, float user_
     return result;
  }
 
+#if TLx4966_CAPTURE || TLx4966_ODOMETER
+/*******************************************************************************
+* Function Name: route_init
+********************************************************************************
+* Summary:
+*  This function connects a pin to a TCPWM trigger input. The pin drives a
+*  peripheral trigger line and the trigger multiplexer passes the line on to
+*  the TCPWM block. The counters detect the edges themselves.
+*
+* Parameters:
+*  pin              GPIO already initialized as input
+*  hsiom            HSIOM setting connecting the pin to the trigger line
+*  trig_src         trigger multiplexer input of the line
+*  trig_dest        trigger multiplexer output to the TCPWM block
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t route_init(cyhal_gpio_t pin, en_hsiom_sel_t hsiom, uint32_t trig_src, uint32_t trig_dest)
+{
+    Cy_GPIO_SetHSIOM(CYHAL_GET_PORTADDR(pin), CYHAL_GET_PIN(pin), hsiom);
+    if (Cy_TrigMux_Connect(trig_src, trig_dest, false, TRIGGER_TYPE_LEVEL) != CY_TRIGMUX_SUCCESS)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+    return CY_RSLT_SUCCESS;
+}
+#endif /* TLx4966_CAPTURE || TLx4966_ODOMETER */
+
+#if TLx4966_CAPTURE
+/*******************************************************************************
+* Function Name: capture_init
+********************************************************************************
+* Summary:
+*  This function switches the timer counter to capture mode. The speed pin is
+*  connected to the capture input through the trigger multiplexer, every rising
+*  edge copies the counter to the capture register and the previous capture to
+*  the capture buffer register. The HAL timer keeps the counter and the clock
+*  reserved and dispatches the capture interrupt.
+*
+* Parameters:
+*  speed_pin        GPIO connected to Q2 of TLx4966
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t capture_init(cyhal_gpio_t speed_pin)
+{
+    TCPWM_Type *base = timer_obj.tcpwm.base;
+    uint32_t cnt_num = timer_obj.tcpwm.resource.channel_num;
+
+    const cy_stc_tcpwm_counter_config_t capture_cfg =
+    {
+        .period = TIMER_PERIOD,
+        .clockPrescaler = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture = CY_TCPWM_COUNTER_MODE_CAPTURE,
+        .compare0 = 0,
+        .compare1 = 0,
+        .enableCompareSwap = false,
+        .interruptSources = CY_TCPWM_INT_ON_CC,
+        .captureInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .captureInput = CY_TCPWM_INPUT_TRIG(TLx4966_SPEED_TRIG_LINE),
+        .reloadInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput = CY_TCPWM_INPUT_0,
+        .startInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput = CY_TCPWM_INPUT_0,
+        .stopInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput = CY_TCPWM_INPUT_0,
+        .countInputMode = CY_TCPWM_INPUT_LEVEL,     /* Count every clock */
+        .countInput = CY_TCPWM_INPUT_1
+    };
+
+    if (base != TLx4966_TCPWM)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    /* Route the pin to the capture input */
+    if (route_init(speed_pin, TLx4966_SPEED_HSIOM, TLx4966_SPEED_TRIG_SRC,
+                   TLx4966_SPEED_TRIG_DEST) != CY_RSLT_SUCCESS)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    /* Reconfigure the counter the HAL started in timer mode */
+    Cy_TCPWM_Counter_Disable(base, cnt_num);
+    if (Cy_TCPWM_Counter_Init(base, cnt_num, &capture_cfg) != CY_TCPWM_SUCCESS)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    cyhal_timer_register_callback(&timer_obj, capture_interrupt_handler, NULL);
+    cyhal_timer_enable_event(&timer_obj, CYHAL_TIMER_IRQ_CAPTURE_COMPARE,
+                             GPIO_INTERRUPT_PRIORITY, true);
+
+    return cyhal_timer_start(&timer_obj);
+}
+
+/*******************************************************************************
+* Function Name: capture_interrupt_handler
+********************************************************************************
+* Summary:
+*   Capture interrupt handler. It stores the latched edge timestamps, so
+*   neither the interrupt latency nor a late interrupt changes the periods.
+*
+* Parameters:
+*  handler_arg (unused)
+*  event (unused)
+*
+*******************************************************************************/
+static void capture_interrupt_handler(void *handler_arg, cyhal_timer_event_t event)
+{
+    TCPWM_Type *base = timer_obj.tcpwm.base;
+    uint32_t cnt_num = timer_obj.tcpwm.resource.channel_num;
+    uint32_t curr, prev;
+
+    /* Read again if an edge moved the registers between the two reads */
+    do
+    {
+        curr = Cy_TCPWM_Counter_GetCapture(base, cnt_num);
+        prev = Cy_TCPWM_Counter_GetCaptureBuf(base, cnt_num);
+    } while (curr != Cy_TCPWM_Counter_GetCapture(base, cnt_num));
+
+    /* Two edges came before the interrupt was served, the capture buffer
+     * still holds the first one */
+    if ((edge_count != 0) && (prev != edge_time[(edge_count - 1) & EDGE_INDEX_MASK]))
+    {
+        edge_push(prev);
+    }
+    edge_push(curr);
+}
+#else
 /*******************************************************************************
 * Function Name: gpio_interrupt_handler
 ********************************************************************************
@@ -158,16 +370,398 @@ cy_rslt_t TLx4966_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin, float user_
 *******************************************************************************/
 static void gpio_interrupt_handler(void *handler_arg, cyhal_gpio_irq_event_t event)
 {
-    curr_time = cyhal_timer_read(&timer_obj);
-    speed = (float) speed_unit/(curr_time - prev_time);
-    prev_time = curr_time;
+    edge_push(cyhal_timer_read(&timer_obj));
+}
+#endif /* TLx4966_CAPTURE */
+
+#if TLx4966_ODOMETER
+/*******************************************************************************
+* Function Name: odometer_init
+********************************************************************************
+* Summary:
+*  This function sets up a second counter that counts the rising edges of the
+*  speed pin and captures its count on both edges of the direction pin. The
+*  counter runs without the CPU, only a reversal of the direction raises an
+*  interrupt, which charges the pulses since the previous reversal to the
+*  position with the sign of the direction they were counted in.
+*
+* Parameters:
+*  speed_pin        GPIO connected to Q2 of TLx4966
+*  dir_pin          GPIO connected to Q1 of TLx4966
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t odometer_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin)
+{
+    cy_rslt_t result;
+    TCPWM_Type *base;
+    uint32_t cnt_num;
+
+    const cy_stc_tcpwm_counter_config_t odometer_cfg =
+    {
+        .period = TIMER_PERIOD,
+        .clockPrescaler = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture = CY_TCPWM_COUNTER_MODE_CAPTURE,
+        .compare0 = 0,
+        .compare1 = 0,
+        .enableCompareSwap = false,
+        .interruptSources = CY_TCPWM_INT_ON_CC,
+        .captureInputMode = CY_TCPWM_INPUT_EITHEREDGE,     /* Every reversal */
+        .captureInput = CY_TCPWM_INPUT_TRIG(TLx4966_DIR_TRIG_LINE),
+        .reloadInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .reloadInput = CY_TCPWM_INPUT_0,
+        .startInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .startInput = CY_TCPWM_INPUT_0,
+        .stopInputMode = CY_TCPWM_INPUT_RISINGEDGE,
+        .stopInput = CY_TCPWM_INPUT_0,
+        .countInputMode = CY_TCPWM_INPUT_RISINGEDGE,       /* Every speed pulse */
+        .countInput = CY_TCPWM_INPUT_TRIG(TLx4966_SPEED_TRIG_LINE)
+    };
+
+    /* The HAL reserves the counter and a clock the counter samples its inputs
+     * with, the clock has to be faster than twice the pulse rate */
+    result = cyhal_timer_init(&odometer_obj, NC, NULL);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+    base = odometer_obj.tcpwm.base;
+    cnt_num = odometer_obj.tcpwm.resource.channel_num;
+    if (base != TLx4966_TCPWM)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    /* Both pins go to trigger inputs of the block */
+    result = route_init(speed_pin, TLx4966_SPEED_HSIOM, TLx4966_SPEED_TRIG_SRC,
+                        TLx4966_SPEED_TRIG_DEST);
+    result |= route_init(dir_pin, TLx4966_DIR_HSIOM, TLx4966_DIR_TRIG_SRC,
+                         TLx4966_DIR_TRIG_DEST);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    Cy_TCPWM_Counter_Disable(base, cnt_num);
+    if (Cy_TCPWM_Counter_Init(base, cnt_num, &odometer_cfg) != CY_TCPWM_SUCCESS)
+    {
+        return TLx4966_RSLT_ERR_TCPWM;
+    }
+
+    /* The count and the capture register start at 0 */
+    odo_position = 0;
+    odo_capture = 0;
+    odo_zero = 0;
+    odo_up = (cyhal_gpio_read(dir_pin) == TLx4966_DIR_UP);
+
+    cyhal_timer_register_callback(&odometer_obj, odometer_interrupt_handler, NULL);
+    cyhal_timer_enable_event(&odometer_obj, CYHAL_TIMER_IRQ_CAPTURE_COMPARE,
+                             GPIO_INTERRUPT_PRIORITY, true);
+
+    return cyhal_timer_start(&odometer_obj);
+}
+
+/*******************************************************************************
+* Function Name: odometer_update
+********************************************************************************
+* Summary:
+*  Charges the pulses up to the latched reversals to the position. Called from
+*  the odometer interrupt and with interrupts disabled.
+*
+*******************************************************************************/
+static void odometer_update(void)
+{
+    TCPWM_Type *base = odometer_obj.tcpwm.base;
+    uint32_t cnt_num = odometer_obj.tcpwm.resource.channel_num;
+    uint32_t curr, prev, pulses;
+
+    bool up;
+
+    /* Read again if an edge moved the registers or the direction between the
+     * reads, so the direction belongs to the captures */
+    do
+    {
+        up = (cyhal_gpio_read(dir_gpio) == TLx4966_DIR_UP);
+        curr = Cy_TCPWM_Counter_GetCapture(base, cnt_num);
+        prev = Cy_TCPWM_Counter_GetCaptureBuf(base, cnt_num);
+    } while ((curr != Cy_TCPWM_Counter_GetCapture(base, cnt_num)) ||
+             (up != (cyhal_gpio_read(dir_gpio) == TLx4966_DIR_UP)));
+
+    /* Without a pulse between two reversals the count does not change, the
+     * direction read above is still right */
+    if (curr != odo_capture)
+    {
+        /* Two reversals since the last update, the capture buffer holds the
+         * first one. Without a pulse before the first one the buffer equals
+         * the last update as after a single reversal, only the direction,
+         * back to the one before them, tells the two apart */
+        if ((prev != odo_capture) || (up == odo_up))
+        {
+            pulses = prev - odo_capture;
+            odo_position += odo_up ? (int32_t)pulses : -(int32_t)pulses;
+            odo_up = !odo_up;
+            odo_capture = prev;
+        }
+        pulses = curr - odo_capture;
+        odo_position += odo_up ? (int32_t)pulses : -(int32_t)pulses;
+        odo_capture = curr;
+    }
+    odo_up = up;
+}
+
+/*******************************************************************************
+* Function Name: odometer_interrupt_handler
+********************************************************************************
+* Summary:
+*   Odometer capture interrupt handler, raised on a reversal of the direction.
+*
+* Parameters:
+*  handler_arg (unused)
+*  event (unused)
+*
+*******************************************************************************/
+static void odometer_interrupt_handler(void *handler_arg, cyhal_timer_event_t event)
+{
+    odometer_update();
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_readPosition
+********************************************************************************
+* Summary:
+*  Returns the signed number of speed pulses since TLx4966_init or the last
+*  TLx4966_resetPosition, up while the direction output is TLx4966_DIR_UP. The
+*  pulses are counted by the hardware, so it stays right at any pulse rate the
+*  counter clock can sample.
+*
+* Return:
+*  int32_t    position in speed pulses
+*
+*******************************************************************************/
+int32_t TLx4966_readPosition(void)
+{
+    uint32_t intr_state, pulses;
+    int32_t position;
+
+    intr_state = cyhal_system_critical_section_enter();
+    odometer_update();
+    pulses = Cy_TCPWM_Counter_GetCounter(odometer_obj.tcpwm.base,
+                                         odometer_obj.tcpwm.resource.channel_num) - odo_capture;
+    position = odo_position + (odo_up ? (int32_t)pulses : -(int32_t)pulses);
+    cyhal_system_critical_section_exit(intr_state);
+
+    return position - odo_zero;
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_readRevolutions
+********************************************************************************
+* Summary:
+*  Returns the signed number of whole revolutions since TLx4966_init or the
+*  last TLx4966_resetPosition.
+*
+* Return:
+*  int32_t    position in revolutions, rounded towards 0
+*
+*******************************************************************************/
+int32_t TLx4966_readRevolutions(void)
+{
+    return TLx4966_readPosition() / (int32_t)TLx4966_PULSES_PER_REV;
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_resetPosition
+********************************************************************************
+* Summary:
+*  Makes the current position the new 0.
+*
+*******************************************************************************/
+void TLx4966_resetPosition(void)
+{
+    odo_zero += TLx4966_readPosition();
+}
+#endif /* TLx4966_ODOMETER */
+
+/*******************************************************************************
+* Function Name: edge_push
+********************************************************************************
+* Summary:
+*  Stores the timestamp of a rising edge, overwriting the oldest one. Called
+*  from the interrupt only.
+*
+* Parameters:
+*  timestamp        timer ticks of the edge
+*
+*******************************************************************************/
+static void edge_push(uint32_t timestamp)
+{
+    edge_time[edge_count & EDGE_INDEX_MASK] = timestamp;
+    edge_count++;
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_setEstimator
+********************************************************************************
+* Summary:
+*  Selects the speed estimator. The M-method counts the edges over a window of
+*  fixed length, its resolution is one pulse per window and it suits high
+*  speeds. The T-method averages the last TLx4966_T_PERIODS periods, its
+*  resolution is one timer tick per period and it suits low speeds. The hybrid
+*  averages the periods that started at most one window before the newest
+*  edge, so it uses only the last period at low speed and up to
+*  TLx4966_EDGE_BUFFER_SIZE - 1 periods at high speed.
+*
+* Parameters:
+*  user_estimator   TLx4966_ESTIMATOR_M, TLx4966_ESTIMATOR_T or
+*                   TLx4966_ESTIMATOR_HYBRID
+*  window_ms        window of the M-method and the hybrid
+*  timeout_ms       the speed is 0 if no edge came for this long. It has to be
+*                   longer than the period at the lowest speed to measure, and
+*                   shorter than the wrap of the timer, see TIMER_FREQUENCY
+*
+*******************************************************************************/
+void TLx4966_setEstimator(TLx4966_estimator_t user_estimator, uint32_t window_ms, uint32_t timeout_ms)
+{
+    estimator = user_estimator;
+    window_ticks = window_ms * TIMER_TICKS_PER_MS;
+    timeout_ticks = timeout_ms * TIMER_TICKS_PER_MS;
+
+    /* Restart the M-method window */
+    m_start_time = cyhal_timer_read(&timer_obj);
+    m_start_count = edge_count;
+    m_pulses = 0;
+    m_ticks = 0;
+}
+
+/*******************************************************************************
+* Function Name: speed_from
+********************************************************************************
+* Summary:
+*  Converts a number of pulses in a time to the speed unit.
+*
+* Parameters:
+*  pulses           number of whole pulse periods
+*  ticks            timer ticks they took
+*
+* Return:
+*  float    speed in the selected unit
+*
+*******************************************************************************/
+static float speed_from(uint32_t pulses, uint32_t ticks)
+{
+    if (ticks == 0)
+    {
+        return 0;
+    }
+    return (float) speed_unit * TIMER_TICKS_PER_MS * pulses / ticks;
+}
+
+/*******************************************************************************
+* Function Name: estimate
+********************************************************************************
+* Summary:
+*  Estimates the speed from the edge timestamps with the estimator selected by
+*  TLx4966_setEstimator, as a number of pulse periods and the timer ticks they
+*  took. Both are 0 if no edge came within the timeout, and stay 0 until the
+*  next edge. That holds across the wrap of the timer as long as the speed is
+*  read once between the timeout and the wrap. The interrupt only stores the
+*  timestamps, the arithmetic is done here.
+*
+* Parameters:
+*  pulses           returns the number of pulse periods
+*  ticks            returns the timer ticks of those periods
+*
+*******************************************************************************/
+static void estimate(uint32_t *pulses, uint32_t *ticks)
+{
+    uint32_t times[TLx4966_EDGE_BUFFER_SIZE];
+    uint32_t count, now, newest, since, periods;
+    uint32_t intr_state;
+
+    /* Consistent snapshot of the timestamps the interrupt writes */
+    intr_state = cyhal_system_critical_section_enter();
+    count = edge_count;
+    now = cyhal_timer_read(&timer_obj);
+    memcpy(times, (const uint32_t *)edge_time, sizeof(times));
+    cyhal_system_critical_section_exit(intr_state);
+
+    if (estimator == TLx4966_ESTIMATOR_M)
+    {
+        /* Edges of the window that ended, the first read after it ends
+         * closes it, so it is at least window_ticks long */
+        if (now - m_start_time >= window_ticks)
+        {
+            m_pulses = count - m_start_count;
+            m_ticks = now - m_start_time;
+            m_start_time = now;
+            m_start_count = count;
+        }
+        *pulses = m_pulses;
+        *ticks = m_ticks;
+        return;
+    }
+
+    *pulses = 0;
+    *ticks = 0;
+    newest = times[(count - 1) & EDGE_INDEX_MASK];
+    since = now - newest;
+    if ((count < 2) || (count == timeout_count))
+    {
+        return;
+    }
+    if (since >= timeout_ticks)
+    {
+        timeout_count = count;
+        return;
+    }
+
+    /* Whole periods available in the buffer */
+    periods = count - 1;
+    if (periods > TLx4966_EDGE_BUFFER_SIZE - 1)
+    {
+        periods = TLx4966_EDGE_BUFFER_SIZE - 1;
+    }
+
+    if (estimator == TLx4966_ESTIMATOR_T)
+    {
+        if (periods > TLx4966_T_PERIODS)
+        {
+            periods = TLx4966_T_PERIODS;
+        }
+    }
+    else
+    {
+        /* Hybrid: the periods that started within the window, at least one */
+        uint32_t n = 1;
+        while ((n < periods) &&
+               (newest - times[(count - 1 - (n + 1)) & EDGE_INDEX_MASK] <= window_ticks))
+        {
+            n++;
+        }
+        periods = n;
+    }
+    *pulses = periods;
+    *ticks = newest - times[(count - 1 - periods) & EDGE_INDEX_MASK];
+
+    /* The shaft slows down if the next edge is already later than the average
+     * period, the speed is then at most one pulse since the last edge */
+    if ((uint64_t)since * periods > *ticks)
+    {
+        *pulses = 1;
+        *ticks = since;
+    }
 }
 
 /*******************************************************************************
 * Function Name: TLx4966_readSpeed
 ********************************************************************************
 * Summary:
-*  Returns the current speed of rotation 
+*  Returns the current speed of rotation, 0 if no edge came within the
+*  timeout.
 *
 * Return:
 *  float    speed of rotation measured
@@ -175,7 +769,49 @@ static void gpio_interrupt_handler(void *handler_arg, cyhal_gpio_irq_event_t eve
 *******************************************************************************/
 float TLx4966_readSpeed()
 {
-    return speed;
+    uint32_t pulses, ticks;
+
+    estimate(&pulses, &ticks);
+    return speed_from(pulses, ticks);
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_readPeriod
+********************************************************************************
+* Summary:
+*  Returns the estimated pulse period, the integer counterpart of
+*  TLx4966_readSpeed.
+*
+* Return:
+*  uint32_t    pulse period in timer ticks, 0 if no edge came within the
+*              timeout
+*
+*******************************************************************************/
+uint32_t TLx4966_readPeriod(void)
+{
+    uint32_t pulses, ticks;
+
+    estimate(&pulses, &ticks);
+    if (pulses == 0)
+    {
+        return 0;
+    }
+    return (ticks + pulses / 2) / pulses;
+}
+
+/*******************************************************************************
+* Function Name: TLx4966_readCount
+********************************************************************************
+* Summary:
+*  Returns the number of rising edges of the speed pin since TLx4966_init.
+*
+* Return:
+*  uint32_t    edge count, wraps at 2^32
+*
+*******************************************************************************/
+uint32_t TLx4966_readCount(void)
+{
+    return edge_count;
 }
 
 /*******************************************************************************
@@ -43,31 +43,123 @@
 /*******************************************************************************
 * Macros
 *******************************************************************************/
+/* Set to 1, e.g. with DEFINES+=TLx4966_CAPTURE=1 in the Makefile, to latch the
+ * speed pin edges in a TCPWM counter in hardware instead of reading the timer in
+ * the GPIO interrupt */
+#ifndef TLx4966_CAPTURE
+#define TLx4966_CAPTURE 0
+#endif
+
+/* Set to 1, e.g. with DEFINES+=TLx4966_ODOMETER=1 in the Makefile, to count the
+ * speed pulses up or down by the direction output in a TCPWM counter, see
+ * TLx4966_readPosition */
+#ifndef TLx4966_ODOMETER
+#define TLx4966_ODOMETER 0
+#endif
+
 /* Timer period value. Assign maximum period for the 32 bit counter (2^32) */
 #define TIMER_PERIOD            (4294967295)
 
+/* Timer clock, the pulse periods are measured in its ticks. The GPIO interrupt
+ * reads the timer after the interrupt latency, so ticks of 1 us are enough.
+ * The capture latches the edges, there ticks of 0.1 us give a finer period.
+ * The 32 bit counter then wraps after 429 s instead of 71 minutes, which also
+ * bounds timeout_ms of TLx4966_setEstimator */
+#if TLx4966_CAPTURE
+#define TIMER_FREQUENCY         (10000000u)
+#else
+#define TIMER_FREQUENCY         (1000000u)
+#endif
+#define TIMER_TICKS_PER_MS      (TIMER_FREQUENCY / 1000u)
+
 #define GPIO_INTERRUPT_PRIORITY (7u)
 
-/* Speed Units */
+/* Speed pulses per revolution of the shaft, for TLx4966_readRevolutions */
+#define TLx4966_PULSES_PER_REV  (1u)
+
+/* Level of the direction output while the odometer counts up */
+#define TLx4966_DIR_UP          (1u)
+
+#if TLx4966_CAPTURE || TLx4966_ODOMETER
+/* The capture and count inputs of a TCPWM counter are trigger inputs, so the
+ * pins must be pins that can drive a peripheral trigger line (see the pinout of
+ * the device datasheet) and the routes have to be given, e.g. in the Makefile
+ * DEFINES:
+ *  TLx4966_SPEED_HSIOM      HSIOM setting connecting the pin to the trigger line
+ *  TLx4966_SPEED_TRIG_SRC   trigger multiplexer input of that line
+ *  TLx4966_SPEED_TRIG_DEST  trigger multiplexer output to the TCPWM block
+ *  TLx4966_SPEED_TRIG_LINE  number of that output at the TCPWM block
+ * and the same TLx4966_DIR_... for the direction pin with TLx4966_ODOMETER */
+#if !defined(TLx4966_SPEED_HSIOM) || !defined(TLx4966_SPEED_TRIG_SRC) || \
+    !defined(TLx4966_SPEED_TRIG_DEST) || !defined(TLx4966_SPEED_TRIG_LINE)
+#error "TLx4966_CAPTURE and TLx4966_ODOMETER need the trigger route of the speed pin, see README.md"
+#endif
+#if TLx4966_ODOMETER && \
+    (!defined(TLx4966_DIR_HSIOM) || !defined(TLx4966_DIR_TRIG_SRC) || \
+     !defined(TLx4966_DIR_TRIG_DEST) || !defined(TLx4966_DIR_TRIG_LINE))
+#error "TLx4966_ODOMETER needs the trigger route of the direction pin, see README.md"
+#endif
+
+/* TCPWM block the trigger routes end at. TCPWM0 has the 32 bit counters */
+#ifndef TLx4966_TCPWM
+#define TLx4966_TCPWM           TCPWM0
+#endif
+
+/* A trigger route could not be set up, or a counter was allocated from
+ * another TCPWM block than the routes end at */
+#define TLx4966_RSLT_ERR_TCPWM \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x4966u)
+#endif /* TLx4966_CAPTURE || TLx4966_ODOMETER */
+
+/* Speed Units, the coefficient divided by the pulse period in ms */
 #define TLx4966_SPEED_COEF_HZ      1000.0      /* Hertz - cps (1000 ms) */
 #define TLx4966_SPEED_COEF_RADS    6283.2      /* Rad/s (2pi x 1000 ms) */
 #define TLx4966_SPEED_COEF_RPM     60000.0     /* RPM  (60 x 1000 ms)   */
 
+/* Edge timestamps kept by the interrupt, a power of two */
+#define TLx4966_EDGE_BUFFER_SIZE    (32u)
+
+/* Periods averaged by the T-method */
+#define TLx4966_T_PERIODS           (4u)
+
+/* Estimator settings after TLx4966_init */
+#define TLx4966_DEFAULT_ESTIMATOR   TLx4966_ESTIMATOR_HYBRID
+#define TLx4966_DEFAULT_WINDOW_MS   (100u)
+#define TLx4966_DEFAULT_TIMEOUT_MS  (2000u)
+
+/* Speed estimators, see TLx4966_setEstimator */
+typedef enum
+{
+    TLx4966_ESTIMATOR_M,        /* Edges counted over a window of fixed length */
+    TLx4966_ESTIMATOR_T,        /* Average of the last TLx4966_T_PERIODS periods */
+    TLx4966_ESTIMATOR_HYBRID    /* Average of the periods that started within the
+                                 * window before the newest edge, the last period
+                                 * at low speed */
+} TLx4966_estimator_t;
+
 /* Macro to display the current speed unit in a printf statement */
 #define SPEED_UNIT (speed_unit == TLx4966_SPEED_COEF_HZ ? "Hz" : \
                    (speed_unit == TLx4966_SPEED_COEF_RADS ? "Rads" : "RPM"))
 
-/* Timer object used for blinking the LED */
-cyhal_timer_t timer_obj;
+/* Timer object used to time the speed pulses */
+extern cyhal_timer_t timer_obj;
 
 /* Speed unit to measure */
-float speed_unit;
+extern float speed_unit;
 
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
 cy_rslt_t TLx4966_init(cyhal_gpio_t speed_pin, cyhal_gpio_t dir_pin, float userspeedUnit);
 float TLx4966_readSpeed(void);
+uint32_t TLx4966_readPeriod(void);
+uint32_t TLx4966_readCount(void);
+void TLx4966_setEstimator(TLx4966_estimator_t estimator, uint32_t window_ms, uint32_t timeout_ms);
 uint8_t TLx4966_readDir(void);
+#if TLx4966_ODOMETER
+int32_t TLx4966_readPosition(void);
+int32_t TLx4966_readRevolutions(void);
+void TLx4966_resetPosition(void);
+#endif
 
 /* [] END OF FILE */
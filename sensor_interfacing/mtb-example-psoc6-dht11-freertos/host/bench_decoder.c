@@ -0,0 +1,386 @@
+/******************************************************************************
+* File Name:  bench_decoder.c
+*
+* Description:  Host test and benchmark of the DHT frame decoder. Checks the
+*               regression corpus, measures the error rates of every frame
+*               class against the fixed threshold of the first capture-based
+*               reader and times the decoder per frame and the formatting of
+*               the readings.
+*
+*******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "dht_decoder.h"
+#include "fixed_format.h"
+#include "dht_wave.h"
+
+#define BENCH_FRAMES        20000
+#define BENCH_ROUNDS        200
+#define BENCH_SEED          0x5EED0015u
+
+/* Reader of user-014, a high pulse longer than 48us is a 1 */
+#define NAIVE_THRESHOLD_US  48
+
+typedef struct
+{
+    uint32_t ok;
+    uint32_t rejected;
+    uint32_t wrong;         /* Accepted with wrong values */
+} bench_counts_t;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Conversion of the original DHT_Read, pow() per bit */
+static float reference_fraction(uint8_t num)
+{
+    float fraction = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        fraction = fraction + (num & 1) * pow(2, -(1 + i));
+        num = num >> 1;
+    }
+    return fraction;
+}
+
+/* Values of the original conversion, rounded to 0.01 units */
+static void reference_values(uint8_t type, const uint8_t bytes[5], int16_t *humidity, int16_t *temperature)
+{
+    if (type == DHT_TYPE_DHT22)
+    {
+        *humidity = (int16_t)lround(((bytes[0] << 8) | bytes[1]) * 10.0);
+        *temperature = (int16_t)lround((((bytes[2] & 0x7F) << 8) | bytes[3]) * 10.0);
+        if (bytes[2] & 0x80)
+        {
+            *temperature = -*temperature;
+        }
+    }
+    else
+    {
+        *humidity = (int16_t)lround((bytes[0] + reference_fraction(bytes[1])) * 100.0);
+        *temperature = (int16_t)lround((bytes[2] + reference_fraction(bytes[3])) * 100.0);
+    }
+}
+
+/* Fixed threshold, last 40 high pulses, no glitch filter */
+static uint8_t naive_decode(const uint16_t *times, uint8_t count, uint8_t first_level, uint8_t type,
+                            int16_t *humidity, int16_t *temperature)
+{
+    uint16_t high[WAVE_MAX_EDGES / 2];
+    uint8_t highs = 0;
+    uint8_t bytes[5] = {0, 0, 0, 0, 0};
+
+    for (uint8_t i = (first_level == 1) ? 0 : 1; (i + 1) < count; i += 2)
+    {
+        high[highs++] = (uint16_t)(times[i + 1] - times[i]);
+    }
+    if (highs < DHT_DECODE_FRAME_BITS)
+    {
+        return DHT_DECODE_NO_FRAME;
+    }
+    for (uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        bytes[i / 8] = (uint8_t)((bytes[i / 8] << 1) | (high[highs - DHT_DECODE_FRAME_BITS + i] > NAIVE_THRESHOLD_US));
+    }
+    if (((uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) || (bytes[4] == 0))
+    {
+        return DHT_DECODE_CHECKSUM_ERROR;
+    }
+    reference_values(type, bytes, humidity, temperature);
+    return DHT_DECODE_SUCCESS;
+}
+
+typedef uint8_t (*decoder_t)(const uint16_t *, uint8_t, uint8_t, uint8_t, int16_t *, int16_t *);
+
+static void count_result(decoder_t decode, const wave_t *wave, uint8_t type, bench_counts_t *counts)
+{
+    int16_t humidity = 0, temperature = 0, ref_humidity, ref_temperature;
+
+    reference_values(type, wave->bytes, &ref_humidity, &ref_temperature);
+    if (decode(wave->times, wave->count, wave->first_level, type, &humidity, &temperature) != DHT_DECODE_SUCCESS)
+    {
+        counts->rejected++;
+    }
+    else if ((humidity == ref_humidity) && (temperature == ref_temperature))
+    {
+        counts->ok++;
+    }
+    else
+    {
+        counts->wrong++;
+    }
+}
+
+static int run_corpus(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[2048];
+    int frames = 0, failures = 0;
+
+    if (file == NULL)
+    {
+        printf("Corpus %s not found\n", path);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char name[32], expect[16];
+        unsigned type, b[5], first_level, count;
+        int used, pos;
+        wave_t wave;
+
+        if ((line[0] == '#') || (sscanf(line, "%31s %u %15s %u %u %u %u %u %u %u%n", name, &type, expect,
+                                        &b[0], &b[1], &b[2], &b[3], &b[4], &first_level, &count, &pos) != 10))
+        {
+            continue;
+        }
+        for (int i = 0; i < 5; i++)
+        {
+            wave.bytes[i] = (uint8_t)b[i];
+        }
+        wave.first_level = (uint8_t)first_level;
+        wave.count = (uint8_t)count;
+        for (unsigned k = 0; k < count; k++)
+        {
+            unsigned t;
+            sscanf(line + pos, "%u%n", &t, &used);
+            pos += used;
+            wave.times[k] = (uint16_t)t;
+        }
+
+        bench_counts_t counts = {0, 0, 0};
+        count_result(DHT_Decode, &wave, (uint8_t)type, &counts);
+        int pass;
+        if (strcmp(expect, "ok") == 0)
+        {
+            pass = (counts.ok == 1);
+        }
+        else if (strcmp(expect, "reject") == 0)
+        {
+            pass = (counts.rejected == 1);
+        }
+        else
+        {
+            /* Correct values or an error, never wrong values */
+            pass = (counts.wrong == 0);
+        }
+        if (!pass)
+        {
+            printf("  FAIL frame %d: %s DHT%u, expected %s\n", frames, name, type, expect);
+            failures++;
+        }
+        frames++;
+    }
+    fclose(file);
+
+    printf("Corpus %s: %d frames, %d failures\n\n", path, frames, failures);
+    return (failures != 0) || (frames == 0);
+}
+
+/* Frames too short to be a DHT frame, e.g. a noisy line: 40 equal high pulses
+ * between lows of 0-2us. The decoder has to reject them, not divide by zero. */
+static int run_degenerate(void)
+{
+    int failures = 0;
+
+    for (uint16_t low = 0; low <= 2; low++)
+    {
+        wave_t wave;
+        uint16_t now = 1000;
+        int16_t humidity, temperature;
+
+        wave.first_level = 0;
+        wave.count = 0;
+        wave.times[wave.count++] = now;
+        for (uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+        {
+            now += low;
+            wave.times[wave.count++] = now;
+            now += 5;
+            wave.times[wave.count++] = now;
+        }
+        now += low;
+        wave.times[wave.count++] = now;
+
+        if (DHT_Decode(wave.times, wave.count, wave.first_level, DHT_TYPE_DHT11, &humidity, &temperature) !=
+            DHT_DECODE_NO_FRAME)
+        {
+            printf("  FAIL frame of %u us lows and 5 us highs not rejected\n", low);
+            failures++;
+        }
+    }
+    printf("Degenerate frames: 3 frames, %d failures\n\n", failures);
+    return failures != 0;
+}
+
+static void run_classes(void)
+{
+    static const uint8_t types[] = {DHT_TYPE_DHT11, DHT_TYPE_DHT22};
+
+    printf("Error rates, %d synthesized frames per class\n", BENCH_FRAMES);
+    printf("  %-10s %-6s %-7s %9s %9s %9s   %9s %9s %9s\n", "class", "sensor", "expect",
+           "ok %", "reject %", "wrong %", "fixed ok", "reject", "wrong");
+    for (uint8_t c = 0; c < WAVE_NUM_CLASSES; c++)
+    {
+        for (uint8_t s = 0; s < sizeof(types); s++)
+        {
+            wave_params_t params = WAVE_classes[c].params;
+            bench_counts_t adaptive = {0, 0, 0}, naive = {0, 0, 0};
+            static const char *const expect[] = {"ok", "reject", "any"};
+
+            params.sensor_type = types[s];
+            WAVE_seed(BENCH_SEED + c * 2 + s);
+            for (int n = 0; n < BENCH_FRAMES; n++)
+            {
+                uint8_t bytes[5];
+                wave_t wave;
+                WAVE_randomBytes(types[s], bytes);
+                WAVE_make(&params, bytes, &wave);
+                count_result(DHT_Decode, &wave, types[s], &adaptive);
+                count_result(naive_decode, &wave, types[s], &naive);
+            }
+
+            printf("  %-10s DHT%-3u %-7s %9.3f %9.3f %9.3f   %9.3f %9.3f %9.3f\n", WAVE_classes[c].name, types[s],
+                   expect[WAVE_classes[c].expect],
+                   100.0 * adaptive.ok / BENCH_FRAMES, 100.0 * adaptive.rejected / BENCH_FRAMES,
+                   100.0 * adaptive.wrong / BENCH_FRAMES,
+                   100.0 * naive.ok / BENCH_FRAMES, 100.0 * naive.rejected / BENCH_FRAMES,
+                   100.0 * naive.wrong / BENCH_FRAMES);
+        }
+    }
+    printf("\n");
+}
+
+static void run_throughput(void)
+{
+    static wave_t waves[1000];
+    wave_params_t params = WAVE_classes[0].params;
+    volatile float sink = 0;
+    int16_t humidity = 0, temperature = 0;
+
+    params.sensor_type = DHT_TYPE_DHT11;
+    WAVE_seed(BENCH_SEED);
+    for (int n = 0; n < 1000; n++)
+    {
+        uint8_t bytes[5];
+        WAVE_randomBytes(DHT_TYPE_DHT11, bytes);
+        WAVE_make(&params, bytes, &waves[n]);
+    }
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        for (int n = 0; n < 1000; n++)
+        {
+            DHT_Decode(waves[n].times, waves[n].count, waves[n].first_level, DHT_TYPE_DHT11, &humidity, &temperature);
+            sink += humidity;
+        }
+    }
+    double t_decode = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++)
+    {
+        for (int n = 0; n < 1000; n++)
+        {
+            naive_decode(waves[n].times, waves[n].count, waves[n].first_level, DHT_TYPE_DHT11, &humidity, &temperature);
+            sink += humidity;
+        }
+    }
+    double t_naive = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS * 1000; r++)
+    {
+        sink += Fraction_Convert((uint8_t)r);
+    }
+    double t_table = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS * 1000; r++)
+    {
+        sink += reference_fraction((uint8_t)r);
+    }
+    double t_pow = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    printf("Throughput on this host\n");
+    printf("  %-36s %8.1f ns/frame\n", "DHT_Decode", t_decode);
+    printf("  %-36s %8.1f ns/frame\n", "fixed threshold, pow() fraction", t_naive);
+    printf("  %-36s %8.2f ns\n", "Fraction_Convert, table", t_table);
+    printf("  %-36s %8.2f ns\n", "fraction with pow() per bit", t_pow);
+}
+
+/* Fixed_Format must print every reading as printf("%.2f") did the float */
+static int run_format(void)
+{
+    char fixed[FIXED_FORMAT_MAX_LEN];
+    char reference[32];
+    volatile uint32_t sink = 0;
+    int result = 0;
+
+    for (int32_t v = INT16_MIN; v <= INT16_MAX; v++)
+    {
+        Fixed_Format(fixed, v, DHT_DECIMALS);
+        snprintf(reference, sizeof(reference), "%.2f", v / 100.0);
+        if (strcmp(fixed, reference) != 0)
+        {
+            printf("Fixed_Format(%d) is %s instead of %s\n", (int)v, fixed, reference);
+            result = 1;
+            break;
+        }
+    }
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS * 1000; r++)
+    {
+        sink += Fixed_Format(fixed, (int16_t)r, DHT_DECIMALS);
+    }
+    double t_fixed = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS * 1000; r++)
+    {
+        sink += (uint32_t)snprintf(reference, sizeof(reference), "%.2f", (float)(int16_t)r / 100.0f);
+    }
+    double t_printf = (now_ns() - start) / (BENCH_ROUNDS * 1000.0);
+
+    printf("  %-36s %8.2f ns\n", "Fixed_Format, 2 decimals", t_fixed);
+    printf("  %-36s %8.2f ns\n", "snprintf %.2f of a float", t_printf);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    int result = run_corpus((argc > 1) ? argv[1] : "host/corpus/dht_corpus.txt");
+
+    /* The table must match the original conversion for every byte */
+    for (int n = 0; n < 256; n++)
+    {
+        if (Fraction_Convert((uint8_t)n) / 256.0f != reference_fraction((uint8_t)n))
+        {
+            printf("Fraction_Convert(%d) differs from the original conversion\n\n", n);
+            result = 1;
+        }
+    }
+
+    if (run_degenerate() != 0)
+    {
+        result = 1;
+    }
+    run_classes();
+    run_throughput();
+    if (run_format() != 0)
+    {
+        result = 1;
+    }
+    return result;
+}
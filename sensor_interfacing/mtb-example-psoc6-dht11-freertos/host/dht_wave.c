@@ -0,0 +1,174 @@
+/******************************************************************************
+* File Name:  dht_wave.c
+*
+* Description:  Synthesizer of captured DHT11 and DHT22 frames.
+*
+*******************************************************************************/
+
+#include "dht_wave.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "dht_decoder.h"
+
+/* Datasheet timing in us */
+#define WAVE_RESPONSE_DELAY 30.0    /* Release of the line to the response */
+#define WAVE_RESPONSE_LOW   80.0
+#define WAVE_RESPONSE_HIGH  80.0
+#define WAVE_BIT_LOW_DHT11  54.0
+#define WAVE_BIT_LOW_DHT22  50.0
+#define WAVE_ZERO_HIGH      27.0
+#define WAVE_ONE_HIGH       70.0
+
+#define WAVE_MAX_PULSES     (2 + 2 * DHT_DECODE_FRAME_BITS + 2)
+
+/* name, {type, clock_min, clock_max, latency, burst_prob, burst_us, glitches, missed, truncate, lead}, expect */
+const wave_class_t WAVE_classes[] =
+{
+    {"clean",     {0, 1.00, 1.00, 2.0, 0.00,  0.0, 0, 0, 0, 0}, WAVE_EXPECT_OK},
+    {"lead_edge", {0, 1.00, 1.00, 2.0, 0.00,  0.0, 0, 0, 0, 1}, WAVE_EXPECT_OK},
+    {"skew",      {0, 0.85, 1.15, 2.0, 0.00,  0.0, 0, 0, 0, 0}, WAVE_EXPECT_OK},
+    {"jitter",    {0, 1.00, 1.00, 8.0, 0.00,  0.0, 0, 0, 0, 0}, WAVE_EXPECT_OK},
+    {"glitch",    {0, 1.00, 1.00, 2.0, 0.00,  0.0, 3, 0, 0, 0}, WAVE_EXPECT_ANY},
+    {"noisy",     {0, 0.90, 1.10, 6.0, 0.00,  0.0, 2, 0, 0, 1}, WAVE_EXPECT_ANY},
+    {"burst",     {0, 1.00, 1.00, 2.0, 0.05, 20.0, 0, 0, 0, 0}, WAVE_EXPECT_ANY},
+    {"missed",    {0, 1.00, 1.00, 2.0, 0.00,  0.0, 0, 1, 0, 0}, WAVE_EXPECT_ANY},
+    {"truncated", {0, 1.00, 1.00, 2.0, 0.00,  0.0, 0, 0, 1, 0}, WAVE_EXPECT_REJECT},
+};
+
+const uint8_t WAVE_NUM_CLASSES = sizeof(WAVE_classes) / sizeof(WAVE_classes[0]);
+
+static uint32_t wave_state = 1;
+
+void WAVE_seed(uint32_t seed)
+{
+    wave_state = (seed != 0) ? seed : 1;
+}
+
+/* xorshift32, the corpus must not depend on the C library */
+uint32_t WAVE_rand(void)
+{
+    wave_state ^= wave_state << 13;
+    wave_state ^= wave_state >> 17;
+    wave_state ^= wave_state << 5;
+    return wave_state;
+}
+
+static double WAVE_uniform(double min, double max)
+{
+    return min + (max - min) * (WAVE_rand() / 4294967296.0);
+}
+
+void WAVE_randomBytes(uint8_t sensor_type, uint8_t bytes[5])
+{
+    if (sensor_type == DHT_TYPE_DHT22)
+    {
+        uint16_t humidity = (uint16_t)(WAVE_rand() % 1001);
+        uint16_t temperature = (uint16_t)(WAVE_rand() % 1201);
+        uint16_t magnitude = (temperature >= 400) ? temperature - 400 : (400 - temperature) | 0x8000;
+        bytes[0] = humidity >> 8;
+        bytes[1] = humidity & 0xFF;
+        bytes[2] = magnitude >> 8;
+        bytes[3] = magnitude & 0xFF;
+    }
+    else
+    {
+        bytes[0] = (uint8_t)(20 + WAVE_rand() % 71);
+        bytes[1] = 0;
+        bytes[2] = (uint8_t)(WAVE_rand() % 51);
+        bytes[3] = (uint8_t)(WAVE_rand() % 10);
+    }
+    bytes[4] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+}
+
+void WAVE_make(const wave_params_t *params, const uint8_t bytes[5], wave_t *wave)
+{
+    double width[WAVE_MAX_PULSES];
+    uint8_t pulses = 0;
+    double clock = WAVE_uniform(params->clock_min, params->clock_max);
+    double bit_low = (params->sensor_type == DHT_TYPE_DHT22) ? WAVE_BIT_LOW_DHT22 : WAVE_BIT_LOW_DHT11;
+    uint8_t bits = DHT_DECODE_FRAME_BITS;
+    double edge[WAVE_MAX_EDGES + 2 * WAVE_MAX_GLITCHES];
+    uint8_t edges = 0;
+    uint8_t level;
+
+    memcpy(wave->bytes, bytes, sizeof(wave->bytes));
+    if (params->truncate)
+    {
+        bits = (uint8_t)(20 + WAVE_rand() % 20);
+    }
+
+    /* Pulses from the response on, starting low */
+    width[pulses++] = WAVE_RESPONSE_LOW * clock;
+    width[pulses++] = WAVE_RESPONSE_HIGH * clock;
+    for (uint8_t i = 0; i < bits; i++)
+    {
+        uint8_t one = (bytes[i / 8] >> (7 - i % 8)) & 1;
+        width[pulses++] = bit_low * clock;
+        width[pulses++] = (one ? WAVE_ONE_HIGH : WAVE_ZERO_HIGH + WAVE_uniform(-1.0, 1.0)) * clock;
+    }
+    if (bits == DHT_DECODE_FRAME_BITS)
+    {
+        width[pulses++] = bit_low * clock;
+    }
+
+    /* Edges at the start of every pulse, the line stays high after the last one */
+    double t = WAVE_uniform(0.0, 65536.0);
+    level = 0;
+    if (params->lead_edge)
+    {
+        edge[edges++] = t;
+        t += WAVE_RESPONSE_DELAY * clock;
+        level = 1;
+    }
+    wave->first_level = level;
+    for (uint8_t p = 0; p < pulses; p++)
+    {
+        edge[edges++] = t;
+        t += width[p];
+    }
+    if (bits == DHT_DECODE_FRAME_BITS)
+    {
+        edge[edges++] = t;
+    }
+
+    /* Spikes of the opposite level, two edges each */
+    for (uint8_t g = 0; g < params->glitches; g++)
+    {
+        double spike = WAVE_uniform(1.0, 5.0);
+        uint8_t k;
+        do
+        {
+            k = (uint8_t)(WAVE_rand() % (edges - 1));
+        } while (edge[k + 1] - edge[k] < spike + 4.0);
+        double start = WAVE_uniform(edge[k] + 2.0, edge[k + 1] - spike - 2.0);
+        memmove(&edge[k + 3], &edge[k + 1], (edges - k - 1) * sizeof(edge[0]));
+        edge[k + 1] = start;
+        edge[k + 2] = start + spike;
+        edges += 2;
+    }
+
+    /* A missed edge leaves a pulse of the wrong level behind */
+    for (uint8_t m = 0; m < params->missed_edges; m++)
+    {
+        uint8_t k = (uint8_t)(1 + WAVE_rand() % (edges - 1));
+        memmove(&edge[k], &edge[k + 1], (edges - k - 1) * sizeof(edge[0]));
+        edges--;
+    }
+
+    /* Interrupt latency, one interrupt cannot timestamp before the previous one */
+    double last = -1.0;
+    wave->count = 0;
+    for (uint8_t k = 0; (k < edges) && (wave->count < WAVE_MAX_EDGES); k++)
+    {
+        double latency = WAVE_uniform(0.0, params->latency_us);
+        if (WAVE_uniform(0.0, 1.0) < params->burst_prob)
+        {
+            latency += params->burst_us;
+        }
+        double captured = fmax(edge[k] + latency, last + 1.0);
+        last = captured;
+        wave->times[wave->count++] = (uint16_t)((uint32_t)lround(captured) & 0xFFFF);
+    }
+}
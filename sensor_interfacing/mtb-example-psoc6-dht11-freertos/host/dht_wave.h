@@ -0,0 +1,62 @@
+/******************************************************************************
+* File Name:  dht_wave.h
+*
+* Description:  Synthesizer of captured DHT11 and DHT22 frames for the host
+*               tests. It produces the edge timestamps the GPIO interrupt of
+*               DHT_Read would capture, with the timing of the datasheets and
+*               configurable sensor clock error, interrupt latency, glitches,
+*               missed edges and truncation.
+*
+*******************************************************************************/
+
+#ifndef HOST_DHT_WAVE_H_
+#define HOST_DHT_WAVE_H_
+
+#include <stdint.h>
+
+#define WAVE_MAX_EDGES      96      /* DHT_MAX_EDGES of dht_task.h */
+#define WAVE_MAX_GLITCHES   8
+
+typedef struct
+{
+    uint8_t sensor_type;    /* DHT_TYPE_DHT11 or DHT_TYPE_DHT22 */
+    double clock_min;       /* Sensor timing scale, 1.0 is the datasheet */
+    double clock_max;
+    double latency_us;      /* Interrupt latency per edge, uniform from 0 */
+    double burst_prob;      /* Probability of an additional long latency per edge */
+    double burst_us;
+    uint8_t glitches;       /* Spikes of 1-5us inserted into random pulses, up to WAVE_MAX_GLITCHES */
+    uint8_t missed_edges;   /* Edges the interrupt does not see */
+    uint8_t truncate;       /* Capture ends after 20 to 39 bits */
+    uint8_t lead_edge;      /* Capture starts with the release of the line by the host */
+} wave_params_t;
+
+typedef struct
+{
+    uint8_t bytes[5];       /* Frame as sent, checksum included */
+    uint16_t times[WAVE_MAX_EDGES];
+    uint8_t count;
+    uint8_t first_level;
+} wave_t;
+
+/* What a decoder must make of a class of frames */
+#define WAVE_EXPECT_OK      0       /* Correct values */
+#define WAVE_EXPECT_REJECT  1       /* An error */
+#define WAVE_EXPECT_ANY     2       /* Correct values or an error */
+
+typedef struct
+{
+    const char *name;
+    wave_params_t params;   /* sensor_type is set by the user of the class */
+    uint8_t expect;
+} wave_class_t;
+
+extern const wave_class_t WAVE_classes[];
+extern const uint8_t WAVE_NUM_CLASSES;
+
+void WAVE_seed(uint32_t seed);
+uint32_t WAVE_rand(void);
+void WAVE_randomBytes(uint8_t sensor_type, uint8_t bytes[5]);
+void WAVE_make(const wave_params_t *params, const uint8_t bytes[5], wave_t *wave);
+
+#endif /* HOST_DHT_WAVE_H_ */
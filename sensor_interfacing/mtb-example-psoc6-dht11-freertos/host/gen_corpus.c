@@ -0,0 +1,53 @@
+/******************************************************************************
+* File Name:  gen_corpus.c
+*
+* Description:  Writes the regression corpus of bench_decoder.c: frames of
+*               every class, for DHT11 and DHT22.
+*               Format per line: class, sensor type, expectation, the 5 bytes
+*               sent, level after the first edge, number of edges and the
+*               edge timestamps in us.
+*
+*******************************************************************************/
+
+#include <stdio.h>
+
+#include "dht_decoder.h"
+#include "dht_wave.h"
+
+#define CORPUS_SEED         0x44485431u
+#define CORPUS_PER_CLASS    6
+
+int main(void)
+{
+    static const uint8_t types[] = {DHT_TYPE_DHT11, DHT_TYPE_DHT22};
+
+    static const char *const expect[] = {"ok", "reject", "any"};
+
+    WAVE_seed(CORPUS_SEED);
+    printf("# class type expect b0 b1 b2 b3 b4 first_level count times...\n");
+    for (uint8_t c = 0; c < WAVE_NUM_CLASSES; c++)
+    {
+        for (uint8_t s = 0; s < sizeof(types); s++)
+        {
+            wave_params_t params = WAVE_classes[c].params;
+            params.sensor_type = types[s];
+            for (int n = 0; n < CORPUS_PER_CLASS; n++)
+            {
+                uint8_t bytes[5];
+                wave_t wave;
+                WAVE_randomBytes(types[s], bytes);
+                WAVE_make(&params, bytes, &wave);
+
+                printf("%s %u %s %u %u %u %u %u %u %u", WAVE_classes[c].name, types[s],
+                       expect[WAVE_classes[c].expect],
+                       bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], wave.first_level, wave.count);
+                for (uint8_t k = 0; k < wave.count; k++)
+                {
+                    printf(" %u", wave.times[k]);
+                }
+                printf("\n");
+            }
+        }
+    }
+    return 0;
+}
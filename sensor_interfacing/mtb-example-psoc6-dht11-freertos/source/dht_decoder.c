@@ -0,0 +1,414 @@
+/******************************************************************************
+* File Name:  dht_decoder.c
+*
+* Description:  This file contains the decoder of DHT11 and DHT22 frames from
+*               captured edge timestamps.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+
+#include "dht_decoder.h"
+#include "fixed_format.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Bit reversed nibbles, the fraction byte is sent LSB weighted 1/2 */
+static const uint8_t reverse_nibble[16] =
+{
+    0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF
+};
+
+/* Frame being collected, walking backwards from the last edge */
+struct dht_bits
+{
+    uint8_t high_time[DHT_DECODE_FRAME_BITS];
+    uint8_t low_time[DHT_DECODE_FRAME_BITS + 1];    /* Low signal in front of every bit, and the closing one */
+    uint8_t highs;          /* High pulses collected */
+    uint8_t lows;           /* Low pulses in front of them collected */
+    uint8_t closing;        /* Closing low signal captured */
+    uint8_t leading;        /* Pulses in front of the 40 bits */
+};
+
+
+/*******************************************************************************
+* Function Name: Fraction_Convert
+****************************************************************************//**
+*
+* Converts a 8 bit binary number into a fraction in Q0.8 format. Bit 0 weighs
+* 1/2 and bit 7 weighs 1/256.
+*
+* \param num
+* 8 bit binary value
+*
+* \return
+* Fraction of the binary number in 1/256 units
+*
+*******************************************************************************/
+uint8_t Fraction_Convert(uint8_t num)
+{
+    return (uint8_t)((reverse_nibble[num & 0x0F] << 4) | reverse_nibble[num >> 4]);
+}
+
+/*******************************************************************************
+* Function Name: DHT_Add_Pulse
+****************************************************************************//**
+*
+* Adds one pulse, latest first, to the frame. The closing low signal is kept
+* apart, then high and low pulses are collected until the frame has 40 bits.
+* Pulses in front of the bits are only counted.
+*
+* \param bits
+* Frame being collected
+*
+* \param level
+* Level of the DATA line during the pulse
+*
+* \param width
+* Pulse width in microseconds
+*
+*******************************************************************************/
+static void DHT_Add_Pulse(struct dht_bits *bits, uint8_t level, uint16_t width)
+{
+    uint8_t width8 = (width > UINT8_MAX) ? UINT8_MAX : (uint8_t)width;
+
+    if(bits->lows == DHT_DECODE_FRAME_BITS)
+    {
+        bits->leading++;
+    }
+    else if(level == 1)
+    {
+        bits->high_time[DHT_DECODE_FRAME_BITS - 1 - bits->highs] = width8;
+        bits->highs++;
+    }
+    else if(bits->lows < bits->highs)
+    {
+        bits->low_time[DHT_DECODE_FRAME_BITS - 1 - bits->lows] = width8;
+        bits->lows++;
+    }
+    else
+    {
+        bits->low_time[DHT_DECODE_FRAME_BITS] = width8;
+        bits->closing = 1;
+    }
+}
+
+/*******************************************************************************
+* Function Name: DHT_Low_Reference
+****************************************************************************//**
+*
+* Returns the length of the low signals in front of the bits. Low signals more
+* than DHT_DECODE_LOW_TOLERANCE_US off the mean have a late edge and are left
+* out of a second mean.
+*
+* \param bits
+* Collected frame
+*
+* \return
+* Low time in microseconds
+*
+*******************************************************************************/
+static uint8_t DHT_Low_Reference(const struct dht_bits *bits)
+{
+    uint16_t sum = 0, mean;
+    uint8_t n = 0;
+
+    for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        sum += bits->low_time[i];
+    }
+    mean = sum / DHT_DECODE_FRAME_BITS;
+
+    sum = 0;
+    for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        if((bits->low_time[i] + DHT_DECODE_LOW_TOLERANCE_US >= mean) &&
+           (bits->low_time[i] <= mean + DHT_DECODE_LOW_TOLERANCE_US))
+        {
+            sum += bits->low_time[i];
+            n++;
+        }
+    }
+    return (uint8_t)((n != 0) ? (sum / n) : mean);
+}
+
+/*******************************************************************************
+* Function Name: DHT_Correct_Latency
+****************************************************************************//**
+*
+* Corrects the high times for late timestamps. The sensor sends every low
+* signal equally long, and the interrupt only ever timestamps an edge late. A
+* longer low signal has a late rising edge, which shortens the following high
+* pulse; a shorter low signal has a late falling edge, which lengthens the high
+* pulse in front of it.
+*
+* \param bits
+* Collected frame, the high times are corrected in place
+*
+* \param low
+* Low time in microseconds
+*
+*******************************************************************************/
+static void DHT_Correct_Latency(struct dht_bits *bits, uint8_t low)
+{
+    if(!bits->closing)
+    {
+        bits->low_time[DHT_DECODE_FRAME_BITS] = low;
+    }
+
+    for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        int16_t high = bits->high_time[i];
+        if(bits->low_time[i] > low)
+        {
+            high += bits->low_time[i] - low;
+        }
+        if(bits->low_time[i + 1] < low)
+        {
+            high -= low - bits->low_time[i + 1];
+        }
+        bits->high_time[i] = (high < 0) ? 0 : ((high > UINT8_MAX) ? UINT8_MAX : (uint8_t)high);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DHT_Threshold
+****************************************************************************//**
+*
+* Finds the high time which separates 0 and 1 bits of the frame.
+*
+* Starting between the shortest and the longest high pulse, the threshold is
+* moved twice to the middle of the mean of the pulses below and the mean of the
+* pulses above it. This follows the clock of the sensor. If all pulses are about
+* equally long, the frame has only 0 or only 1 bits, the low time of 50-54us
+* then separates a 26us 0 from a 70us 1.
+*
+* \param bits
+* Collected frame
+*
+* \param low
+* Low time in microseconds
+*
+* \return
+* Threshold in microseconds, a longer high pulse is a 1
+*
+*******************************************************************************/
+static uint8_t DHT_Threshold(const struct dht_bits *bits, uint8_t low)
+{
+    uint8_t min = UINT8_MAX, max = 0;
+    uint8_t threshold;
+
+    for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        if(bits->high_time[i] < min)
+        {
+            min = bits->high_time[i];
+        }
+        if(bits->high_time[i] > max)
+        {
+            max = bits->high_time[i];
+        }
+    }
+
+    if((max - min) < (low / 2))
+    {
+        return low;
+    }
+
+    threshold = (uint8_t)((min + max) / 2);
+    for(uint8_t pass = 0; pass < 2; pass++)
+    {
+        uint16_t sum[2] = {0, 0};
+        uint8_t n[2] = {0, 0};
+        for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+        {
+            uint8_t one = (bits->high_time[i] > threshold) ? 1 : 0;
+            sum[one] += bits->high_time[i];
+            n[one]++;
+        }
+        if((n[0] == 0) || (n[1] == 0))
+        {
+            break;
+        }
+        threshold = (uint8_t)((sum[0] / n[0] + sum[1] / n[1]) / 2);
+    }
+
+    return threshold;
+}
+
+/*******************************************************************************
+* Function Name: DHT_Decode_Bytes
+****************************************************************************//**
+*
+* Finds the last 40 bits in the captured edges and converts them to bytes.
+*
+* \param times
+* Edge timestamps in microseconds, wrapping at 16 bits
+*
+* \param count
+* Number of edges
+*
+* \param first_level
+* Level of the DATA line after the first edge
+*
+* \param glitch_us
+* Pulses shorter than this are merged into the surrounding pulse, 0 for none
+*
+* \param byteval
+* Array of 5 bytes which stores the received bytes
+*
+* \return
+* DHT_DECODE_SUCCESS, DHT_DECODE_NO_FRAME or DHT_DECODE_CHECKSUM_ERROR
+*
+*******************************************************************************/
+static uint8_t DHT_Decode_Bytes(const uint16_t *times, uint8_t count, uint8_t first_level, uint16_t glitch_us,
+                                uint8_t *byteval)
+{
+    struct dht_bits bits = {{0}, {0}, 0, 0, 0, 0};
+    uint8_t acc_level = 0, merge = 0, started = 0;
+    uint8_t low, threshold;
+    uint16_t acc_width = 0;
+
+    /* Pulse k lies between edge k and k + 1 */
+    for(int16_t k = (int16_t)count - 2; k >= 0; k--)
+    {
+        uint16_t width = (uint16_t)(times[k + 1] - times[k]);
+        uint8_t level = first_level ^ (uint8_t)(k & 1);
+
+        if(started && ((width < glitch_us) || merge))
+        {
+            /* A glitch and the pulse before it belong to the current pulse */
+            acc_width += width;
+            merge = !merge;
+            continue;
+        }
+        if(started)
+        {
+            DHT_Add_Pulse(&bits, acc_level, acc_width);
+        }
+        acc_level = level;
+        acc_width = width;
+        started = 1;
+    }
+    if(started)
+    {
+        DHT_Add_Pulse(&bits, acc_level, acc_width);
+    }
+
+    /****************************************************************************
+    *  The capture starts with the release of the line, so only the response and
+    *  the delay in front of it may precede the bits. More pulses mean glitches
+    *  shifted the frame, the checksum alone often does not catch a shift.
+    ****************************************************************************/
+    if((bits.lows < DHT_DECODE_FRAME_BITS) || (bits.leading > DHT_DECODE_MAX_LEADING))
+    {
+        return DHT_DECODE_NO_FRAME;
+    }
+
+    /* The sensor sends 50us low signals, lows as short as a glitch are no frame */
+    low = DHT_Low_Reference(&bits);
+    if(low < DHT_DECODE_GLITCH_US)
+    {
+        return DHT_DECODE_NO_FRAME;
+    }
+    DHT_Correct_Latency(&bits, low);
+    threshold = DHT_Threshold(&bits, low);
+    for(uint8_t i = 0; i < DHT_DECODE_FRAME_BITS; i++)
+    {
+        byteval[i / 8] = (uint8_t)(byteval[i / 8] << 1);
+        if(bits.high_time[i] > threshold)
+        {
+            byteval[i / 8] |= 1;
+        }
+    }
+
+    /* Checksum is the sum of all 4 bytes, a frame of only zeros is a line stuck low */
+    if(((uint8_t)(byteval[0] + byteval[1] + byteval[2] + byteval[3]) != byteval[4]) ||
+       ((byteval[0] | byteval[1] | byteval[2] | byteval[3]) == 0))
+    {
+        return DHT_DECODE_CHECKSUM_ERROR;
+    }
+
+    return DHT_DECODE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DHT_Decode
+****************************************************************************//**
+*
+* Decodes humidity and temperature from the captured edges of a frame.
+*
+* Response to the start condition is a 80us low signal and 80us high signal,
+* then every bit is a 50-54us low signal followed by a 26-28us high signal for
+* a 0 or a 70us high signal for a 1. After the closing low signal the line
+* stays high. The frame is found from the end, so edges captured before the
+* response do not matter.
+*
+* A late timestamp can shorten the high signal of a 0 to a few us, so short
+* pulses are only treated as glitches if the frame does not decode without: the
+* second attempt merges pulses shorter than DHT_DECODE_GLITCH_US into the
+* surrounding pulse.
+*
+* \param times
+* Edge timestamps in microseconds, wrapping at 16 bits
+*
+* \param count
+* Number of edges
+*
+* \param first_level
+* Level of the DATA line after the first edge
+*
+* \param sensor_type
+* DHT_TYPE_DHT11 or DHT_TYPE_DHT22
+*
+* \param humidity
+* Pointer to the variable which stores the humidity in 0.01 %RH, written on
+* success
+*
+* \param temperature
+* Pointer to the variable which stores the temperature in 0.01 degC, written on
+* success
+*
+* \return
+* DHT_DECODE_SUCCESS, DHT_DECODE_NO_FRAME or DHT_DECODE_CHECKSUM_ERROR
+*
+*******************************************************************************/
+uint8_t DHT_Decode(const uint16_t *times, uint8_t count, uint8_t first_level, uint8_t sensor_type,
+                   int16_t *humidity, int16_t *temperature)
+{
+    uint8_t byteval[5] = {0,0,0,0,0};
+    uint8_t result;
+
+    result = DHT_Decode_Bytes(times, count, first_level, 0, byteval);
+    if(result != DHT_DECODE_SUCCESS)
+    {
+        result = DHT_Decode_Bytes(times, count, first_level, DHT_DECODE_GLITCH_US, byteval);
+    }
+    if(result != DHT_DECODE_SUCCESS)
+    {
+        return result;
+    }
+
+    if(sensor_type == DHT_TYPE_DHT22)
+    {
+        /* 16 bit values in 0.1 units, the temperature is sign and magnitude. Scaled to 0.01 units */
+        *humidity = (int16_t)(((byteval[0] << 8) | byteval[1]) * 10);
+        *temperature = (int16_t)((((byteval[2] & 0x7F) << 8) | byteval[3]) * 10);
+        if(byteval[2] & 0x80)
+        {
+            *temperature = -*temperature;
+        }
+    }
+    else
+    {
+        /* Integral byte and binary fraction, together a Q8.8 value */
+        *humidity = (int16_t)Fixed_From_Q((byteval[0] << 8) | Fraction_Convert(byteval[1]), 8, DHT_DECIMALS);
+        *temperature = (int16_t)Fixed_From_Q((byteval[2] << 8) | Fraction_Convert(byteval[3]), 8, DHT_DECIMALS);
+    }
+
+    return DHT_DECODE_SUCCESS;
+}
@@ -0,0 +1,46 @@
+/******************************************************************************
+* File Name:  dht_decoder.h
+*
+* Description:  This file provides the decoder of DHT11 and DHT22 frames. The
+*               decoder works on captured edge timestamps only and does not
+*               depend on the HAL or FreeRTOS.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+
+#ifndef SOURCE_DHT_DECODER_H_
+#define SOURCE_DHT_DECODER_H_
+
+#include <stdint.h>
+
+/* Sensor types */
+#define DHT_TYPE_DHT11              11
+#define DHT_TYPE_DHT22              22
+
+/* Decoder results, the same values as the error codes in main.h */
+#define DHT_DECODE_SUCCESS          0x00
+#define DHT_DECODE_NO_FRAME         0x01    /* Less than 40 bits captured */
+#define DHT_DECODE_CHECKSUM_ERROR   0x02
+
+#define DHT_DECODE_FRAME_BITS       40
+
+/* Readings are integers in 0.01 units, e.g. 2350 is 23.50 degC */
+#define DHT_DECIMALS                2
+
+/* Pulses shorter than this are glitches, the shortest valid pulse is a 26us high */
+#define DHT_DECODE_GLITCH_US        10
+
+/* Low signals further off their mean have a late edge */
+#define DHT_DECODE_LOW_TOLERANCE_US 10
+
+/* Delay after the release of the line, response low and response high */
+#define DHT_DECODE_MAX_LEADING      3
+
+uint8_t Fraction_Convert(uint8_t num);
+uint8_t DHT_Decode(const uint16_t *times, uint8_t count, uint8_t first_level, uint8_t sensor_type,
+                   int16_t *humidity, int16_t *temperature);
+
+
+#endif /* SOURCE_DHT_DECODER_H_ */
@@ -43,29 +43,110 @@
 
 
 /*******************************************************************************
-* Function Name: Fraction_Convert
+* Global Variables
+*******************************************************************************/
+/* Sensors read by DHT_Task, configured in main.h */
+static const struct dht_sensor dht_sensors[] = DHT_SENSORS;
+#define DHT_NUM_SENSORS     (sizeof(dht_sensors) / sizeof(dht_sensors[0]))
+
+/* Free running microsecond timer the edges are timestamped with */
+static cyhal_timer_t edge_timer;
+
+/* Edge timestamps of the current frame, written by the GPIO interrupt */
+static volatile uint16_t edge_times[DHT_MAX_EDGES];
+static volatile uint8_t edge_count;
+
+
+/* Latest reading of every sensor, sent as one message per round */
+static struct readings_batch DHT_batch;
+
+/* Tick count at which every sensor is read next */
+static TickType_t next_read[DHT_MAX_SENSORS];
+
+
+/*******************************************************************************
+* Function Name: DHT_Edge_ISR
 ****************************************************************************//**
 *
-* Converts a 8 bit binary number into a fractional decimal value
+* GPIO interrupt handler of the DATA pins. Timestamps every edge of the frame,
+* the frame is decoded by DHT_Read once the sensor has finished sending. Only
+* the pin of the sensor being read has the interrupt enabled. The pin is not
+* read here, after the interrupt latency it may already show the next pulse.
+*
+* \param handler_arg
+* Index of the sensor in DHT_SENSORS
+*
+* \param event
+* Not used, both edges are enabled
+*
+*******************************************************************************/
+static void DHT_Edge_ISR(void *handler_arg, cyhal_gpio_irq_event_t event)
+{
+    (void)event;
+
+    (void)handler_arg;
+
+    if(edge_count < DHT_MAX_EDGES)
+    {
+        edge_times[edge_count++] = (uint16_t)cyhal_timer_read(&edge_timer);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DHT_Init
+****************************************************************************//**
 *
-* \param num
-* 8 bit binary value
+* Initializes the DATA pins of all sensors, starts the microsecond timer and
+* registers the edge interrupts.
 *
 * \return
-* Fractional decimal value of the binary number
+* Result of the pin and timer initialization
 *
 *******************************************************************************/
-float Fraction_Convert(uint8_t num)
+cy_rslt_t DHT_Init(void)
 {
-    float fraction = 0;
-    int unit = 0;
-    for( int i = 0; i<8; i++)
+    cy_rslt_t result;
+
+    const cyhal_timer_cfg_t edge_timer_cfg =
+    {
+        .compare_value = 0,                 /* Timer compare value, not used */
+        .period = DHT_TIMER_PERIOD,         /* Wraps after 65.536 ms, longer than a frame */
+        .direction = CYHAL_TIMER_DIR_UP,    /* Timer counts up */
+        .is_compare = false,                /* Don't use compare mode */
+        .is_continuous = true,              /* Run timer indefinitely */
+        .value = 0                          /* Initial value of counter */
+    };
+
+    /* The pins used can be changed in main.h file */
+    CY_ASSERT(DHT_NUM_SENSORS <= DHT_MAX_SENSORS);
+    for(uint8_t i = 0; i < DHT_NUM_SENSORS; i++)
     {
-        unit = num & 1;
-        num = num>>1;
-        fraction = fraction + unit * pow(2, -(1+i));
+        result = cyhal_gpio_init(dht_sensors[i].pin, CYHAL_GPIO_DIR_BIDIRECTIONAL, CYHAL_GPIO_DRIVE_PULLUP, 1);
+        if(result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        /* The event itself stays disabled outside of DHT_Read */
+        cyhal_gpio_register_callback(dht_sensors[i].pin, DHT_Edge_ISR, (void *)(uintptr_t)i);
+    }
+
+    result = cyhal_timer_init(&edge_timer, NC, NULL);
+    if(result != CY_RSLT_SUCCESS)
+    {
+        return result;
     }
-    return fraction;
+    result = cyhal_timer_configure(&edge_timer, &edge_timer_cfg);
+    if(result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&edge_timer, DHT_TIMER_FREQ_HZ);
+    }
+    if(result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_start(&edge_timer);
+    }
+
+    return result;
 }
 
 /*******************************************************************************
@@ -73,163 +154,111 @@ float Fraction_Convert(uint8_t num)
 ****************************************************************************//**
 *
 * Initiates the communication with the sensor.
-* Function sends 18ms low signal after 1s delay.
+* Function pulls the DATA line low for 20ms. The task is blocked meanwhile, the
+* line is released by DHT_Read.
+*
+* \param pin
+* DATA pin of the sensor
 *
 *******************************************************************************/
 
-void DHT_Start(void)
+void DHT_Start(cyhal_gpio_t pin)
 {
-    cyhal_gpio_write(DATA_PIN, 1);
-    cyhal_system_delay_ms(1000);
-    cyhal_gpio_write(DATA_PIN, 0);
-    cyhal_system_delay_ms(18);
-    cyhal_gpio_write(DATA_PIN, 1);
+    cyhal_gpio_write(pin, 0);
+    vTaskDelay(pdMS_TO_TICKS(DHT_START_LOW_MS));
 }
 
 /*******************************************************************************
 * Function Name: DHT_Read
 ****************************************************************************//**
 *
-* Reads the temperature and humidity values if the sensor read is successful
+* Reads the temperature and humidity values if the sensor read is successful.
+* The edges are captured by the GPIO interrupt while the task is blocked, the
+* scheduler keeps running during the whole read.
+*
+* \param sensor
+* Index of the sensor in DHT_SENSORS
 *
 * \param humidity
-* Pointer to the float variable which stores humidity value
+* Pointer to the variable which stores the humidity in 0.01 %RH
 *
 * \param temperature
-* Pointer to the float variable which stores temperature value
+* Pointer to the variable which stores the temperature in 0.01 degC
 *
 * \return
 * Status of sensor read
 *
 *******************************************************************************/
 
-uint8 DHT_Read(float* humidity, float* temperature)
+uint8 DHT_Read(uint8_t sensor, int16_t* humidity, int16_t* temperature)
 {
-    uint8_t delay_time = 0, ack_time = 0;
-    uint8_t temp = 0, index = 0, bit_count = 7;
-    uint8_t byteval[5] = {0,0,0,0,0};   /* Array to store the 5 byte values received from the sensor */
-
-
-    DHT_Start();
-    /****************************************************************************
-    *   Response to the start condition is a 54us low signal and 80us high signal.
-    ****************************************************************************/
-
-    taskENTER_CRITICAL();
-    while( cyhal_gpio_read(DATA_PIN) == 1)
-    {
-        cyhal_system_delay_us(1);
-        ack_time++;
-        if(ack_time > timeout_duration)
-        {
-            /* Connection timed out */
-            return DHT_CONNECTION_ERROR;
-        }
-    }
-
-    while( cyhal_gpio_read(DATA_PIN) == 0)
+    cyhal_gpio_t pin = dht_sensors[sensor].pin;
+    uint16_t release_time;
+    uint8_t first_level;
+
+    DHT_Start(pin);
+
+    /* Release the line and capture the response of the sensor */
+    edge_count = 0;
+    cyhal_gpio_write(pin, 1);
+    release_time = (uint16_t)cyhal_timer_read(&edge_timer);
+    cyhal_gpio_enable_event(pin, CYHAL_GPIO_IRQ_BOTH, DHT_EDGE_INTR_PRIORITY, true);
+    vTaskDelay(pdMS_TO_TICKS(DHT_FRAME_TIME_MS));
+    cyhal_gpio_enable_event(pin, CYHAL_GPIO_IRQ_BOTH, DHT_EDGE_INTR_PRIORITY, false);
+
+    /* The first edge is the sensor pulling the line low, unless the line was
+     * still rising after the release when the event was enabled. The sensor
+     * doesn't answer that early, a late interrupt only turns such a frame
+     * into a rejected one. */
+    first_level = 0;
+    if((edge_count > 0) && ((uint16_t)(edge_times[0] - release_time) < DHT_RESPONSE_MIN_US))
     {
-    	cyhal_system_delay_us(1);
-        ack_time++;
-        if(ack_time > timeout_duration)
-        {
-            /* Connection timed out */
-            return DHT_CONNECTION_ERROR;
-        }
+        first_level = 1;
     }
 
-    /* Value of ack_time stored so that it can be used to calculate bit value */
-    /* Value of delay_time corresponds to a little more than 54 us */
-    delay_time = ack_time;
-    ack_time = 0;
-    while( cyhal_gpio_read(DATA_PIN) == 1)
-    {
-        /* Spin until sensor pulls the data line high */
-    	cyhal_system_delay_us(1);
-        ack_time++;
-        if(ack_time > timeout_duration)
-        {
-            /* Connection timed out */
-            return DHT_CONNECTION_ERROR;
-        }
-    }
-
-    for (int i = 0; i < 40; i++)
-	{
-        ack_time = 0;
-        while( cyhal_gpio_read(DATA_PIN) == 0)
-        {
-            /* Spin until sensor pulls the data line high */
-        	cyhal_system_delay_us(1);
-            ack_time++;
-            if(ack_time > timeout_duration)
-            {
-                /* Connection timed out */
-                return DHT_CONNECTION_ERROR;
-            }
-        }
+    /* The interrupt is disabled, the buffer no longer changes */
+    return DHT_Decode((const uint16_t *)edge_times, edge_count, first_level, dht_sensors[sensor].type,
+                      humidity, temperature);
+}
 
-        ack_time = 0;
+/*******************************************************************************
+* Function Name: DHT_Next_Sensor
+****************************************************************************//**
+*
+* Finds the sensor which is due first.
+*
+* \param now
+* Current tick count
+*
+* \return
+* Index of the sensor in DHT_SENSORS
+*
+*******************************************************************************/
+static uint8_t DHT_Next_Sensor(TickType_t now)
+{
+    uint8_t next = 0;
 
-        while( cyhal_gpio_read(DATA_PIN) == 1)
+    /* Differences to now stay correct when the tick count wraps */
+    for(uint8_t i = 1; i < DHT_NUM_SENSORS; i++)
+    {
+        if((int32_t)(next_read[i] - now) < (int32_t)(next_read[next] - now))
         {
-        	cyhal_system_delay_us(1);
-            ack_time++;
-            if(ack_time > timeout_duration)
-            {
-                /* Connection timed out */
-                return DHT_CONNECTION_ERROR;
-            }
+            next = i;
         }
-
-        /****************************************************************************
-        *  The sensor MCU outputs a low signal for 54us and high signal for 24us if
-        *  bit value is 0 and a low signal for 54us and high signal for 70us if bit
-        *  value is 1.
-        ****************************************************************************/
-
-        /* If ack_time value is more than delay_time/2 i.e., ack_time > (approx) 27 us then bit value is 1 */
-        if ((ack_time) > (delay_time/2))
-            byteval[index] |= (1 << bit_count);
-        if (bit_count == 0)   /* Next Byte */
-   	    {
-   		    bit_count = 7;    /* Reset bit_count to 7 */
-   		    index++;          /* Increment index so that next byte is chosen */
-   	    }
-   	    else bit_count--;
-    }
-    taskEXIT_CRITICAL();
-
-    /* Checksum is calculated by adding all 4 bytes */
-    temp = (byteval[0] + byteval[1] + byteval[2] + byteval[3]);
-    if((temp == byteval[4]) && (byteval[4] != 0))
-    {
-        /* Pass the temperature and humidity data only when checksum is matched and it is not equal to 0 */
-        *humidity = (int)byteval[0] + Fraction_Convert(byteval[1]);
-        *temperature = (int)byteval[2] + Fraction_Convert(byteval[3]);
-
-        return SUCCESS;
-    }
-    else
-    {
-    	/* ********************************************************************
-    	 * Enter critical section which is exited in the task function.
-    	 * If the application is not inside critical section and if
-    	 * taskEXIT_CRITICAL() is called the system goes into hard fault.
-    	 * To ensure that this does not happen the function is called.
-    	 * ********************************************************************/
-    	taskENTER_CRITICAL();
-
-    	/* Incorrect value */
-        return DHT_INCORRECT_VALUE;
     }
+    return next;
 }
 
 /*******************************************************************************
 * Function Name: DHT_Task
 ****************************************************************************//**
 *
-* Task function to read the sensor values and pass the values into a queue
+* Task function to read the sensor values and pass the values into a queue.
+*
+* Every sensor is read once per DHT_READ_INTERVAL_MS, the sensors are spread
+* evenly over the interval. Between two reads the task is blocked until the
+* next sensor is due. Once every sensor has been read, the latest readings of
+* all sensors are sent to the queue as one message.
 *
 * \param pvParameters
 * Void pointer which points to the queue handle
@@ -242,48 +271,67 @@ void DHT_Task(void* pvParameters)
 	QueueHandle_t print_queue;
 	print_queue = (QueueHandle_t) pvParameters;
 
-	/* Variable to store temperature and humidity values */
-	struct readings DHT_reading = {0, 0};
+	/* Sensors read since the last message */
+	uint32_t read_mask = 0;
+	const uint32_t all_read = (1UL << DHT_NUM_SENSORS) - 1;
+	bool all_valid = true;
+	TickType_t now;
+
+	/* The sensors do not answer within the first second after power up */
+	vTaskDelay(pdMS_TO_TICKS(DHT_POWER_UP_MS));
+
+	now = xTaskGetTickCount();
+	DHT_batch.count = DHT_NUM_SENSORS;
+	for(uint8_t i = 0; i < DHT_NUM_SENSORS; i++)
+	{
+		next_read[i] = now + pdMS_TO_TICKS(DHT_READ_INTERVAL_MS) * i / DHT_NUM_SENSORS;
+		DHT_batch.reading[i].sensor = i;
+	}
 
 	for(;;)
 	{
-		DHT_reading.result_code = DHT_Read(&DHT_reading.humidity, &DHT_reading.temperature);
+		uint8_t sensor = DHT_Next_Sensor(xTaskGetTickCount());
+		struct readings *reading = &DHT_batch.reading[sensor];
 
-		if(DHT_reading.result_code == SUCCESS)
+		/* Block until the sensor is due, other sensors are read in the meantime */
+		now = xTaskGetTickCount();
+		if((int32_t)(next_read[sensor] - now) > 0)
 		{
-			/* Toggle the LED to indicate that a valid reading is obtained */
-			cyhal_gpio_toggle(CYBSP_LED4);
-
-			/* *************************************************************
-			 * If the sensor values are valid, pass the readings to the queue.
-			 * If the queue is full, enter blocked state and wait for the
-			 * Print_Task to read the value from the queue.
-			 * *************************************************************/
-			xQueueSendToBack(print_queue, &DHT_reading, portMAX_DELAY);
+			vTaskDelay(next_read[sensor] - now);
+			now = next_read[sensor];
 		}
-		else
+
+		/* ******************************************************************
+		 * The sensors need ~2 seconds between two reads. The next read is
+		 * one interval after this one, a late read does not shorten it.
+		 * ******************************************************************/
+		next_read[sensor] = now + pdMS_TO_TICKS(DHT_READ_INTERVAL_MS);
+
+		/* If the sensor values are not valid, the error code is passed along with the previous value */
+		reading->timestamp = now * portTICK_PERIOD_MS;
+		reading->result_code = DHT_Read(sensor, &reading->humidity, &reading->temperature);
+		all_valid = all_valid && (reading->result_code == SUCCESS);
+		read_mask |= 1UL << sensor;
+
+		if(read_mask == all_read)
 		{
-			/* Exit critical section */
-			taskEXIT_CRITICAL();
+			if(all_valid)
+			{
+				/* Toggle the LED to indicate that valid readings are obtained from all sensors */
+				cyhal_gpio_toggle(CYBSP_LED4);
+			}
 
 			/* *************************************************************
-			 * If the sensor values are not valid, pass the error code along
-			 * with the previous value to the queue. Print_Task reads the
-			 * error value and decides the course of action.
+			 * Pass the readings of all sensors to the queue. Print_Task
+			 * reads the error values and decides the course of action. If
+			 * the queue is full, enter blocked state and wait for the
+			 * Print_Task to read the value from the queue.
 			 * *************************************************************/
-			xQueueSendToBack(print_queue, &DHT_reading, portMAX_DELAY);
+			xQueueSendToBack(print_queue, &DHT_batch, portMAX_DELAY);
+			read_mask = 0;
+			all_valid = true;
 		}
-
-		/* ******************************************************************
-		 * As the sensor sampling rate is ~2 seconds. task-delay function is
-		 * called for 2 seconds.
-		 * ******************************************************************/
-		vTaskDelay(pdMS_TO_TICKS(2000));
 	}
 
 
 }
-
-
-
-
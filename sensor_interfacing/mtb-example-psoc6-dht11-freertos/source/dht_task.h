@@ -44,12 +44,34 @@
 
 #include "main.h"
 
-/* Sensor timeout duration can be changed here */
-#define timeout_duration 100
+/* Start signal and frame timing in ms */
+#define DHT_POWER_UP_MS         1000    /* Sensor is not ready before */
+#define DHT_START_LOW_MS        20      /* At least 18ms */
+#define DHT_FRAME_TIME_MS       8       /* Response and 40 bits take less than 5.5ms */
+#define DHT_RESPONSE_MIN_US     20      /* Sensor pulls the line low 20-40us after the release */
 
-float Fraction_Convert(uint8_t num);
-void DHT_Start(void);
-uint8 DHT_Read(float* humidity, float* temperature);
+/****************************************************************************
+* Every sensor is read once per interval, at least 1s for the DHT11 and 2s
+* for the DHT22. A read takes DHT_START_LOW_MS + DHT_FRAME_TIME_MS, so 2s
+* would have time for 70 sensors. DHT_MAX_SENSORS in main.h allows 12, it
+* sizes the readings batch that is copied into the print queue every round.
+****************************************************************************/
+#define DHT_READ_INTERVAL_MS    2000
+
+/* Edge capture */
+#define DHT_MAX_EDGES           96      /* 84 edges per frame plus spurious ones */
+#define DHT_TIMER_FREQ_HZ       1000000
+#define DHT_TIMER_PERIOD        0xFFFF
+
+/****************************************************************************
+* The edge interrupt does not call the FreeRTOS API, so it may be above
+* configMAX_SYSCALL_INTERRUPT_PRIORITY and is not delayed by critical sections.
+****************************************************************************/
+#define DHT_EDGE_INTR_PRIORITY  1
+
+cy_rslt_t DHT_Init(void);
+void DHT_Start(cyhal_gpio_t pin);
+uint8 DHT_Read(uint8_t sensor, int16_t* humidity, int16_t* temperature);
 void DHT_Task(void* pvParameters);
 
 
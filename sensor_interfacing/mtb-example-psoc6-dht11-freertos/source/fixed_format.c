@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name:  fixed_format.c
+*
+* Description:  This file contains the formatter of fixed-point numbers. The
+*               digits are produced by integer division, so the float support
+*               of printf is not needed to print the readings.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+#include "fixed_format.h"
+
+
+/*******************************************************************************
+* Function Name: Fixed_Format
+****************************************************************************//**
+*
+* Writes an integer-scaled value as decimal number, e.g. 2345 with 2 decimals
+* as "23.45" and -5 with 2 decimals as "-0.05".
+*
+* \param buffer
+* Buffer of at least FIXED_FORMAT_MAX_LEN characters, terminated on return
+*
+* \param value
+* Value multiplied by 10 to the power of decimals
+*
+* \param decimals
+* Digits after the point, 0 for none, at most FIXED_FORMAT_MAX_DECIMALS
+*
+* \return
+* Number of characters written, without the terminator
+*
+*******************************************************************************/
+uint8_t Fixed_Format(char *buffer, int32_t value, uint8_t decimals)
+{
+    char digits[FIXED_FORMAT_MAX_LEN];
+    uint8_t count = 0, length = 0;
+
+    /* The magnitude of INT32_MIN only fits unsigned */
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+
+    if(decimals > FIXED_FORMAT_MAX_DECIMALS)
+    {
+        decimals = FIXED_FORMAT_MAX_DECIMALS;
+    }
+
+    /* Least significant digit first, at least one digit in front of the point */
+    do
+    {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while((magnitude != 0) || (count <= decimals));
+
+    if(value < 0)
+    {
+        buffer[length++] = '-';
+    }
+    while(count > 0)
+    {
+        if(count == decimals)
+        {
+            buffer[length++] = '.';
+        }
+        buffer[length++] = digits[--count];
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: Fixed_From_Q
+****************************************************************************//**
+*
+* Converts a Q-format value to an integer-scaled value, rounded to nearest with
+* halves away from zero. E.g. 0x1780 in Q8.8 (23.5) is 2350 with 2 decimals.
+*
+* \param value
+* Value multiplied by 2 to the power of frac_bits
+*
+* \param frac_bits
+* Fraction bits of the Q-format, at most 31
+*
+* \param decimals
+* Decimals of the result, at most FIXED_FORMAT_MAX_DECIMALS
+*
+* \return
+* Value multiplied by 10 to the power of decimals
+*
+*******************************************************************************/
+int32_t Fixed_From_Q(int32_t value, uint8_t frac_bits, uint8_t decimals)
+{
+    int64_t scaled = (value < 0) ? -(int64_t)value : value;
+
+    for(uint8_t i = 0; i < decimals; i++)
+    {
+        scaled *= 10;
+    }
+    if(frac_bits > 0)
+    {
+        scaled = (scaled + ((int64_t)1 << (frac_bits - 1))) >> frac_bits;
+    }
+
+    return (int32_t)((value < 0) ? -scaled : scaled);
+}
+
+/*******************************************************************************
+* Function Name: Fixed_Format_Q
+****************************************************************************//**
+*
+* Writes a Q-format value as decimal number, rounded to the given decimals.
+*
+* \param buffer
+* Buffer of at least FIXED_FORMAT_MAX_LEN characters, terminated on return
+*
+* \param value
+* Value multiplied by 2 to the power of frac_bits
+*
+* \param frac_bits
+* Fraction bits of the Q-format, at most 31
+*
+* \param decimals
+* Digits after the point, at most FIXED_FORMAT_MAX_DECIMALS
+*
+* \return
+* Number of characters written, without the terminator
+*
+*******************************************************************************/
+uint8_t Fixed_Format_Q(char *buffer, int32_t value, uint8_t frac_bits, uint8_t decimals)
+{
+    return Fixed_Format(buffer, Fixed_From_Q(value, frac_bits, decimals), decimals);
+}
@@ -0,0 +1,27 @@
+/******************************************************************************
+* File Name:  fixed_format.h
+*
+* Description:  This file provides the formatter of fixed-point numbers. It
+*               writes integer-scaled and Q-format values as decimal text
+*               into a buffer of the caller, without floats or printf.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+#ifndef SOURCE_FIXED_FORMAT_H_
+#define SOURCE_FIXED_FORMAT_H_
+
+#include <stdint.h>
+
+/* Buffer size for any value: sign, 10 digits, point and terminator */
+#define FIXED_FORMAT_MAX_LEN        13
+
+/* Most decimals a value may have */
+#define FIXED_FORMAT_MAX_DECIMALS   9
+
+uint8_t Fixed_Format(char *buffer, int32_t value, uint8_t decimals);
+int32_t Fixed_From_Q(int32_t value, uint8_t frac_bits, uint8_t decimals);
+uint8_t Fixed_Format_Q(char *buffer, int32_t value, uint8_t frac_bits, uint8_t decimals);
+
+#endif /* SOURCE_FIXED_FORMAT_H_ */
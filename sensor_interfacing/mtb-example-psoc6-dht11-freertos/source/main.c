@@ -64,8 +64,8 @@ int main(void)
 		CY_ASSERT(0);
 	}
 
-    /* Initialize the DATA pin. The pin used can be changed in main.h file */
-    result = cyhal_gpio_init(DATA_PIN, CYHAL_GPIO_DIR_BIDIRECTIONAL, CYHAL_GPIO_DRIVE_PULLUP, 1);
+    /* Initialize the DATA pins and start the edge capture. The pins used can be changed in main.h file */
+    result = DHT_Init();
     if (result != CY_RSLT_SUCCESS)
 	{
 		CY_ASSERT(0);
@@ -84,15 +84,15 @@ int main(void)
                "PSoC 6: Interfacing DHT-11 using ModusToolbox 2.1 "
                "****************** \r\n\n");
 
-    /* Create a queue to store the sensor readings */
-    print_queue = xQueueCreate(5, sizeof(struct readings));
+    /* Create a queue to store the sensor readings, one message per round over all sensors */
+    print_queue = xQueueCreate(2, sizeof(struct readings_batch));
     if(print_queue == NULL)
     {
     	CY_ASSERT(0);
     }
 
     /* Create tasks */
-    xTaskCreate(DHT_Task, "DHT Task", configMINIMAL_STACK_SIZE, (void*) print_queue, 2, NULL);
+    xTaskCreate(DHT_Task, "DHT Task", 2*configMINIMAL_STACK_SIZE, (void*) print_queue, 2, NULL);
     xTaskCreate(Print_Task, "Print Task", 3*configMINIMAL_STACK_SIZE, (void*) print_queue, 1, NULL);
 
     /* Start scheduler */
@@ -52,24 +52,52 @@
 #include "task.h"
 #include "queue.h"
 
+#include "dht_decoder.h"
+
 /* Pin used for the DATA signal can be changed here */
 #define DATA_PIN 	P6_3
 
+/* Sensor on the DATA pin, DHT_TYPE_DHT11 or DHT_TYPE_DHT22 */
+#define DHT_SENSOR_TYPE	DHT_TYPE_DHT11
+
+/****************************************************************************
+* Sensors read by DHT_Task, one {pin, type} pair per sensor, e.g.
+* { {P6_3, DHT_TYPE_DHT11}, {P6_2, DHT_TYPE_DHT22}, {P9_0, DHT_TYPE_DHT22} }
+****************************************************************************/
+#define DHT_SENSORS		{ {DATA_PIN, DHT_SENSOR_TYPE} }
+#define DHT_MAX_SENSORS	12
+
 /* Error Codes */
-#define SUCCESS 				0x00
-#define DHT_CONNECTION_ERROR 	0x01
-#define DHT_INCORRECT_VALUE		0x02
+#define SUCCESS 				DHT_DECODE_SUCCESS
+#define DHT_CONNECTION_ERROR 	DHT_DECODE_NO_FRAME
+#define DHT_INCORRECT_VALUE		DHT_DECODE_CHECKSUM_ERROR
 
 
 /* Task handles for each task */
 TaskHandle_t DHT_Task_handle, Print_Task_handle;
 
+/* DATA pin and type of one sensor */
+struct dht_sensor
+{
+	cyhal_gpio_t pin;
+	uint8 type;
+};
+
 /* Structure to store temperature and humidity readings */
 struct readings
 {
-	float humidity;
-	float temperature;
+	int16_t humidity;		/* 0.01 %RH, DHT_DECIMALS decimals */
+	int16_t temperature;	/* 0.01 degC */
 	uint8 result_code;
+	uint8 sensor;			/* Index in DHT_SENSORS */
+	uint32_t timestamp;		/* Time of the read in ms since start */
+};
+
+/* Latest readings of all sensors, sent to Print_Task in one message */
+struct readings_batch
+{
+	uint8 count;
+	struct readings reading[DHT_MAX_SENSORS];
 };
 
 #endif /* SOURCE_MAIN_H_ */
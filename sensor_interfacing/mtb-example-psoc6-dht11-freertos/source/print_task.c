@@ -40,6 +40,7 @@
 
 
 #include "print_task.h"
+#include "fixed_format.h"
 
 /*******************************************************************************
 * Function Name: Print_Task
@@ -59,11 +60,14 @@ void Print_Task(void* pvParameters)
 	QueueHandle_t print_queue;
 	print_queue = (QueueHandle_t) pvParameters;
 
-	/* Variable to check if connection error message is already displayed */
-	bool conn_err_displayed = false;
+	/* Variables to check if connection error message is already displayed */
+	bool conn_err_displayed[DHT_MAX_SENSORS] = {false};
 
-	/* Variables to store temperature and humidity values */
-	struct readings DHT_reading = {0, 0};   
+	/* Variables to store temperature and humidity values of all sensors */
+	static struct readings_batch DHT_batch;
+
+	/* Readings as text, formatted without float support in printf */
+	char humidity[FIXED_FORMAT_MAX_LEN], temperature[FIXED_FORMAT_MAX_LEN];
 
 	for(;;)
 	{
@@ -74,40 +78,57 @@ void Print_Task(void* pvParameters)
 		 * given the least priority, it prints data only when all the
 		 * other tasks are in blocked state.
 		 * *************************************************************/
-		xQueueReceive(print_queue, &DHT_reading, portMAX_DELAY);
+		xQueueReceive(print_queue, &DHT_batch, portMAX_DELAY);
 
-		/* Print the DHT sensor readings if the values are valid */
-		if(DHT_reading.result_code == SUCCESS)
+		for(uint8_t i = 0; i < DHT_batch.count; i++)
 		{
-			printf("\r\nHumidity  =   %.2f\r\n",DHT_reading.humidity);
-			printf("\r\nTemperature  =   %.2f\r\n",DHT_reading.temperature);
-			conn_err_displayed = false;
-		}
+			struct readings *DHT_reading = &DHT_batch.reading[i];
 
-		/* *************************************************************
-		 * If there is a connection error notify the user once that the
-		 * sensor is not connected. The printing resumes once connection
-		 * is established.
-		 * *************************************************************/
-		else if(DHT_reading.result_code == DHT_CONNECTION_ERROR)
-		{
-			if(conn_err_displayed == false)
+			/* Print the DHT sensor readings if the values are valid */
+			if(DHT_reading->result_code == SUCCESS)
 			{
-				printf("\r\nDHT Sensor Connection Failed\r\n");
-				conn_err_displayed = true;
+				if(DHT_batch.count > 1)
+				{
+					printf("\r\nSensor %u at %lu ms\r\n", DHT_reading->sensor, (unsigned long)DHT_reading->timestamp);
+				}
+				Fixed_Format(humidity, DHT_reading->humidity, DHT_DECIMALS);
+				Fixed_Format(temperature, DHT_reading->temperature, DHT_DECIMALS);
+				printf("\r\nHumidity  =   %s\r\n", humidity);
+				printf("\r\nTemperature  =   %s\r\n", temperature);
+				conn_err_displayed[i] = false;
+			}
+
+			/* *************************************************************
+			 * If there is a connection error notify the user once that the
+			 * sensor is not connected. The printing resumes once connection
+			 * is established.
+			 * *************************************************************/
+			else if(DHT_reading->result_code == DHT_CONNECTION_ERROR)
+			{
+				if(conn_err_displayed[i] == false)
+				{
+					if(DHT_batch.count > 1)
+					{
+						printf("\r\nDHT Sensor %u Connection Failed\r\n", DHT_reading->sensor);
+					}
+					else
+					{
+						printf("\r\nDHT Sensor Connection Failed\r\n");
+					}
+					conn_err_displayed[i] = true;
+				}
+			}
+			else
+			{
+				/* **************************************************************
+				 * This application does not do anything if the value read from
+				 * the sensor is incorrect. The printing resumes once valid
+				 * values are obtained. But any error handling code can be placed
+				 * here based on the use case.
+				 * **************************************************************/
 			}
-		}
-		else
-		{
-			/* **************************************************************
-			 * This application does not do anything if the value read from
-			 * the sensor is incorrect. The printing resumes once valid
-			 * values are obtained. But any error handling code can be placed
-			 * here based on the use case.
-			 * **************************************************************/
 		}
 	}
 
 }
 
-
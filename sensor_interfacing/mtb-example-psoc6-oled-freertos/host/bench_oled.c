@@ -0,0 +1,274 @@
+/******************************************************************************
+* File Name:  bench_oled.c
+*
+* Description:  Host benchmark of the OLED framebuffer. Renders the reading
+*               screen of OLED_Task for a series of DHT readings, sends every
+*               frame to the display emulator once in full and once as dirty
+*               pages, checks that the emulated display shows the rendered
+*               frame and reports the I2C bytes per update. It also reports
+*               the bytes of the packed splash screen logos.
+*
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixed_format.h"
+#include "oled_framebuffer.h"
+#include "ssd1306_emu.h"
+
+#define BENCH_UPDATES       2000
+#define BENCH_DUMPS         8       /* Frames written as PGM with a folder argument */
+#define BENCH_SEED          0x5EED0017u
+
+/* Text positions of OLED_Task */
+#define TEXT_X              2
+#define HUMIDITY_Y          20
+#define TEMPERATURE_Y       40
+
+#define GLYPH_WIDTH         6       /* 5 columns and a space */
+
+/* Row-major 1bpp frame, the layout of the emWin memory device */
+static uint8_t frame[OLED_FB_HEIGHT][OLED_FB_BYTES_PER_LINE];
+
+/* 5x7 font with the characters of the reading screen, one byte per column, bit 0 on top */
+static const struct
+{
+    char c;
+    uint8_t columns[5];
+} glyphs[] =
+{
+    {'0', {0x3E, 0x51, 0x49, 0x45, 0x3E}}, {'1', {0x00, 0x42, 0x7F, 0x40, 0x00}},
+    {'2', {0x42, 0x61, 0x51, 0x49, 0x46}}, {'3', {0x21, 0x41, 0x45, 0x4B, 0x31}},
+    {'4', {0x18, 0x14, 0x12, 0x7F, 0x10}}, {'5', {0x27, 0x45, 0x45, 0x45, 0x39}},
+    {'6', {0x3C, 0x4A, 0x49, 0x49, 0x30}}, {'7', {0x01, 0x71, 0x09, 0x05, 0x03}},
+    {'8', {0x36, 0x49, 0x49, 0x49, 0x36}}, {'9', {0x06, 0x49, 0x49, 0x29, 0x1E}},
+    {'.', {0x00, 0x60, 0x60, 0x00, 0x00}}, {':', {0x00, 0x36, 0x36, 0x00, 0x00}},
+    {'-', {0x08, 0x08, 0x08, 0x08, 0x08}}, {'H', {0x7F, 0x08, 0x08, 0x08, 0x7F}},
+    {'T', {0x01, 0x01, 0x7F, 0x01, 0x01}}, {'a', {0x20, 0x54, 0x54, 0x54, 0x78}},
+    {'d', {0x38, 0x44, 0x44, 0x48, 0x7F}}, {'e', {0x38, 0x54, 0x54, 0x54, 0x18}},
+    {'i', {0x00, 0x44, 0x7D, 0x40, 0x00}}, {'m', {0x7C, 0x04, 0x18, 0x04, 0x78}},
+    {'p', {0x7C, 0x14, 0x14, 0x14, 0x08}}, {'r', {0x7C, 0x08, 0x04, 0x04, 0x08}},
+    {'t', {0x04, 0x3F, 0x44, 0x40, 0x20}}, {'u', {0x3C, 0x40, 0x40, 0x20, 0x7C}},
+    {'y', {0x0C, 0x50, 0x50, 0x50, 0x3C}},
+};
+
+/* Packed logos of source/image_files */
+extern const struct oled_bitmap bmifx;
+extern const struct oled_bitmap bmplus;
+extern const struct oled_bitmap bmcy;
+
+static uint32_t rng_state = BENCH_SEED;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void set_pixel(int x, int y)
+{
+    if ((x >= 0) && (x < OLED_FB_WIDTH) && (y >= 0) && (y < OLED_FB_HEIGHT))
+    {
+        frame[y][x / 8] |= (uint8_t)(0x80 >> (x % 8));
+    }
+}
+
+static int draw_string(const char *s, int x, int y)
+{
+    for (; *s != '\0'; s++, x += GLYPH_WIDTH)
+    {
+        for (size_t g = 0; g < sizeof(glyphs) / sizeof(glyphs[0]); g++)
+        {
+            if (glyphs[g].c != *s)
+            {
+                continue;
+            }
+            for (int col = 0; col < 5; col++)
+            {
+                for (int row = 0; row < 7; row++)
+                {
+                    if (glyphs[g].columns[col] & (1 << row))
+                    {
+                        set_pixel(x + col, y + row);
+                    }
+                }
+            }
+        }
+    }
+    return x;
+}
+
+/* GUI_Clear and the strings of OLED_Task, readings in 0.01 units */
+static void render(int16_t humidity, int16_t temperature)
+{
+    char value[FIXED_FORMAT_MAX_LEN];
+
+    memset(frame, 0, sizeof(frame));
+    Fixed_Format(value, humidity, 2);
+    draw_string(value, draw_string("Humidity: ", TEXT_X, HUMIDITY_Y), HUMIDITY_Y);
+    Fixed_Format(value, temperature, 2);
+    draw_string(value, draw_string("Temperature: ", TEXT_X, TEMPERATURE_Y), TEMPERATURE_Y);
+}
+
+/* The emulated display must show the rendered frame */
+static int check_display(void)
+{
+    for (int y = 0; y < OLED_FB_HEIGHT; y++)
+    {
+        for (int x = 0; x < OLED_FB_WIDTH; x++)
+        {
+            uint8_t expected = (frame[y][x / 8] >> (7 - x % 8)) & 1;
+            if (EMU_Get_Pixel((uint8_t)x, (uint8_t)y) != expected)
+            {
+                printf("display differs from the frame at %d,%d\n", x, y);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+typedef struct
+{
+    uint64_t wire_bytes;
+    uint64_t transactions;
+    uint32_t min;
+    uint32_t max;
+} totals_t;
+
+static void add(totals_t *t, const emu_stats_t *s)
+{
+    if ((t->transactions == 0) || (s->wire_bytes < t->min))
+    {
+        t->min = s->wire_bytes;
+    }
+    if (s->wire_bytes > t->max)
+    {
+        t->max = s->wire_bytes;
+    }
+    t->wire_bytes += s->wire_bytes;
+    t->transactions += s->transactions;
+}
+
+static void report(const char *name, const totals_t *t)
+{
+    printf("  %-28s %7.1f bytes  min %4u  max %4u  %7.1f us at %u kHz\n", name,
+           (double)t->wire_bytes / BENCH_UPDATES, t->min, t->max,
+           EMU_Wire_Time_Us((uint32_t)(t->wire_bytes / BENCH_UPDATES), (uint32_t)(t->transactions / BENCH_UPDATES)),
+           EMU_I2C_HZ / 1000u);
+}
+
+/* ********************************************************************
+ * Sends BENCH_UPDATES readings to the display. With full set, every
+ * frame is sent completely, the least GUI_Clear and a redraw cost
+ * without the framebuffer. Both runs see the same readings.
+ * ********************************************************************/
+static int run(int full, totals_t *totals, uint32_t *unchanged, const char *dump)
+{
+    int16_t humidity = 4500;
+    int16_t temperature = 2350;
+    char path[512];
+
+    rng_state = BENCH_SEED;
+    EMU_Reset();
+    OLED_FB_Init();
+    render(humidity, temperature);
+    OLED_FB_Update(&frame[0][0], OLED_FB_BYTES_PER_LINE);
+    OLED_FB_Flush(NULL);
+
+    for (int n = 0; n < BENCH_UPDATES; n++)
+    {
+        /* DHT11 steps: 1 % humidity, 0.1 C temperature */
+        uint32_t r = rng();
+        if (r % 10 < 3)
+        {
+            humidity += (r & 0x100) ? 100 : -100;
+        }
+        if ((r >> 4) % 10 < 5)
+        {
+            temperature += (r & 0x200) ? 10 : -10;
+        }
+
+        render(humidity, temperature);
+        OLED_FB_Update(&frame[0][0], OLED_FB_BYTES_PER_LINE);
+        if (full)
+        {
+            OLED_FB_Invalidate();
+        }
+        EMU_Clear_Stats();
+        OLED_FB_Flush(NULL);
+        add(totals, EMU_Get_Stats());
+        if (EMU_Get_Stats()->wire_bytes == 0)
+        {
+            (*unchanged)++;
+        }
+
+        if (!check_display())
+        {
+            return 0;
+        }
+        if ((dump != NULL) && (n < BENCH_DUMPS))
+        {
+            snprintf(path, sizeof(path), "%s/frame_%03d.pgm", dump, n);
+            if (EMU_Write_PGM(path) != 0)
+            {
+                printf("cannot write %s\n", path);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Splash screen from a blank display, each logo against the previous one */
+static void run_splash(void)
+{
+    static const struct
+    {
+        const char *name;
+        const struct oled_bitmap *bitmap;
+    } logos[] = {{"Infineon", &bmifx}, {"+", &bmplus}, {"Cypress", &bmcy}};
+
+    EMU_Reset();
+    OLED_FB_Init();
+    OLED_FB_Flush(NULL);
+
+    printf("Splash screen logos, packed size and I2C bytes from the previous frame\n");
+    for (size_t i = 0; i < sizeof(logos) / sizeof(logos[0]); i++)
+    {
+        EMU_Clear_Stats();
+        OLED_FB_Clear();
+        OLED_FB_Draw_Bitmap(logos[i].bitmap, 0, 0);
+        OLED_FB_Flush(NULL);
+        printf("  %-10s %4u bytes flash  %4u bytes I2C\n", logos[i].name, logos[i].bitmap->size,
+               EMU_Get_Stats()->wire_bytes);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    totals_t full = {0};
+    totals_t dirty = {0};
+    uint32_t unchanged = 0;
+
+    if (!run(1, &full, &unchanged, NULL))
+    {
+        return 1;
+    }
+    unchanged = 0;
+    if (!run(0, &dirty, &unchanged, (argc > 1) ? argv[1] : NULL))
+    {
+        return 1;
+    }
+
+    printf("%d readings of the OLED_Task screen, I2C bytes per update on the wire\n", BENCH_UPDATES);
+    report("full frame", &full);
+    report("dirty pages", &dirty);
+    printf("  %u updates changed no pixel\n\n", unchanged);
+    run_splash();
+    return 0;
+}
@@ -0,0 +1,305 @@
+/******************************************************************************
+* File Name:  bitmap_convert.c
+*
+* Description:  Host converter of PBM and PGM images into the packed bitmap
+*               format of oled_framebuffer.h. It writes the C source of the
+*               bitmap, decodes it again with OLED_FB_Draw_Bitmap() to check
+*               it and reports the sizes.
+*
+*******************************************************************************/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "oled_framebuffer.h"
+#include "ssd1306_emu.h"
+
+#define MAX_RUN             (OLED_BITMAP_COUNT_MASK + 1)
+
+/* Image as lit pixels, one byte per pixel */
+static uint8_t pixels[OLED_FB_HEIGHT][OLED_FB_WIDTH];
+static int width;
+static int height;
+
+/* Column bytes in page order and their packed form */
+static uint8_t columns[OLED_FB_PAGES * OLED_FB_WIDTH];
+static uint8_t packed[2 * OLED_FB_PAGES * OLED_FB_WIDTH];
+
+static int read_number(FILE *f)
+{
+    int c = fgetc(f);
+    int value = 0;
+
+    /* Whitespace and comments */
+    while ((c == '#') || isspace(c))
+    {
+        if (c == '#')
+        {
+            while ((c != '\n') && (c != EOF))
+            {
+                c = fgetc(f);
+            }
+        }
+        c = fgetc(f);
+    }
+    if (!isdigit(c))
+    {
+        return -1;
+    }
+    while (isdigit(c))
+    {
+        value = value * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return value;
+}
+
+/* PBM (P1, P4): 1 is a lit pixel. PGM (P5): a value from the middle up is lit */
+static int read_image(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    char magic[3] = {0};
+    int ok = 1;
+
+    if ((f == NULL) || (fread(magic, 1, 2, f) != 2))
+    {
+        return 0;
+    }
+    width = read_number(f);
+    height = read_number(f);
+    if ((width <= 0) || (width > OLED_FB_WIDTH) || (height <= 0) || (height > OLED_FB_HEIGHT))
+    {
+        fprintf(stderr, "%s: at most %dx%d pixels\n", path, OLED_FB_WIDTH, OLED_FB_HEIGHT);
+        fclose(f);
+        return 0;
+    }
+
+    if (strcmp(magic, "P1") == 0)
+    {
+        for (int y = 0; (y < height) && ok; y++)
+        {
+            for (int x = 0; (x < width) && ok; x++)
+            {
+                int c;
+                do
+                {
+                    c = fgetc(f);
+                    if (c == '#')
+                    {
+                        while ((c != '\n') && (c != EOF))
+                        {
+                            c = fgetc(f);
+                        }
+                    }
+                } while ((c != '0') && (c != '1') && (c != EOF));
+                ok = (c != EOF);
+                pixels[y][x] = (c == '1');
+            }
+        }
+    }
+    else if (strcmp(magic, "P4") == 0)
+    {
+        int bytes = (width + 7) / 8;
+        for (int y = 0; (y < height) && ok; y++)
+        {
+            uint8_t line[OLED_FB_BYTES_PER_LINE];
+            ok = (fread(line, 1, bytes, f) == (size_t)bytes);
+            for (int x = 0; x < width; x++)
+            {
+                pixels[y][x] = (line[x / 8] >> (7 - x % 8)) & 1;
+            }
+        }
+    }
+    else if (strcmp(magic, "P5") == 0)
+    {
+        int maxval = read_number(f);
+        uint8_t line[OLED_FB_WIDTH];
+        ok = (maxval > 0) && (maxval < 256);
+        for (int y = 0; (y < height) && ok; y++)
+        {
+            ok = (fread(line, 1, width, f) == (size_t)width);
+            for (int x = 0; x < width; x++)
+            {
+                pixels[y][x] = (2 * line[x] > maxval);
+            }
+        }
+    }
+    else
+    {
+        ok = 0;
+    }
+
+    fclose(f);
+    if (!ok)
+    {
+        fprintf(stderr, "%s: not a PBM or PGM image\n", path);
+    }
+    return ok;
+}
+
+static int to_columns(void)
+{
+    int pages = (height + 7) / 8;
+    int n = 0;
+
+    for (int page = 0; page < pages; page++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            uint8_t value = 0;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                if ((page * 8 + bit < height) && pixels[page * 8 + bit][x])
+                {
+                    value |= (uint8_t)(1 << bit);
+                }
+            }
+            columns[n++] = value;
+        }
+    }
+    return n;
+}
+
+/* ********************************************************************
+ * Greedy encoder. Runs of 0x00 and 0xFF cost one byte, other runs two,
+ * so a literal is only interrupted where the run is cheaper than the
+ * literal header it adds.
+ * ********************************************************************/
+static int pack(int count)
+{
+    int size = 0;
+    int literal = -1;       /* Index of the open literal code */
+
+    for (int i = 0; i < count;)
+    {
+        uint8_t value = columns[i];
+        int run = 1;
+        while ((i + run < count) && (columns[i + run] == value) && (run < MAX_RUN + 1))
+        {
+            run++;
+        }
+
+        int plain = (value == 0x00) || (value == 0xFF);
+        if ((plain && ((run >= 2) || (literal < 0))) || (!plain && (run >= 3)))
+        {
+            if (plain)
+            {
+                run = (run > MAX_RUN) ? MAX_RUN : run;
+                packed[size++] = (uint8_t)(((value == 0x00) ? OLED_BITMAP_ZEROS : OLED_BITMAP_ONES) | (run - 1));
+            }
+            else
+            {
+                packed[size++] = (uint8_t)(OLED_BITMAP_REPEAT | (run - 2));
+                packed[size++] = value;
+            }
+            literal = -1;
+            i += run;
+            continue;
+        }
+
+        if ((literal < 0) || ((packed[literal] & OLED_BITMAP_COUNT_MASK) == OLED_BITMAP_COUNT_MASK))
+        {
+            literal = size;
+            packed[size++] = OLED_BITMAP_LITERAL;
+        }
+        else
+        {
+            packed[literal]++;
+        }
+        packed[size++] = value;
+        i++;
+    }
+    return size;
+}
+
+/* Draws the packed bitmap into a cleared framebuffer and compares it with the image */
+static int verify(const struct oled_bitmap *bitmap, uint32_t *wire_bytes)
+{
+    EMU_Reset();
+    OLED_FB_Init();
+    OLED_FB_Flush(NULL);
+
+    OLED_FB_Draw_Bitmap(bitmap, 0, 0);
+    EMU_Clear_Stats();
+    OLED_FB_Flush(NULL);
+    *wire_bytes = EMU_Get_Stats()->wire_bytes;
+
+    for (int y = 0; y < OLED_FB_HEIGHT; y++)
+    {
+        for (int x = 0; x < OLED_FB_WIDTH; x++)
+        {
+            uint8_t expected = (y < height) && (x < width) && pixels[y][x];
+            if (EMU_Get_Pixel((uint8_t)x, (uint8_t)y) != expected)
+            {
+                fprintf(stderr, "decoded bitmap differs at %d,%d\n", x, y);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void write_source(FILE *out, const char *image, const char *name, int size)
+{
+    int raw = (width + 7) / 8 * height;
+
+    fprintf(out, "/******************************************************************************\n");
+    fprintf(out, "* File Name:  %s.c\n", name);
+    fprintf(out, "*\n");
+    fprintf(out, "* Description:  %dx%d pixel bitmap in the packed format of oled_framebuffer.h,\n", width, height);
+    fprintf(out, "*               %d bytes instead of %d. Generated by host/bitmap_convert.c\n", size, raw);
+    fprintf(out, "*               from %s, do not edit.\n", image);
+    fprintf(out, "*\n");
+    fprintf(out, "*******************************************************************************/\n\n");
+    fprintf(out, "#include \"oled_framebuffer.h\"\n\n");
+    fprintf(out, "static const uint8_t %s_data[] =\n{", name);
+    for (int i = 0; i < size; i++)
+    {
+        fprintf(out, "%s0x%02X,", (i % 12 == 0) ? "\n    " : " ", packed[i]);
+    }
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "const struct oled_bitmap bm%s =\n{\n", name);
+    fprintf(out, "    %d,%*s/* Width */\n", width, 8 - snprintf(NULL, 0, "%d", width), "");
+    fprintf(out, "    %d,%*s/* Pages */\n", (height + 7) / 8, 8 - snprintf(NULL, 0, "%d", (height + 7) / 8), "");
+    fprintf(out, "    sizeof(%s_data),\n", name);
+    fprintf(out, "    %s_data\n};\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc < 3) || (argc > 4))
+    {
+        fprintf(stderr, "usage: %s image.pbm name [output.c]\n", argv[0]);
+        return 2;
+    }
+    if (!read_image(argv[1]))
+    {
+        return 1;
+    }
+
+    int size = pack(to_columns());
+    struct oled_bitmap bitmap = {(uint8_t)width, (uint8_t)((height + 7) / 8), (uint16_t)size, packed};
+    uint32_t wire_bytes;
+    if (!verify(&bitmap, &wire_bytes))
+    {
+        return 1;
+    }
+
+    FILE *out = (argc == 4) ? fopen(argv[3], "w") : stdout;
+    if (out == NULL)
+    {
+        fprintf(stderr, "cannot write %s\n", argv[3]);
+        return 1;
+    }
+    write_source(out, argv[1], argv[2], size);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    fprintf(stderr, "%s: %dx%d, %d bytes packed, %d bytes as emWin bitmap, %u I2C bytes on a clear display\n",
+            argv[2], width, height, size, (width + 7) / 8 * height, wire_bytes);
+    return 0;
+}
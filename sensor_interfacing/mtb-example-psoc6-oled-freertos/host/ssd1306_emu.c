@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name:  ssd1306_emu.c
+*
+* Description:  Host emulator of the SSD1306 display RAM. It follows the page
+*               addressing commands, skips the arguments of the other multi
+*               byte commands and writes data streams at the column pointer.
+*
+*******************************************************************************/
+
+#include "ssd1306_emu.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mtb_ssd1306.h"
+
+static uint8_t emu_ram[EMU_PAGES][EMU_WIDTH];
+static uint8_t emu_page;
+static uint8_t emu_column;
+static uint8_t emu_skip;        /* Argument bytes of the last command still to come */
+static emu_stats_t emu_stats;
+
+/* Number of argument bytes of a command */
+static uint8_t emu_arguments(uint8_t command)
+{
+    switch (command)
+    {
+        case 0x20:      /* Memory addressing mode */
+        case 0x81:      /* Contrast */
+        case 0x8D:      /* Charge pump */
+        case 0xA8:      /* Multiplex ratio */
+        case 0xD3:      /* Display offset */
+        case 0xD5:      /* Clock divide */
+        case 0xD9:      /* Pre-charge period */
+        case 0xDA:      /* COM pins */
+        case 0xDB:      /* VCOMH level */
+            return 1;
+        case 0x21:      /* Column address, horizontal and vertical mode */
+        case 0x22:      /* Page address */
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+static void emu_count(uint32_t payload)
+{
+    emu_stats.transactions++;
+    emu_stats.wire_bytes += EMU_OVERHEAD_BYTES + payload;
+}
+
+void mtb_ssd1306_write_command_byte(uint8_t command)
+{
+    emu_count(1);
+    emu_stats.command_bytes++;
+
+    if (emu_skip > 0)
+    {
+        emu_skip--;
+    }
+    else if ((command & 0xF8) == 0xB0)
+    {
+        emu_page = command & 0x07;
+    }
+    else if ((command & 0xF0) == 0x00)
+    {
+        emu_column = (emu_column & 0xF0) | (command & 0x0F);
+    }
+    else if ((command & 0xF0) == 0x10)
+    {
+        emu_column = (uint8_t)(((command & 0x0F) << 4) | (emu_column & 0x0F));
+    }
+    else
+    {
+        emu_skip = emu_arguments(command);
+    }
+}
+
+void mtb_ssd1306_write_data_stream(uint8_t *buffer, uint16_t size)
+{
+    emu_count(size);
+    emu_stats.data_bytes += size;
+
+    /* In page addressing mode the column pointer wraps within the page */
+    for (uint16_t i = 0; i < size; i++)
+    {
+        emu_ram[emu_page][emu_column] = buffer[i];
+        emu_column = (uint8_t)((emu_column + 1) % EMU_WIDTH);
+    }
+}
+
+void EMU_Reset(void)
+{
+    memset(emu_ram, 0, sizeof(emu_ram));
+    emu_page = 0;
+    emu_column = 0;
+    emu_skip = 0;
+    EMU_Clear_Stats();
+}
+
+void EMU_Clear_Stats(void)
+{
+    memset(&emu_stats, 0, sizeof(emu_stats));
+}
+
+const emu_stats_t *EMU_Get_Stats(void)
+{
+    return &emu_stats;
+}
+
+/* 9 clocks per byte with the acknowledge, start and stop per transaction */
+double EMU_Wire_Time_Us(uint32_t wire_bytes, uint32_t transactions)
+{
+    return (9.0 * wire_bytes + 2.0 * transactions) * 1e6 / EMU_I2C_HZ;
+}
+
+uint8_t EMU_Get_Pixel(uint8_t x, uint8_t y)
+{
+    return (emu_ram[y / 8][x] >> (y % 8)) & 1;
+}
+
+const uint8_t *EMU_Get_Page(uint8_t page)
+{
+    return emu_ram[page];
+}
+
+int EMU_Write_PGM(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(f, "P5\n%d %d\n255\n", EMU_WIDTH, EMU_HEIGHT);
+    for (uint8_t y = 0; y < EMU_HEIGHT; y++)
+    {
+        for (uint8_t x = 0; x < EMU_WIDTH; x++)
+        {
+            fputc(EMU_Get_Pixel(x, y) ? 255 : 0, f);
+        }
+    }
+    return fclose(f);
+}
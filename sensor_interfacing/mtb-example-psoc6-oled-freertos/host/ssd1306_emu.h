@@ -0,0 +1,45 @@
+/******************************************************************************
+* File Name:  ssd1306_emu.h
+*
+* Description:  Host emulator of the SSD1306 display RAM behind the write
+*               functions of the display library. It counts the I2C traffic
+*               and dumps the display content as PGM image.
+*
+*******************************************************************************/
+
+#ifndef HOST_SSD1306_EMU_H_
+#define HOST_SSD1306_EMU_H_
+
+#include <stdint.h>
+
+#define EMU_WIDTH           128
+#define EMU_PAGES           8
+#define EMU_HEIGHT          (EMU_PAGES * 8)
+
+/* I2C clock of the display bus */
+#define EMU_I2C_HZ          400000u
+
+/* ********************************************************************
+ * The library writes every command byte and every data stream as one
+ * I2C memory write: the slave address, the control byte (0x00 for a
+ * command, 0x40 for data) and the payload.
+ * ********************************************************************/
+#define EMU_OVERHEAD_BYTES  2u
+
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t command_bytes;
+    uint32_t data_bytes;
+    uint32_t wire_bytes;    /* Including address and control bytes */
+} emu_stats_t;
+
+void EMU_Reset(void);
+void EMU_Clear_Stats(void);
+const emu_stats_t *EMU_Get_Stats(void);
+double EMU_Wire_Time_Us(uint32_t wire_bytes, uint32_t transactions);
+uint8_t EMU_Get_Pixel(uint8_t x, uint8_t y);
+const uint8_t *EMU_Get_Page(uint8_t page);
+int EMU_Write_PGM(const char *path);
+
+#endif /* HOST_SSD1306_EMU_H_ */
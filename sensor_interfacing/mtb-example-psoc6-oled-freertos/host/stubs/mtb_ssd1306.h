@@ -0,0 +1,18 @@
+/******************************************************************************
+* File Name:  mtb_ssd1306.h
+*
+* Description:  Host stand-in for the SSD1306 display library. Only the two
+*               write functions used by the framebuffer are declared, they are
+*               implemented by the display emulator in ssd1306_emu.c.
+*
+*******************************************************************************/
+
+#ifndef HOST_MTB_SSD1306_H_
+#define HOST_MTB_SSD1306_H_
+
+#include <stdint.h>
+
+void mtb_ssd1306_write_command_byte(uint8_t command);
+void mtb_ssd1306_write_data_stream(uint8_t *buffer, uint16_t size);
+
+#endif /* HOST_MTB_SSD1306_H_ */
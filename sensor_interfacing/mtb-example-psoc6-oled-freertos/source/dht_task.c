@@ -46,24 +46,23 @@
 * Function Name: Fraction_Convert
 ****************************************************************************//**
 *
-* Converts a 8 bit binary number into a fractional decimal value
+* Converts a 8 bit binary number into a fraction in Q0.8 format. Bit 0 weighs
+* 1/2 and bit 7 weighs 1/256.
 *
 * \param num
 * 8 bit binary value
 *
 * \return
-* Fractional decimal value of the binary number
+* Fraction of the binary number in 1/256 units
 *
 *******************************************************************************/
-float Fraction_Convert(uint8_t num)
+uint8_t Fraction_Convert(uint8_t num)
 {
-    float fraction = 0;
-    int unit = 0;
+    uint8_t fraction = 0;
     for( int i = 0; i<8; i++)
     {
-        unit = num & 1;
+        fraction = (fraction << 1) | (num & 1);
         num = num>>1;
-        fraction = fraction + unit * pow(2, -(1+i));
     }
     return fraction;
 }
@@ -93,17 +92,17 @@ void DHT_Start(void)
 * Reads the temperature and humidity values if the sensor read is successful
 *
 * \param humidity
-* Pointer to the float variable which stores humidity value
+* Pointer to the variable which stores the humidity in 0.01 %RH
 *
 * \param temperature
-* Pointer to the float variable which stores temperature value
+* Pointer to the variable which stores the temperature in 0.01 degC
 *
 * \return
 * Status of sensor read
 *
 *******************************************************************************/
 
-uint8 DHT_Read(float* humidity, float* temperature)
+uint8 DHT_Read(int16_t* humidity, int16_t* temperature)
 {
     uint8_t delay_time = 0, ack_time = 0;
     uint8_t temp = 0, index = 0, bit_count = 7;
@@ -205,8 +204,9 @@ uint8 DHT_Read(float* humidity, float* temperature)
     if((temp == byteval[4]) && (byteval[4] != 0))
     {
         /* Pass the temperature and humidity data only when checksum is matched and it is not equal to 0 */
-        *humidity = (int)byteval[0] + Fraction_Convert(byteval[1]);
-        *temperature = (int)byteval[2] + Fraction_Convert(byteval[3]);
+        /* Integral byte and binary fraction, together a Q8.8 value */
+        *humidity = (int16_t)Fixed_From_Q((byteval[0] << 8) | Fraction_Convert(byteval[1]), 8, DHT_DECIMALS);
+        *temperature = (int16_t)Fixed_From_Q((byteval[2] << 8) | Fraction_Convert(byteval[3]), 8, DHT_DECIMALS);
 
         return SUCCESS;
     }
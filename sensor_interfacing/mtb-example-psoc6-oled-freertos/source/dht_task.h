@@ -43,13 +43,14 @@
 #define SOURCE_DHT_TASK_H_
 
 #include "main.h"
+#include "fixed_format.h"
 
 /* Sensor timeout duration can be changed here */
 #define timeout_duration 100
 
-float Fraction_Convert(uint8_t num);
+uint8_t Fraction_Convert(uint8_t num);
 void DHT_Start(void);
-uint8 DHT_Read(float* humidity, float* temperature);
+uint8 DHT_Read(int16_t* humidity, int16_t* temperature);
 void DHT_Task(void* pvParameters);
 
 
@@ -1,123 +1,45 @@
-/*********************************************************************
-*            (c) 1998 - 2019 Segger Microcontroller GmbH             *
-*        Solutions for real time microcontroller applications        *
-*                           www.segger.com                           *
-**********************************************************************
-*                                                                    *
-* C-file generated by                                                *
-*                                                                    *
-*        Bitmap Converter for emWin (Demo version) V6.14.            *
-*        Compiled Jul  2 2020, 09:35:58                              *
-*                                                                    *
-*        (c) 1998 - 2019 Segger Microcontroller GmbH                 *
-*                                                                    *
-*        May not be used in a product                                *
-*                                                                    *
-**********************************************************************
-*                                                                    *
-* Source file: cy                                                    *
-* Dimensions:  128 * 47                                              *
-* NumColors:   2                                                     *
-*                                                                    *
-**********************************************************************
-*/
-
-#include <stdlib.h>
-
-#include "GUI.h"
-
-#ifndef GUI_CONST_STORAGE
-  #define GUI_CONST_STORAGE const
-#endif
-
-extern GUI_CONST_STORAGE GUI_BITMAP bmcy;
-
-/*********************************************************************
-*
-*       Palette
+/******************************************************************************
+* File Name:  cy.c
 *
-*  Description
-*    The following are the entries of the palette table.
-*    The entries are stored as a 32-bit values of which 24 bits are
-*    actually used according to the following bit mask: 0xBBGGRR
+* Description:  128x47 pixel bitmap in the packed format of oled_framebuffer.h,
+*               271 bytes instead of 752. Generated by host/bitmap_convert.c
+*               from host/images/cy.pbm, do not edit.
 *
-*    The lower   8 bits represent the Red   component.
-*    The middle  8 bits represent the Green component.
-*    The highest 8 bits represent the Blue  component.
-*/
-static GUI_CONST_STORAGE GUI_COLOR _Colorscy[] = {
-#if (GUI_USE_ARGB == 0)
-  0x000000, 0xFFFFFF
-#else
-  0xFF000000, 0xFFFFFFFF
-#endif
-
-};
-
-static GUI_CONST_STORAGE GUI_LOGPALETTE _Palcy = {
-  2,  // Number of entries
-  0,  // No transparency
-  (const LCD_COLOR *)&_Colorscy[0]
+*******************************************************************************/
+
+#include "oled_framebuffer.h"
+
+static const uint8_t cy_data[] =
+{
+    0x8E, 0x03, 0x7F, 0x7F, 0x3F, 0x3F, 0xC2, 0x1F, 0xC4, 0x0F, 0xC1, 0x1F,
+    0xC1, 0x3F, 0x00, 0x7F, 0xBF, 0xA4, 0x04, 0x3F, 0x0F, 0x07, 0x43, 0xC1,
+    0xC1, 0xC0, 0x01, 0xE0, 0xE0, 0xC3, 0xF0, 0xC4, 0xE0, 0xC5, 0x80, 0x05,
+    0x81, 0x81, 0x87, 0x0F, 0x1F, 0x7F, 0x85, 0x00, 0x7F, 0xC3, 0x3F, 0x00,
+    0x7F, 0x81, 0x02, 0xBF, 0x3F, 0x3F, 0x82, 0x02, 0x7F, 0x3F, 0x3F, 0x81,
+    0xC5, 0x3F, 0x00, 0x7F, 0x83, 0xC4, 0x3F, 0x01, 0x7F, 0x7F, 0x82, 0xC7,
+    0x3F, 0x82, 0x00, 0x7F, 0xC3, 0x3F, 0x00, 0x7F, 0x83, 0x00, 0x7F, 0xC3,
+    0x3F, 0x00, 0x7F, 0x8C, 0x03, 0x1F, 0x06, 0x06, 0x07, 0xC1, 0x0F, 0x01,
+    0x1F, 0x1F, 0xC4, 0x3F, 0x03, 0x1F, 0x5F, 0x5F, 0x7F, 0x81, 0xC2, 0x7F,
+    0x83, 0x07, 0xBF, 0xBF, 0x9F, 0xDF, 0xDF, 0xCF, 0xC3, 0xC7, 0x83, 0x41,
+    0x00, 0xFE, 0x81, 0x03, 0xFE, 0xF8, 0xF0, 0xF9, 0x81, 0x06, 0xFE, 0xF0,
+    0x80, 0x03, 0x03, 0xC0, 0xF8, 0x82, 0x42, 0xC1, 0x3F, 0x02, 0x1E, 0x00,
+    0x80, 0x82, 0x41, 0xC1, 0x3F, 0x03, 0x1E, 0x00, 0x80, 0xF3, 0x81, 0x42,
+    0xC2, 0x1F, 0x83, 0x08, 0xF0, 0xC0, 0xC6, 0x8F, 0x1F, 0x3F, 0x78, 0xF8,
+    0xF8, 0x81, 0x08, 0xF9, 0xE0, 0xC0, 0x8E, 0x1F, 0x1F, 0x3E, 0x78, 0xF8,
+    0x8B, 0x02, 0xFE, 0xE0, 0x80, 0x4E, 0x08, 0xC0, 0xE0, 0xF1, 0x7F, 0x1E,
+    0x1E, 0x0F, 0x03, 0x01, 0x47, 0x01, 0xC0, 0xF8, 0x83, 0x08, 0xE0, 0xC0,
+    0x8F, 0x9F, 0x9F, 0x8F, 0x81, 0xC1, 0xF1, 0x84, 0x01, 0x80, 0x80, 0x84,
+    0xC1, 0x80, 0x01, 0xFE, 0xFE, 0x86, 0x01, 0x80, 0x80, 0x81, 0x03, 0xFE,
+    0xE0, 0x80, 0x87, 0x82, 0xC1, 0x80, 0xC4, 0x9F, 0x81, 0x08, 0xE3, 0xC3,
+    0x87, 0x9F, 0x9F, 0x8E, 0x80, 0xC0, 0xE1, 0x81, 0x08, 0xF3, 0xC3, 0x83,
+    0x8F, 0x9F, 0x9E, 0x8C, 0xC0, 0xE0, 0x8E, 0x00, 0xFE, 0xC7, 0xFC, 0xC1,
+    0xFE, 0xBF, 0xA8, 0xFF, 0x7F, 0xFD, 0x7F,
 };
 
-static GUI_CONST_STORAGE unsigned char _accy[] = {
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXX_, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXX_____, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, X_______, ________, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXX_, ________, ________, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXX__, ________, ________, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXX___, ________, ________, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXX____, ________, ________, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXX_____, ________, ________, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XX______, ___XXXXX, ________, ________, _XXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XX______, _XXXXXXX, XXXXXX__, ________, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, X___XXXX, XXXXXXXX, XXXXXX__, ________, __XXXXXX, XX_____X, XX___XXX, X__XX___, ____XXXX, X______X, XXXX____, _____XXX, X_____XX, XXXX____, _XXXXXXX,
-  XXXXXXXX, X____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, ___XXXXX, X_______, XXX__XXX, ___XX___, _____XXX, X_______, _XXX____, _____XXX, _______X, XXX_____, __XXXXXX,
-  XXXXXXXX, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, ___XX___, XXX___XX, __XXX___, XXX___XX, X__XXX__, _XXX___X, XXXXXXX_, __XXX___, XXX___XX, ___XXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, __XXXX__, _XXX__XX, __XXX___, XXXX__XX, X__XXXX_, _XXX___X, XXXXXXX_, _XXXX___, XX___XXX, X__XXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XX_XXXXX, __XXXX__, _XXX____, __XXX___, XXXX__XX, X__XXXX_, __XX___X, XXXXXXX_, _XXXX___, XX___XXX, X__XXXXX,
-  XXXXXXXX, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XX__XXXX, __XXXXX_, XXXX____, _XXXX___, XXXX__XX, X__XXXX_, __XX___X, XXXXXXX_, __XXXXXX, XXX__XXX, XXXXXXXX,
-  XXXXXXXX, ______XX, XXXXXXXX, XXXXXXXX, XXXXXXXX, X___XXXX, __XXXXXX, XXXXX___, _XXXX___, XXXX__XX, X__XXXX_, _XXX___X, XXXXXXXX, ___XXXXX, XXX___XX, XXXXXXXX,
-  XXXXXXX_, ________, XXXXXX__, _XXXXXXX, XXXXXX__, ____XXXX, __XXXXXX, XXXXX___, _XXXX___, XXX___XX, X__XXX__, _XXX____, ___XXXXX, ____XXXX, XXXX____, XXXXXXXX,
-  XXXXXXX_, ________, _______X, XXXXXXXX, XXXX___X, XXXXXXXX, __XXXXXX, XXXXX___, XXXXX___, ______XX, X_______, _XXX____, ___XXXXX, XX___XXX, XXXXX___, _XXXXXXX,
-  XXXXXXX_, ________, ________, __XX____, XXXXXXXX, XXXXXXXX, __XXXXXX, XXXXXX__, XXXXX___, _____XXX, X_______, XXXX____, ___XXXXX, XXX___XX, XXXXXX__, __XXXXXX,
-  XXXXXXX_, ________, ________, ___XX__X, XX______, ____XXXX, __XXXXXX, XXXXXX__, XXXXX___, __XXXXXX, X__XX___, XXXX___X, XXXXXXXX, XXXX___X, XXXXXXX_, ___XXXXX,
-  XXXXXXXX, ________, ________, ____XXXX, X_______, ____XXXX, __XXXX__, _XXXXX__, XXXXX___, XXXXXXXX, X__XXX__, XXXX___X, XXXXXXXX, XXXXX___, XXXXXXXX, ___XXXXX,
-  XXXXXXXX, ________, ________, ____XXXX, ________, ____XXXX, __XXXX__, _XXXXX__, XXXXX___, XXXXXXXX, X__XXX__, XXXX___X, XXXXXXX_, _XXXX___, XX___XXX, X__XXXXX,
-  XXXXXXXX, ________, ________, ____XXXX, ________, ___XXXXX, __XXXX__, _XXXXX__, XXXXX___, XXXXXXXX, X__XXX__, _XXX___X, XXXXXXX_, __XXX___, XX___XXX, X__XXXXX,
-  XXXXXXXX, ________, ________, ___XXXX_, ________, ___XXXXX, ___XX___, XXXXXX__, XXXXX___, XXXXXXXX, X__XXX__, _XXX___X, XXXXXXX_, __XX____, XXX___XX, ___XXXXX,
-  XXXXXXXX, X_______, ________, __XXX___, ________, ___XXXXX, X_______, XXXXXX__, XXXXX___, XXXXXXXX, X__XXXX_, _XXX____, _____XXX, _______X, XXX_____, __XXXXXX,
-  XXXXXXXX, X_______, ________, _XXXX___, ________, __XXXXXX, XX_____X, XXXXXX__, XXXXX___, XXXXXXXX, X__XXXX_, _XXX____, _____XXX, X_____XX, XXXX____, _XXXXXXX,
-  XXXXXXXX, XX______, ________, _XXX____, ________, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XX______, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXX_____, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX
+const struct oled_bitmap bmcy =
+{
+    128,     /* Width */
+    6,       /* Pages */
+    sizeof(cy_data),
+    cy_data
 };
-
-GUI_CONST_STORAGE GUI_BITMAP bmcy = {
-  128, // xSize
-  47, // ySize
-  16, // BytesPerLine
-  1, // BitsPerPixel
-  (const unsigned char *)_accy,  // Pointer to picture data (indices)
-  &_Palcy,  // Pointer to palette
-  NULL
-};
-
-/*************************** End of file ****************************/
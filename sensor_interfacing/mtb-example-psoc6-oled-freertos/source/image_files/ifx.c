@@ -1,130 +1,50 @@
-/*********************************************************************
-*            (c) 1998 - 2019 Segger Microcontroller GmbH             *
-*        Solutions for real time microcontroller applications        *
-*                           www.segger.com                           *
-**********************************************************************
-*                                                                    *
-* C-file generated by                                                *
-*                                                                    *
-*        Bitmap Converter for emWin (Demo version) V6.14.            *
-*        Compiled Jul  2 2020, 09:35:58                              *
-*                                                                    *
-*        (c) 1998 - 2019 Segger Microcontroller GmbH                 *
-*                                                                    *
-*        May not be used in a product                                *
-*                                                                    *
-**********************************************************************
-*                                                                    *
-* Source file: ifx                                                   *
-* Dimensions:  128 * 54                                              *
-* NumColors:   2                                                     *
-*                                                                    *
-**********************************************************************
-*/
-
-#include <stdlib.h>
-
-#include "GUI.h"
-
-#ifndef GUI_CONST_STORAGE
-  #define GUI_CONST_STORAGE const
-#endif
-
-extern GUI_CONST_STORAGE GUI_BITMAP bmifx;
-
-/*********************************************************************
-*
-*       Palette
+/******************************************************************************
+* File Name:  ifx.c
 *
-*  Description
-*    The following are the entries of the palette table.
-*    The entries are stored as a 32-bit values of which 24 bits are
-*    actually used according to the following bit mask: 0xBBGGRR
+* Description:  128x54 pixel bitmap in the packed format of oled_framebuffer.h,
+*               328 bytes instead of 864. Generated by host/bitmap_convert.c
+*               from host/images/ifx.pbm, do not edit.
 *
-*    The lower   8 bits represent the Red   component.
-*    The middle  8 bits represent the Green component.
-*    The highest 8 bits represent the Blue  component.
-*/
-static GUI_CONST_STORAGE GUI_COLOR _Colorsifx[] = {
-#if (GUI_USE_ARGB == 0)
-  0x000000, 0xFFFFFF
-#else
-  0xFF000000, 0xFFFFFFFF
-#endif
-
-};
-
-static GUI_CONST_STORAGE GUI_LOGPALETTE _Palifx = {
-  2,  // Number of entries
-  0,  // No transparency
-  (const LCD_COLOR *)&_Colorsifx[0]
+*******************************************************************************/
+
+#include "oled_framebuffer.h"
+
+static const uint8_t ifx_data[] =
+{
+    0x94, 0xC3, 0x7F, 0x80, 0x00, 0xBF, 0xC1, 0x3F, 0x04, 0x1F, 0x1F, 0x9F,
+    0x8F, 0x8F, 0xC1, 0xCF, 0xC2, 0xE7, 0xC1, 0xF7, 0x01, 0xF3, 0xF3, 0xC3,
+    0xFB, 0xBF, 0x95, 0x09, 0x7F, 0x3F, 0x1F, 0x1F, 0x0F, 0x07, 0x87, 0x87,
+    0xDF, 0xF0, 0xC2, 0xE0, 0x00, 0xF0, 0x81, 0x01, 0xFE, 0xFE, 0x8D, 0x08,
+    0x3F, 0x1F, 0x0F, 0x8F, 0xCF, 0xCF, 0xEF, 0xFF, 0xBF, 0xC1, 0x1F, 0xBF,
+    0x8C, 0x0A, 0x3F, 0x0F, 0x07, 0x03, 0x01, 0x00, 0xC0, 0xF0, 0xF8, 0xFC,
+    0xFE, 0x85, 0x42, 0x83, 0xC1, 0x07, 0x06, 0x8F, 0xCF, 0xC7, 0xC7, 0x07,
+    0x07, 0x0F, 0x83, 0x00, 0xC7, 0x42, 0xC1, 0xC7, 0x82, 0x02, 0x07, 0x06,
+    0x07, 0x83, 0x0A, 0xCF, 0x07, 0x07, 0x0F, 0xCF, 0xC7, 0xC7, 0x87, 0x07,
+    0x0F, 0x3F, 0x83, 0x08, 0x1F, 0x0F, 0x87, 0xC7, 0xE7, 0xC7, 0x87, 0x0F,
+    0x1F, 0x83, 0x02, 0x3F, 0x0F, 0x0F, 0xC2, 0xC7, 0x02, 0x0F, 0x0F, 0x3F,
+    0x83, 0x09, 0x07, 0x07, 0x0F, 0x8F, 0xCF, 0xC7, 0x87, 0x07, 0x0F, 0x1F,
+    0x93, 0x00, 0xC1, 0x44, 0x01, 0x0E, 0x7F, 0x89, 0x42, 0x83, 0x42, 0x83,
+    0x42, 0x84, 0x42, 0x85, 0x42, 0x84, 0x41, 0x84, 0x42, 0x82, 0x00, 0x80,
+    0x41, 0x00, 0x73, 0xC2, 0xF3, 0xC1, 0xF0, 0x81, 0x00, 0xE3, 0x42, 0x83,
+    0x42, 0x00, 0xE3, 0x82, 0x42, 0x83, 0x42, 0x94, 0x0D, 0xFE, 0xF8, 0xF0,
+    0xE0, 0xC0, 0x80, 0x00, 0x01, 0x03, 0x07, 0x1F, 0x1F, 0x3F, 0x7F, 0x82,
+    0xC1, 0xF0, 0x83, 0xC1, 0xF0, 0x83, 0xC1, 0xF0, 0x84, 0xC1, 0xF0, 0x85,
+    0xC1, 0xF0, 0x84, 0x01, 0xF0, 0xF0, 0x84, 0xC1, 0xF0, 0x83, 0x08, 0xFC,
+    0xF8, 0xF0, 0xF1, 0xF3, 0xF3, 0xF1, 0xF1, 0xF8, 0x83, 0x09, 0xFE, 0xF8,
+    0xF0, 0xF1, 0xF3, 0xF3, 0xF1, 0xF0, 0xF8, 0xFE, 0x83, 0xC1, 0xF0, 0x83,
+    0xC1, 0xF0, 0x9B, 0x10, 0xFE, 0xFE, 0xFC, 0xF8, 0xF8, 0xF0, 0xF0, 0xE0,
+    0xE0, 0xC1, 0xC3, 0x83, 0x87, 0x87, 0x07, 0x0F, 0x0F, 0xC1, 0x1F, 0xC1,
+    0x3F, 0xC2, 0x7F, 0xB9, 0xC3, 0x7F, 0x05, 0x3F, 0xBF, 0xBF, 0x9F, 0xDF,
+    0xDF, 0xC1, 0xEF, 0x03, 0xF7, 0xF7, 0xFF, 0xFB, 0x8C, 0xDB, 0x3F, 0xC2,
+    0x3E, 0xC2, 0x3C, 0xC4, 0x38, 0x01, 0x30, 0x30, 0xC4, 0x31, 0x00, 0x21,
+    0xD9, 0x23, 0xC2, 0x33, 0xC2, 0x31, 0xC2, 0x39, 0x00, 0x38, 0xC2, 0x3C,
+    0xC2, 0x3E, 0xDA, 0x3F,
 };
 
-static GUI_CONST_STORAGE unsigned char _acifx[] = {
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXX__, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXX_, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XX______, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXX_, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXX_____, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXX___, __XX____, _XXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXX____, __XX__XX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXX____, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXX____, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, ___X____, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXX_, ___XX___, _XXXXXXX, XXXXXXXX, XXXXXX__, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXX___, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXX___, __XXX___, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXX____, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXX____, XXXX____, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXX_____, _XXXXXXX, XXXXXXXX, XXXXXXXX, XXXX___X, XXXXX___, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XX______, XXXXXX__, _XXXXXXX, XXXXXXXX, XXXX___X, XXXXXX_X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, X______X, XXXXXX__, _XXXXXXX, XXXXXXXX, XXXX___X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, ______XX, XXXXXX__, _XXXXXXX, XXXXXXXX, XXXX___X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXX_, _____XXX, XXXXXX__, _XXXX___, XX____XX, XXX_____, __XXX___, XXXXX__X, X____XXX, XXXXX___, __XXXXXX, XXX____X, XXXXXX__, XXX___XX, XXXXXXXX, XXXXXXXX,
-  XXXXXX__, ____XXXX, XXXXXX__, _XXXX___, _______X, XXX_____, __XXX___, XXXX____, ______XX, XXXX____, ___XXXXX, X_______, _XXXXX__, _______X, XXXXXXXX, XXXXXXXX,
-  XXXXXX__, ____XXXX, XXXXXX__, _XXXX___, _______X, XXX_____, __XXX___, XXXX____, ______XX, XXX____X, ____XXXX, X_______, _XXXXX__, ________, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ___XXXXX, XXXXXX__, _XXXX___, _XXX___X, XXXX___X, XXXXX___, XXXXX___, XXX____X, XXX___XX, X___XXXX, ___XXXX_, __XXXX__, __XX____, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ___XXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX___, XXXX___X, XXX__XXX, XX__XXXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ___XXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX___XXX, XX___XXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXX____, __XXXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX___XXX, XX___XXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXX____, __XXXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX______, _____XX_, ___XXXX_, ___XXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXX____, __XXXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX______, _____XX_, ___XXXX_, ___XXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXX____, ___XXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX___XXX, XXXXXXX_, ___XXXX_, ___XXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXX____, ___XXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX___XXX, XXXXXXXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ___XXXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XX___XXX, XXXXXXXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ____XXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XXX___XX, XXXXXXXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXX___, ____XXXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XXX___XX, XXX_XXXX, ___XXXX_, __XXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXXX__, _____XXX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XXX____X, X___XXXX, X___XX__, _XXXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXXX__, ______XX, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XXXX____, ____XXXX, X_______, _XXXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXXXX_, _______X, XXXXXX__, _XXXX___, XXXX___X, XXXX___X, XXXXX___, XXXXX__X, XXXX___X, XXXXX___, ___XXXXX, XX______, XXXXXX__, _XXXX___, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, X_______, _XXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XX______, __XXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXX_____, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXX____, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXX__, ______XX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXX_, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XX_XXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, X_______, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXX_, _XXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXX_____, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXX___X, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXX___, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, X___XXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXX_, ________, ___XXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXX__, __XXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XX______, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, X______X, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXX___, ________, _____XXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXX_____, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, X_______, ________, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXX_____, ________, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXX___, ________, ________, ________, ________, ________, ________, ____XXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXX_____, ________, ________, ________, ________, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXX_____, ________, ________, _______X, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX,
-  XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX, XXXXXXXX
+const struct oled_bitmap bmifx =
+{
+    128,     /* Width */
+    7,       /* Pages */
+    sizeof(ifx_data),
+    ifx_data
 };
-
-GUI_CONST_STORAGE GUI_BITMAP bmifx = {
-  128, // xSize
-  54, // ySize
-  16, // BytesPerLine
-  1, // BitsPerPixel
-  (const unsigned char *)_acifx,  // Pointer to picture data (indices)
-  &_Palifx,  // Pointer to palette
-  NULL
-};
-
-/*************************** End of file ****************************/
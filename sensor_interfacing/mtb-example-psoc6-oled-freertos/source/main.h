@@ -46,7 +46,6 @@
 #include "cyhal.h"
 #include "cybsp.h"
 #include "cy_retarget_io.h"
-#include <math.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -64,6 +63,7 @@
 /* Event bit macros */
 #define PRINT_TASK_NOTIFY_EVENTBIT	(1UL << 0UL) /* Event bit 0 for Print Task */
 #define OLED_TASK_NOTIFY_EVENTBIT	(1UL << 1UL) /* Event bit 1 for OLED Task */
+#define OLED_TASK_SPLASH_EVENTBIT	(1UL << 2UL) /* Event bit 2 for the splash timer of OLED Task */
 
 /* Task handles for each task */
 TaskHandle_t DHT_Task_handle, Print_Task_handle, OLED_Task_handle;
@@ -71,11 +71,14 @@ TaskHandle_t DHT_Task_handle, Print_Task_handle, OLED_Task_handle;
 /* Event Group Handle */
 EventGroupHandle_t dht_reading_notify_event_group;
 
+/* Readings are integers in 0.01 units, e.g. 2350 is 23.50 degC */
+#define DHT_DECIMALS	2
+
 /* Structure to store temperature and humidity readings */
 struct readings
 {
-	float humidity;
-	float temperature;
+	int16_t humidity;		/* 0.01 %RH */
+	int16_t temperature;	/* 0.01 degC */
 	uint8 result_code;
 };
 
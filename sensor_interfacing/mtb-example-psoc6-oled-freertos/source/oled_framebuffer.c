@@ -0,0 +1,357 @@
+/******************************************************************************
+* File Name:  oled_framebuffer.c
+*
+* Description:  This file contains the shadow framebuffer of the SSD1306. A
+*               frame is converted from row order to the page order of the
+*               display RAM, compared with what the display shows, and only
+*               the changed column range of each page is sent over I2C.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+#include "oled_framebuffer.h"
+
+#include <string.h>
+
+#include "mtb_ssd1306.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Copy of the display RAM, one byte per column and page, bit 0 is the top row */
+static uint8_t oled_fb[OLED_FB_PAGES][OLED_FB_WIDTH];
+
+/* Changed columns per page, not yet sent */
+static struct oled_fb_dirty oled_fb_dirty[OLED_FB_PAGES];
+
+
+/*******************************************************************************
+* Function Name: OLED_FB_Mark_Dirty
+****************************************************************************//**
+*
+* Adds a column to the dirty range of a page.
+*
+* \param page
+* Page 0 to 7
+*
+* \param column
+* Column 0 to 127
+*
+*******************************************************************************/
+static void OLED_FB_Mark_Dirty(uint8_t page, uint8_t column)
+{
+    struct oled_fb_dirty *dirty = &oled_fb_dirty[page];
+
+    if(dirty->first > dirty->last)
+    {
+        dirty->first = column;
+        dirty->last = column;
+    }
+    else if(column < dirty->first)
+    {
+        dirty->first = column;
+    }
+    else if(column > dirty->last)
+    {
+        dirty->last = column;
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Transpose
+****************************************************************************//**
+*
+* Transposes 8 row bytes of 8 pixels each into 8 column bytes of a page.
+*
+* \param rows
+* First row byte, leftmost pixel in the MSB
+*
+* \param bytes_per_line
+* Distance of the row bytes
+*
+* \param columns
+* Array of 8 bytes which stores the columns, top row in bit 0
+*
+*******************************************************************************/
+static void OLED_FB_Transpose(const uint8_t *rows, uint16_t bytes_per_line, uint8_t *columns)
+{
+    uint32_t high = 0, low = 0, t;
+
+    /* Rows 7 to 4 from the MSB of high, rows 3 to 0 from the MSB of low */
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        high |= (uint32_t)rows[(7 - i) * bytes_per_line] << (24 - 8 * i);
+        low |= (uint32_t)rows[(3 - i) * bytes_per_line] << (24 - 8 * i);
+    }
+
+    /* 8x8 bit matrix transpose, Hacker's Delight 7-3 */
+    t = (high ^ (high >> 7)) & 0x00AA00AA;
+    high = high ^ t ^ (t << 7);
+    t = (low ^ (low >> 7)) & 0x00AA00AA;
+    low = low ^ t ^ (t << 7);
+    t = (high ^ (high >> 14)) & 0x0000CCCC;
+    high = high ^ t ^ (t << 14);
+    t = (low ^ (low >> 14)) & 0x0000CCCC;
+    low = low ^ t ^ (t << 14);
+    t = (high & 0xF0F0F0F0) | ((low >> 4) & 0x0F0F0F0F);
+    low = ((high << 4) & 0xF0F0F0F0) | (low & 0x0F0F0F0F);
+    high = t;
+
+    /* Column 0, the MSB of the rows, comes first */
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        columns[i] = (uint8_t)(high >> (24 - 8 * i));
+        columns[i + 4] = (uint8_t)(low >> (24 - 8 * i));
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Init
+****************************************************************************//**
+*
+* Clears the framebuffer. The content of the display is unknown, so the next
+* flush sends the whole frame.
+*
+*******************************************************************************/
+void OLED_FB_Init(void)
+{
+    memset(oled_fb, 0, sizeof(oled_fb));
+    OLED_FB_Invalidate();
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Invalidate
+****************************************************************************//**
+*
+* Marks the whole frame dirty, e.g. after something else wrote to the display.
+*
+*******************************************************************************/
+void OLED_FB_Invalidate(void)
+{
+    for(uint8_t page = 0; page < OLED_FB_PAGES; page++)
+    {
+        oled_fb_dirty[page].first = 0;
+        oled_fb_dirty[page].last = OLED_FB_WIDTH - 1;
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Put
+****************************************************************************//**
+*
+* Writes a column byte to the framebuffer and marks it if it changed. Bytes
+* outside of the display are dropped.
+*
+* \param page
+* Page of the byte
+*
+* \param column
+* Column of the byte
+*
+* \param value
+* Column byte, bit 0 is the top row
+*
+*******************************************************************************/
+static inline void OLED_FB_Put(uint16_t page, uint16_t column, uint8_t value)
+{
+    if((page < OLED_FB_PAGES) && (column < OLED_FB_WIDTH) && (oled_fb[page][column] != value))
+    {
+        oled_fb[page][column] = value;
+        OLED_FB_Mark_Dirty(page, column);
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Clear
+****************************************************************************//**
+*
+* Clears the framebuffer. Only the columns which were lit are sent with the
+* next flush.
+*
+*******************************************************************************/
+void OLED_FB_Clear(void)
+{
+    for(uint8_t page = 0; page < OLED_FB_PAGES; page++)
+    {
+        for(uint8_t column = 0; column < OLED_FB_WIDTH; column++)
+        {
+            OLED_FB_Put(page, column, 0);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Draw_Bitmap
+****************************************************************************//**
+*
+* Decodes a packed bitmap straight into the framebuffer. Its bytes are already
+* in page order, so every byte is one column of the display RAM. The parts of
+* the bitmap outside of the display are dropped.
+*
+* \param bitmap
+* Pointer to the packed bitmap
+*
+* \param x
+* Column of the left edge
+*
+* \param page
+* Page of the top edge
+*
+*******************************************************************************/
+void OLED_FB_Draw_Bitmap(const struct oled_bitmap *bitmap, uint8_t x, uint8_t page)
+{
+    const uint8_t *data = bitmap->data;
+    const uint8_t *end = data + bitmap->size;
+    uint16_t current_page = page;
+    uint8_t column = 0;
+
+    while(data < end)
+    {
+        uint8_t code = *data++;
+        uint8_t count = (code & OLED_BITMAP_COUNT_MASK) + 1;
+        uint8_t value = 0;
+
+        switch(code & OLED_BITMAP_CODE_MASK)
+        {
+            case OLED_BITMAP_ONES:
+                value = 0xFF;
+                break;
+            case OLED_BITMAP_REPEAT:
+                value = *data++;
+                count++;
+                break;
+            default:
+                break;
+        }
+
+        for(; count > 0; count--)
+        {
+            if((code & OLED_BITMAP_CODE_MASK) == OLED_BITMAP_LITERAL)
+            {
+                value = *data++;
+            }
+            OLED_FB_Put(current_page, x + column, value);
+
+            /* Runs continue on the next page */
+            if(++column == bitmap->width)
+            {
+                column = 0;
+                current_page++;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Update
+****************************************************************************//**
+*
+* Copies a frame into the framebuffer and marks the columns which changed.
+*
+* \param image
+* Row-major 1bpp frame of OLED_FB_WIDTH x OLED_FB_HEIGHT pixels, leftmost pixel
+* in the MSB, 1 is a lit pixel
+*
+* \param bytes_per_line
+* Bytes per line of the frame, at least OLED_FB_BYTES_PER_LINE
+*
+*******************************************************************************/
+void OLED_FB_Update(const uint8_t *image, uint16_t bytes_per_line)
+{
+    uint8_t columns[8];
+
+    for(uint8_t page = 0; page < OLED_FB_PAGES; page++)
+    {
+        const uint8_t *rows = image + page * 8 * bytes_per_line;
+
+        for(uint8_t block = 0; block < OLED_FB_BYTES_PER_LINE; block++)
+        {
+            uint8_t *current = &oled_fb[page][block * 8];
+
+            OLED_FB_Transpose(rows + block, bytes_per_line, columns);
+            if(memcmp(current, columns, sizeof(columns)) == 0)
+            {
+                continue;
+            }
+            for(uint8_t i = 0; i < 8; i++)
+            {
+                if(current[i] != columns[i])
+                {
+                    current[i] = columns[i];
+                    OLED_FB_Mark_Dirty(page, block * 8 + i);
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Flush
+****************************************************************************//**
+*
+* Sends the dirty column range of every page to the display. Each range costs
+* three command bytes to set page and start column, the display RAM is in page
+* addressing mode.
+*
+* \param stats
+* Pointer to the structure which stores the transfers, may be NULL
+*
+* \return
+* Number of pages sent
+*
+*******************************************************************************/
+uint8_t OLED_FB_Flush(struct oled_fb_stats *stats)
+{
+    uint8_t pages = 0;
+    uint16_t data = 0;
+
+    for(uint8_t page = 0; page < OLED_FB_PAGES; page++)
+    {
+        struct oled_fb_dirty *dirty = &oled_fb_dirty[page];
+        uint8_t count;
+
+        if(dirty->first > dirty->last)
+        {
+            continue;
+        }
+        count = dirty->last - dirty->first + 1;
+
+        mtb_ssd1306_write_command_byte(OLED_FB_CMD_PAGE | page);
+        mtb_ssd1306_write_command_byte(OLED_FB_CMD_COL_LOW | (dirty->first & 0x0F));
+        mtb_ssd1306_write_command_byte(OLED_FB_CMD_COL_HIGH | (dirty->first >> 4));
+        mtb_ssd1306_write_data_stream(&oled_fb[page][dirty->first], count);
+
+        data += count;
+        pages++;
+        dirty->first = 1;
+        dirty->last = 0;
+    }
+
+    if(stats != NULL)
+    {
+        stats->commands = 3 * pages;
+        stats->data = data;
+        stats->transfers = pages;
+    }
+    return pages;
+}
+
+/*******************************************************************************
+* Function Name: OLED_FB_Get_Page
+****************************************************************************//**
+*
+* Returns the framebuffer content of a page.
+*
+* \param page
+* Page 0 to 7
+*
+* \return
+* Pointer to the OLED_FB_WIDTH column bytes of the page
+*
+*******************************************************************************/
+const uint8_t *OLED_FB_Get_Page(uint8_t page)
+{
+    return oled_fb[page];
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name:  oled_framebuffer.h
+*
+* Description:  This file provides the shadow framebuffer of the SSD1306. It
+*               keeps a copy of the display RAM and only sends the columns of
+*               each 8 row page that changed.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************/
+
+#ifndef SOURCE_OLED_FRAMEBUFFER_H_
+#define SOURCE_OLED_FRAMEBUFFER_H_
+
+#include <stdint.h>
+
+/* Display size */
+#define OLED_FB_WIDTH           128
+#define OLED_FB_HEIGHT          64
+#define OLED_FB_PAGES           (OLED_FB_HEIGHT / 8)
+
+/* Bytes per line of a row-major 1bpp image of the display, leftmost pixel in the MSB */
+#define OLED_FB_BYTES_PER_LINE  (OLED_FB_WIDTH / 8)
+
+/* SSD1306 page addressing commands */
+#define OLED_FB_CMD_PAGE        0xB0    /* | page */
+#define OLED_FB_CMD_COL_LOW     0x00    /* | low nibble of the column */
+#define OLED_FB_CMD_COL_HIGH    0x10    /* | high nibble of the column */
+
+/* ********************************************************************
+ * Packed bitmap, the column bytes of its pages in page order, i.e.
+ * the bytes of the display RAM. Every code byte is followed by:
+ *   00nnnnnn  n + 1 literal bytes
+ *   01nnnnnn  nothing, n + 1 bytes of 0x00
+ *   10nnnnnn  nothing, n + 1 bytes of 0xFF
+ *   11nnnnnn  one byte, repeated n + 2 times
+ * host/bitmap_convert.c generates the arrays from PBM or PGM images.
+ * ********************************************************************/
+#define OLED_BITMAP_LITERAL     0x00
+#define OLED_BITMAP_ZEROS       0x40
+#define OLED_BITMAP_ONES        0x80
+#define OLED_BITMAP_REPEAT      0xC0
+#define OLED_BITMAP_CODE_MASK   0xC0
+#define OLED_BITMAP_COUNT_MASK  0x3F
+
+struct oled_bitmap
+{
+    uint8_t width;          /* Columns */
+    uint8_t pages;          /* Rows / 8, rounded up */
+    uint16_t size;          /* Bytes of data */
+    const uint8_t *data;
+};
+
+/* Columns which differ from the display in one page, first > last if none */
+struct oled_fb_dirty
+{
+    uint8_t first;
+    uint8_t last;
+};
+
+/* Transfers of the last flush */
+struct oled_fb_stats
+{
+    uint16_t commands;      /* Command bytes */
+    uint16_t data;          /* Display RAM bytes */
+    uint8_t transfers;      /* Data transfers, one per dirty page */
+};
+
+void OLED_FB_Init(void);
+void OLED_FB_Invalidate(void);
+void OLED_FB_Clear(void);
+void OLED_FB_Draw_Bitmap(const struct oled_bitmap *bitmap, uint8_t x, uint8_t page);
+void OLED_FB_Update(const uint8_t *image, uint16_t bytes_per_line);
+uint8_t OLED_FB_Flush(struct oled_fb_stats *stats);
+const uint8_t *OLED_FB_Get_Page(uint8_t page);
+
+#endif /* SOURCE_OLED_FRAMEBUFFER_H_ */
@@ -40,43 +40,55 @@
 
 #include "oled_task.h"
 
+/* Offscreen 1bpp frame emWin draws into, copied to the display by OLED_Display_Update() */
+static GUI_MEMDEV_Handle oled_frame;
+
+/* Timer which advances the splash screen every OLED_SPLASH_FRAME_MS */
+static TimerHandle_t splash_timer;
+
+/* Logos of the splash screen, the tagline follows as last frame */
+static const struct oled_bitmap *const splash_logos[] = {&bmifx, &bmplus, &bmcy};
+
+#define SPLASH_LOGOS	(sizeof(splash_logos) / sizeof(splash_logos[0]))
+#define SPLASH_FRAMES	(SPLASH_LOGOS + 1)
+
 /*******************************************************************************
-* Function Name: Show_Startup_Screen
+* Function Name: OLED_Display_Update
 ****************************************************************************//**
 *
-* Function displays the Infineon + Cypress Logo.
+* Function sends the pixels of the offscreen frame which changed since the last
+* update to the display.
 *
 *******************************************************************************/
 
-void Show_Startup_Screen(void)
+void OLED_Display_Update(void)
 {
-	/* ****************************************************
-	 * To avoid task switching cyhal_system_delay_ms() is
-	 * used instead of vTaskDelay(). This is done so that
-	 * sensor does not start sampling before OLED is
-	 * ready to display readings.
-	 * ****************************************************/
-
-    /* Set foreground and background color and font size */
-    GUI_SetFont(GUI_FONT_13B_1);
-    GUI_SetColor(GUI_WHITE);
-    GUI_SetBkColor(GUI_BLACK);
-    GUI_Clear();
-
-    /* Display Infineon logo */
-    GUI_DrawBitmap(&bmifx, 0, 0);
-    cyhal_system_delay_ms(2000);
-    GUI_Clear();
+    OLED_FB_Update((const uint8_t *)GUI_MEMDEV_GetDataPtr(oled_frame), OLED_FB_BYTES_PER_LINE);
+    OLED_FB_Flush(NULL);
+}
 
-    /* Display '+' symbol */
-    GUI_DrawBitmap(&bmplus, 0, 0);
-    cyhal_system_delay_ms(2000);
-    GUI_Clear();
+/*******************************************************************************
+* Function Name: Show_Startup_Screen
+****************************************************************************//**
+*
+* Function displays one logo of the Infineon + Cypress Logo.
+*
+* \param logo
+* Index of the logo: Infineon, '+' symbol or Cypress
+*
+*******************************************************************************/
 
-    /* Display Cypress logo */
-    GUI_DrawBitmap(&bmcy, 0, 0);
-    cyhal_system_delay_ms(2000);
-    GUI_Clear();
+void Show_Startup_Screen(uint8_t logo)
+{
+    /* ****************************************************
+     * The logos are decoded straight into the page order
+     * of the display, emWin is not involved. Only the
+     * columns which differ from the previous frame are
+     * sent.
+     * ****************************************************/
+    OLED_FB_Clear();
+    OLED_FB_Draw_Bitmap(splash_logos[logo], 0, 0);
+    OLED_FB_Flush(NULL);
 }
 
 /*******************************************************************************
@@ -89,14 +101,9 @@ void Show_Startup_Screen(void)
 
 void Show_Tag_Line(void)
 {
-	/* ****************************************************
-	 * To avoid task switching cyhal_system_delay_ms() is
-	 * used instead of vTaskDelay(). This is done so that
-	 * sensor does not start sampling before OLED is
-	 * ready to display readings.
-	 * ****************************************************/
-
-    /* Set text mode */
+    /* Set foreground and background color and text mode */
+    GUI_SetColor(GUI_WHITE);
+    GUI_SetBkColor(GUI_BLACK);
     GUI_SetTextMode(GUI_TM_NORMAL);
 
     /* Clear the display */
@@ -110,11 +117,82 @@ void Show_Tag_Line(void)
     GUI_DispStringAt("between the real and ", 64, 30);
     GUI_SetTextAlign(GUI_TA_HCENTER);
     GUI_DispStringAt("the digital world", 64, 40);
+    OLED_Display_Update();
+}
 
-    cyhal_system_delay_ms(2000);
+/*******************************************************************************
+* Function Name: Show_Splash_Frame
+****************************************************************************//**
+*
+* Function displays one frame of the splash screen, the logos and then the
+* tagline.
+*
+* \param frame
+* Index of the frame, below SPLASH_FRAMES
+*
+*******************************************************************************/
 
-    /* Clear the display */
-	GUI_Clear();
+static void Show_Splash_Frame(uint8_t frame)
+{
+    if(frame < SPLASH_LOGOS)
+    {
+        Show_Startup_Screen(frame);
+    }
+    else
+    {
+        Show_Tag_Line();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Show_Readings
+****************************************************************************//**
+*
+* Function displays the humidity and temperature of a valid sensor reading.
+*
+* \param reading
+* Pointer to the reading
+*
+*******************************************************************************/
+
+static void Show_Readings(const struct readings *reading)
+{
+    char value[FIXED_FORMAT_MAX_LEN];
+
+    /* Clear the frame */
+    GUI_Clear();
+
+    /* Set appropriate font, alignment, position and display the readings */
+    GUI_SetFont(GUI_FONT_10_1);
+    GUI_SetTextAlign(GUI_TA_LEFT);
+    GUI_DispStringAt("Humidity: ", 2, 20);
+    /* Display the value with 2 decimals */
+    Fixed_Format(value, reading->humidity, DHT_DECIMALS);
+    GUI_DispString(value);
+    GUI_DispStringAt("Temperature: ", 2, 40);
+    Fixed_Format(value, reading->temperature, DHT_DECIMALS);
+    GUI_DispString(value);
+
+    /* Only the digits which changed are sent */
+    OLED_Display_Update();
+}
+
+/*******************************************************************************
+* Function Name: Splash_Timer_Callback
+****************************************************************************//**
+*
+* Timer callback which asks the OLED Task for the next splash screen frame. It
+* runs in the timer service task, emWin is only used by the OLED Task.
+*
+* \param xTimer
+* Handle of the splash timer
+*
+*******************************************************************************/
+
+static void Splash_Timer_Callback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+    xEventGroupSetBits(dht_reading_notify_event_group, OLED_TASK_SPLASH_EVENTBIT);
 }
 
 /*******************************************************************************
@@ -152,17 +230,44 @@ void OLED_Task(void* pvParameters)
 	/* Initialize emWin Library */
 	GUI_Init();
 
+	/* ******************************************************************
+	 * Draw into an offscreen frame with the 1bpp layout of the display.
+	 * OLED_Display_Update() then only sends the changed pages and
+	 * columns instead of every pixel emWin touches.
+	 * ******************************************************************/
+	oled_frame = GUI_MEMDEV_CreateFixed(0, 0, OLED_FB_WIDTH, OLED_FB_HEIGHT, GUI_MEMDEV_NOTRANS,
+										GUI_MEMDEV_APILIST_1, GUICC_1);
+	if (oled_frame == 0)
+	{
+		printf("\r\nError: OLED frame allocation failed\r\n");
+		CY_ASSERT(0);
+	}
+	GUI_MEMDEV_Select(oled_frame);
+	OLED_FB_Init();
+
 	/* **************************************************************
 	 * If code execution does not reach this point, then please check
 	 * the OLED display connections and ensure that the connections
 	 * are correct.
 	 * **************************************************************/
 
-	/* Display Infineon + Cypress Logo */
-	Show_Startup_Screen();
+	/* ******************************************************************
+	 * The splash screen is advanced by a timer while the task waits for
+	 * readings, so that the sensor is sampled from power-on. The first
+	 * valid reading ends the splash screen at the next frame change.
+	 * ******************************************************************/
+	splash_timer = xTimerCreate("Splash Timer", pdMS_TO_TICKS(OLED_SPLASH_FRAME_MS), pdTRUE, NULL,
+								Splash_Timer_Callback);
+	if (splash_timer == NULL)
+	{
+		printf("\r\nError: Splash timer creation failed\r\n");
+		CY_ASSERT(0);
+	}
 
-	/* Display tagline */
-	Show_Tag_Line();
+	/* Display the Infineon logo, the first frame of the Infineon + Cypress Logo */
+	uint8_t splash_frame = 0;
+	Show_Splash_Frame(splash_frame);
+	xTimerStart(splash_timer, portMAX_DELAY);
 
 	/* Variable to store the queue handle */
 	QueueHandle_t dht_reading_queue;
@@ -171,48 +276,86 @@ void OLED_Task(void* pvParameters)
 	/* Variable to store temperature and humidity values */
 	struct readings DHT_reading = {0, 0};
 
+	/* Last valid reading and whether it is waiting for the end of the splash screen */
+	struct readings valid_reading = {0, 0};
+	uint8_t reading_pending = 0;
+
+	/* Time to the first valid display, from the start of the scheduler */
+	TickType_t first_reading_ticks = 0;
+	uint8_t first_display_done = 0;
+
 	for(;;)
 	{
 		/* ********************************************************************
 		 * Block until DHT Task updates the queue and sets the corresponding
-		 * event bit within the event group.
+		 * event bit within the event group, or the splash timer expires.
 		 * ********************************************************************/
-		xEventGroupWaitBits( /* The event group to read */
+		EventBits_t bits = xEventGroupWaitBits( /* The event group to read */
 							dht_reading_notify_event_group,
 							/* Bits to test */
-							OLED_TASK_NOTIFY_EVENTBIT,
+							OLED_TASK_NOTIFY_EVENTBIT | OLED_TASK_SPLASH_EVENTBIT,
 							/* Clear bits on exit if the unblock condition is met */
 							pdTRUE,
-							/* xWaitForAllBits does not matter as there is only 1bit */
-							pdTRUE,
+							/* Unblock on either bit */
+							pdFALSE,
 							/* Don't time out */
 							portMAX_DELAY );
 
-		/* *************************************************************
-		 * Read the temperature and humidity values from the queue.
-		 * xQueuePeek() copies the data from the queue to the structure
-		 * without removing the data from the queue.
-		 * *************************************************************/
-		xQueuePeek(dht_reading_queue, &DHT_reading, portMAX_DELAY);
-
-		/* Display the DHT sensor readings if the values are valid */
-		if(DHT_reading.result_code == SUCCESS)
+		if(bits & OLED_TASK_NOTIFY_EVENTBIT)
 		{
-			/* Clear the display */
-			GUI_Clear();
-
-			/* Set appropriate font, alignment, position and display the readings */
-			GUI_SetFont(GUI_FONT_10_1);
-			GUI_SetTextAlign(GUI_TA_LEFT);
-			GUI_DispStringAt("Humidity: ", 2, 20);
-			/* Display float value upto 5 characters */
-			GUI_DispFloat(DHT_reading.humidity, 5);
-			GUI_DispStringAt("Temperature: ", 2, 40);
-			/* Display float value upto 5 characters */
-			GUI_DispFloat(DHT_reading.temperature, 5);
+			/* *************************************************************
+			 * Read the temperature and humidity values from the queue.
+			 * xQueuePeek() copies the data from the queue to the structure
+			 * without removing the data from the queue.
+			 * *************************************************************/
+			xQueuePeek(dht_reading_queue, &DHT_reading, portMAX_DELAY);
+
+			/* Display the DHT sensor readings if the values are valid */
+			if(DHT_reading.result_code == SUCCESS)
+			{
+				if(first_reading_ticks == 0)
+				{
+					first_reading_ticks = xTaskGetTickCount();
+				}
+				valid_reading = DHT_reading;
+				reading_pending = 1;
+			}
 		}
-	}
-}
 
+		/* A timer event queued before the timer was stopped is ignored */
+		if((bits & OLED_TASK_SPLASH_EVENTBIT) && (splash_frame < SPLASH_FRAMES))
+		{
+			splash_frame++;
+			if((splash_frame < SPLASH_FRAMES) && !reading_pending)
+			{
+				Show_Splash_Frame(splash_frame);
+			}
+			else
+			{
+				/* End of the splash screen */
+				xTimerStop(splash_timer, portMAX_DELAY);
+				splash_frame = SPLASH_FRAMES;
+				if(!reading_pending)
+				{
+					GUI_Clear();
+					OLED_Display_Update();
+				}
+			}
+		}
 
+		/* Readings are shown once the splash screen has ended */
+		if(reading_pending && (splash_frame >= SPLASH_FRAMES))
+		{
+			Show_Readings(&valid_reading);
+			reading_pending = 0;
 
+			if(!first_display_done)
+			{
+				first_display_done = 1;
+				printf("\r\nFirst valid reading at %lu ms, displayed at %lu ms\r\n",
+						(unsigned long)(first_reading_ticks * portTICK_PERIOD_MS),
+						(unsigned long)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+			}
+		}
+	}
+}
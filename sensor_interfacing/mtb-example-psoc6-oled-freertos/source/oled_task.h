@@ -43,17 +43,24 @@
 
 #include "main.h"
 #include "mtb_ssd1306.h"
+#include "timers.h"
 #include "GUI.h"
+#include "oled_framebuffer.h"
+#include "fixed_format.h"
 
-/* External global references. These structures contain the logo images */
-extern GUI_CONST_STORAGE GUI_BITMAP bmifx;
-extern GUI_CONST_STORAGE GUI_BITMAP bmplus;
-extern GUI_CONST_STORAGE GUI_BITMAP bmcy;
+/* External global references. These structures contain the packed logo images */
+extern const struct oled_bitmap bmifx;
+extern const struct oled_bitmap bmplus;
+extern const struct oled_bitmap bmcy;
+
+/* Time each frame of the splash screen is displayed */
+#define OLED_SPLASH_FRAME_MS	2000
 
 /* I2C peripheral object */
 cyhal_i2c_t i2c_obj;
 
-void Show_Startup_Screen(void);
+void OLED_Display_Update(void);
+void Show_Startup_Screen(uint8_t logo);
 void Show_Tag_Line(void);
 void OLED_Task(void* pvParameters);
 
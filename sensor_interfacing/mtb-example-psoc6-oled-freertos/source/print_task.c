@@ -40,6 +40,7 @@
 
 
 #include "print_task.h"
+#include "fixed_format.h"
 
 /*******************************************************************************
 * Function Name: Print_Task
@@ -65,6 +66,9 @@ void Print_Task(void* pvParameters)
 	/* Variable to store temperature and humidity values */
 	struct readings DHT_reading = {0, 0};
 
+	/* Readings as text, formatted without float support in printf */
+	char humidity[FIXED_FORMAT_MAX_LEN], temperature[FIXED_FORMAT_MAX_LEN];
+
 	for(;;)
 	{
 		/* ********************************************************************
@@ -94,8 +98,10 @@ void Print_Task(void* pvParameters)
 		/* Print the DHT sensor readings if the values are valid */
 		if(DHT_reading.result_code == SUCCESS)
 		{
-			printf("\r\nHumidity  =   %.2f\r\n",DHT_reading.humidity);
-			printf("\r\nTemperature  =   %.2f\r\n",DHT_reading.temperature);
+			Fixed_Format(humidity, DHT_reading.humidity, DHT_DECIMALS);
+			Fixed_Format(temperature, DHT_reading.temperature, DHT_DECIMALS);
+			printf("\r\nHumidity  =   %s\r\n", humidity);
+			printf("\r\nTemperature  =   %s\r\n", temperature);
 			conn_err_displayed = false;
 		}
 